@@ -0,0 +1,666 @@
+#include <limits.h>
+#include <math.h>
+
+#include "aot.h"
+
+// Pointers in the order they are written out, with a hash index from each pointer to its position
+typedef struct aot_table {
+    void** items;
+    size_t size;
+    size_t capacity;
+    uint32_t* slots; // index of an item plus one, 0 for an empty slot
+    size_t mask;     // number of slots minus one
+} aot_table;
+
+// Script being translated, each table is written out in order
+typedef struct aot_writer {
+    FILE* out;
+    aot_table programs;  // global program first, parents before children
+    aot_table positions; // line positions and the call sites of inlined code
+    aot_table sources;   // source texts the positions point into
+} aot_writer;
+
+// Helpers shared by the generated functions
+static const char* aot_prelude =
+    "static inline void he_error(virtual_machine* vm, call_info* call, size_t pc, const char* msg)\n"
+    "{\n"
+    "    call->pc = pc;\n"
+    "    runtimeerr(vm, msg);\n"
+    "}\n"
+    "\n"
+    "// runs a single instruction in the interpreter\n"
+    "static inline void he_step(virtual_machine* vm, call_info* call, size_t pc, vm_op op, uint32_t ux)\n"
+    "{\n"
+    "    call->pc = pc;\n"
+    "    decode_execute(vm, call, (instruction) { .ux = { op, ux } });\n"
+    "}\n"
+    "\n"
+    "static inline void he_binary(virtual_machine* vm, call_info* call, size_t pc, vm_op op)\n"
+    "{\n"
+    "    call->pc = pc;\n"
+    "    call->tp--;\n"
+    "    vm->stack[call->tp - 1] = apply_vm_op(op, vm->stack[call->tp - 1], vm->stack[call->tp]);\n"
+    "}\n"
+    "\n"
+    "static inline boolean he_ints(virtual_machine* vm, call_info* call)\n"
+    "{\n"
+    "    return vm->stack[call->tp - 2].type == VM_INT && vm->stack[call->tp - 1].type == VM_INT;\n"
+    "}\n"
+    "\n"
+    "static inline boolean he_truthy(Value* v)\n"
+    "{\n"
+    "    return v->type == VM_BOOL ? v->value.to_bool : native_bool_cast(v).value.to_bool;\n"
+    "}\n"
+    "\n";
+
+// Slot holding an item in the index, or the empty slot it belongs in
+static uint32_t* aot_slot(aot_table* t, const void* item)
+{
+    uint64_t bits = (uintptr_t) item * 0x9e3779b97f4a7c15ull;
+
+    for (size_t s = (bits ^ (bits >> 32)) & t->mask; ; s = (s + 1) & t->mask)
+    {
+        uint32_t* slot = &t->slots[s];
+
+        if (*slot == 0 || t->items[*slot - 1] == item) {
+            return slot;
+        }
+    }
+}
+
+// Position of an item in the table, or the size of the table when it is not in it
+static size_t aot_index(aot_table* t, const void* item)
+{
+    if (t->slots == NULL) {
+        return t->size;
+    }
+
+    uint32_t* slot = aot_slot(t, item);
+    return *slot == 0 ? t->size : *slot - 1;
+}
+
+// Appends an item to the table, the index is kept at most half full
+static void aot_push(aot_table* t, const void* item)
+{
+    if (2 * (t->size + 1) > t->mask + 1 || t->slots == NULL)
+    {
+        t->mask = t->slots == NULL ? 15 : t->mask * 2 + 1;
+        free(t->slots);
+        t->slots = calloc(t->mask + 1, sizeof(uint32_t));
+
+        for (size_t i = 0; i < t->size; i++) {
+            *aot_slot(t, t->items[i]) = i + 1;
+        }
+    }
+
+    if (t->size == t->capacity) {
+        t->capacity = t->capacity ? t->capacity * 2 : 16;
+        t->items = realloc(t->items, sizeof(void*) * t->capacity);
+    }
+
+    t->items[t->size] = (void*) item;
+    *aot_slot(t, item) = ++t->size;
+}
+
+static void aot_table_delete(aot_table* t)
+{
+    free(t->items);
+    free(t->slots);
+}
+
+// Orders programs so that parents always precede their children
+static void aot_flatten(aot_writer* w, program* p)
+{
+    aot_push(&w->programs, p);
+
+    for (size_t i = 0; i < p->constant_table.size; i++) {
+        Value v = p->constants[i];
+
+        if (v.type == VM_PROGRAM && aot_index(&w->programs, v.value.to_code->p) == w->programs.size) {
+            aot_flatten(w, v.value.to_code->p);
+        }
+    }
+}
+
+static void aot_collect(aot_writer* w, const lxpos* pos)
+{
+    if (aot_index(&w->positions, pos) < w->positions.size) {
+        return;
+    }
+
+    if (pos->caller != NULL) {
+        aot_collect(w, pos->caller);
+    }
+
+    if (aot_index(&w->sources, pos->src) == w->sources.size) {
+        aot_push(&w->sources, pos->src);
+    }
+    aot_push(&w->positions, pos);
+}
+
+// Writes a C string literal, sources are broken up after each line
+static void aot_string(FILE* out, const char* s, boolean lines)
+{
+    fputc('"', out);
+
+    for (; *s != '\0'; s++)
+    {
+        switch (*s)
+        {
+            case '"': fputs("\\\"", out); break;
+            case '\\': fputs("\\\\", out); break;
+            case '?': fputs("\\?", out); break; // no trigraphs
+            case '\t': fputs("\\t", out); break;
+            case '\r': fputs("\\r", out); break;
+            case '\n':
+                fputs(lines && s[1] != '\0' ? "\\n\"\n    \"" : "\\n", out);
+                break;
+            default:
+                if ((unsigned char) *s < 0x20 || *s == 0x7f) {
+                    fprintf(out, "\\%03o", (unsigned char) *s);
+                } else {
+                    fputc(*s, out);
+                }
+                break;
+        }
+    }
+
+    fputc('"', out);
+}
+
+static void aot_value(aot_writer* w, Value v)
+{
+    switch (v.type)
+    {
+        case VM_NULL:
+            fprintf(w->out, "{ .type = VM_NULL }");
+            break;
+        case VM_INT:
+            if (v.value.to_int == LONG_MIN) {
+                fprintf(w->out, "{ .type = VM_INT, .value = { .to_int = -%ldL - 1 } }", LONG_MAX);
+            } else {
+                fprintf(w->out, "{ .type = VM_INT, .value = { .to_int = %ldL } }", v.value.to_int);
+            }
+            break;
+        case VM_BOOL:
+            fprintf(w->out, "{ .type = VM_BOOL, .value = { .to_bool = %s } }", v.value.to_bool ? "true" : "false");
+            break;
+        case VM_FLOAT:
+            // hexadecimal literals keep every bit of the constant
+            if (isnan(v.value.to_float)) {
+                fprintf(w->out, "{ .type = VM_FLOAT, .value = { .to_float = %sNAN } }", signbit(v.value.to_float) ? "-" : "");
+            } else if (isinf(v.value.to_float)) {
+                fprintf(w->out, "{ .type = VM_FLOAT, .value = { .to_float = %sHUGE_VAL } }", v.value.to_float < 0 ? "-" : "");
+            } else {
+                fprintf(w->out, "{ .type = VM_FLOAT, .value = { .to_float = %a } }", v.value.to_float);
+            }
+            break;
+        case VM_STRING:
+            fprintf(w->out, "{ .type = VM_STRING, .value = { .to_str = ");
+            aot_string(w->out, v.value.to_str, false);
+            fprintf(w->out, " } }");
+            break;
+        case VM_PROGRAM:
+            fprintf(w->out, "{ .type = VM_PROGRAM, .value = { .to_code = &he_code_%zu } }",
+                aot_index(&w->programs, v.value.to_code->p));
+            break;
+        default:
+            failure("Constant cannot be compiled ahead of time!");
+            break;
+    }
+}
+
+static void aot_label(aot_writer* w, program* p, size_t target)
+{
+    if (target < p->length) {
+        fprintf(w->out, "L%zu", target);
+    } else {
+        fprintf(w->out, "end");
+    }
+}
+
+// Marks the instructions jumps land on, the end of the program is marked past the last one
+static boolean* aot_targets(program* p)
+{
+    boolean* targets = calloc(p->length + 1, sizeof(boolean));
+
+    for (size_t k = 0; k < p->length; k++)
+    {
+        instruction i = p->code[k];
+        size_t target;
+
+        switch (i.stackop.op)
+        {
+            case OP_JMP:
+                target = k + i.sx.sx + 1;
+                break;
+            case OP_FORLOOP:
+                target = k + p->code[k + 1].sx.sx + 2;
+                targets[target < p->length ? target : p->length] = true;
+                target = k + 2;
+                break;
+            case OP_JIF:
+            case OP_GUARDI:
+            case OP_GUARDF:
+            case OP_FORPREP:
+                target = k + 2;
+                break;
+            default:
+                continue;
+        }
+
+        targets[target < p->length ? target : p->length] = true;
+    }
+
+    return targets;
+}
+
+static const char* aot_operator(vm_op op)
+{
+    switch (op)
+    {
+        case OP_ADD: case OP_ADDI: case OP_ADDF: return "+";
+        case OP_SUB: case OP_SUBI: case OP_SUBF: return "-";
+        case OP_MUL: case OP_MULI: case OP_MULF: return "*";
+        case OP_EQ: case OP_EQI: return "==";
+        case OP_NE: case OP_NEI: return "!=";
+        case OP_LT: case OP_LTI: case OP_LTF: return "<";
+        case OP_LE: case OP_LEI: case OP_LEF: return "<=";
+        case OP_GT: case OP_GTI: case OP_GTF: return ">";
+        case OP_GE: case OP_GEI: case OP_GEF: return ">=";
+        default: return NULL;
+    }
+}
+
+static void aot_overflow(aot_writer* w, size_t k, const char* condition)
+{
+    fprintf(w->out, "    if (%s) he_error(vm, call, %zu, \"Stack overflow!\");\n", condition, k);
+}
+
+static void aot_instruction(aot_writer* w, program* p, size_t k)
+{
+    FILE* out = w->out;
+    instruction i = p->code[k];
+    size_t index = aot_index(&w->programs, p);
+    const char* op = aot_operator(i.stackop.op);
+    const char* vars = p->prev == NULL ? "vm->heap" : "vars";
+
+    switch (i.stackop.op)
+    {
+        case OP_NOP:
+            fprintf(out, "    ;\n");
+            break;
+
+        case OP_PUSHK:
+            fprintf(out, "    vm->stack[call->tp++] = he_constants_%zu[%u];\n", index, i.ux.ux);
+            aot_overflow(w, k, "call->tp >= MAX_STACK_SIZE");
+            break;
+
+        case OP_STORG:
+            fprintf(out, "    vm->heap[%i] = vm->stack[--call->tp];\n", i.sx.sx);
+            if (i.sx.sx >= MAX_HEAP_SIZE) aot_overflow(w, k, "true");
+            break;
+
+        case OP_LOADG:
+            fprintf(out, "    vm->stack[call->tp++] = vm->heap[%i];\n", i.sx.sx);
+            aot_overflow(w, k, "call->tp >= MAX_STACK_SIZE");
+            break;
+
+        case OP_STORL:
+            fprintf(out, "    vars[%i] = vm->stack[--call->tp];\n", i.sx.sx);
+            fprintf(out, "    if (call->bp + %i >= MAX_STACK_SIZE) he_error(vm, call, %zu, \"Stack overflow!\");\n", i.sx.sx, k);
+            break;
+
+        case OP_LOADL:
+            fprintf(out, "    vm->stack[call->tp++] = vars[%i];\n", i.sx.sx);
+            aot_overflow(w, k, "call->tp >= MAX_STACK_SIZE");
+            break;
+
+        case OP_STORC:
+            fprintf(out, "    call->program->closure[%u] = vm->stack[--call->tp];\n", i.ux.ux);
+            break;
+
+        case OP_LOADC:
+            fprintf(out, "    vm->stack[call->tp++] = call->program->closure[%u];\n", i.ux.ux);
+            aot_overflow(w, k, "call->tp >= MAX_STACK_SIZE");
+            break;
+
+        case OP_POP:
+            fprintf(out, "    call->tp--;\n");
+            break;
+
+        case OP_DUP:
+            fprintf(out, "    vm->stack[call->tp] = vm->stack[call->tp - 1];\n");
+            fprintf(out, "    call->tp++;\n");
+            aot_overflow(w, k, "call->tp >= MAX_STACK_SIZE");
+            break;
+
+        case OP_RET:
+            fprintf(out, "    vm->stack[call->prev->tp++] = vm->stack[--call->tp];\n");
+            fprintf(out, "    return JIT_RETURN;\n");
+            break;
+
+        case OP_TAILCALL:
+            fprintf(out, "    he_step(vm, call, %zu, %i, %u);\n", k, i.stackop.op, i.ux.ux);
+            fprintf(out, "    if (call->pc == (size_t) -1) return JIT_TAILCALL;\n");
+            break;
+
+        // a truthy condition skips the jump which follows it
+        case OP_JIF:
+            fprintf(out, "    if (he_truthy(&vm->stack[--call->tp])) goto ");
+            aot_label(w, p, k + 2);
+            fprintf(out, ";\n");
+            break;
+
+        case OP_JMP:
+            fprintf(out, "    goto ");
+            aot_label(w, p, k + i.sx.sx + 1);
+            fprintf(out, ";\n");
+            break;
+
+        case OP_ADD:
+        case OP_SUB:
+        case OP_MUL:
+            fprintf(out, "    if (he_ints(vm, call)) { call->tp--; vm->stack[call->tp - 1].value.to_int %s= vm->stack[call->tp].value.to_int; }\n", op);
+            fprintf(out, "    else he_binary(vm, call, %zu, %i);\n", k, i.stackop.op);
+            break;
+
+        case OP_EQ:
+        case OP_NE:
+        case OP_LT:
+        case OP_LE:
+        case OP_GT:
+        case OP_GE:
+            fprintf(out, "    if (he_ints(vm, call)) { call->tp--; vm->stack[call->tp - 1] = vBool(vm->stack[call->tp - 1].value.to_int %s vm->stack[call->tp].value.to_int); }\n", op);
+            fprintf(out, "    else he_binary(vm, call, %zu, %i);\n", k, i.stackop.op);
+            break;
+
+        case OP_DIV:
+        case OP_MOD:
+        case OP_AND:
+        case OP_OR:
+            fprintf(out, "    he_binary(vm, call, %zu, %i);\n", k, i.stackop.op);
+            break;
+
+        // operand types were proven by the optimizer, tags are left untouched
+        case OP_ADDI:
+        case OP_SUBI:
+        case OP_MULI:
+            fprintf(out, "    call->tp--; vm->stack[call->tp - 1].value.to_int %s= vm->stack[call->tp].value.to_int;\n", op);
+            break;
+
+        case OP_ADDF:
+        case OP_SUBF:
+        case OP_MULF:
+            fprintf(out, "    call->tp--; vm->stack[call->tp - 1].value.to_float %s= vm->stack[call->tp].value.to_float;\n", op);
+            break;
+
+        case OP_EQI:
+        case OP_NEI:
+        case OP_LTI:
+        case OP_LEI:
+        case OP_GTI:
+        case OP_GEI:
+            fprintf(out, "    call->tp--; vm->stack[call->tp - 1] = vBool(vm->stack[call->tp - 1].value.to_int %s vm->stack[call->tp].value.to_int);\n", op);
+            break;
+
+        case OP_LTF:
+        case OP_LEF:
+        case OP_GTF:
+        case OP_GEF:
+            fprintf(out, "    call->tp--; vm->stack[call->tp - 1] = vBool(vm->stack[call->tp - 1].value.to_float %s vm->stack[call->tp].value.to_float);\n", op);
+            break;
+
+        case OP_DIVI:
+            fprintf(out, "    call->tp--;\n");
+            fprintf(out, "    if (vm->stack[call->tp].value.to_int == 0 || vm->stack[call->tp].value.to_float == 0.0) he_error(vm, call, %zu, \"Zero division error!\");\n", k);
+            fprintf(out, "    vm->stack[call->tp - 1].value.to_int /= vm->stack[call->tp].value.to_int;\n");
+            break;
+
+        case OP_MODI:
+            fprintf(out, "    call->tp--;\n");
+            fprintf(out, "    if (vm->stack[call->tp].value.to_int == 0) he_error(vm, call, %zu, \"Zero modulus error!\");\n", k);
+            fprintf(out, "    vm->stack[call->tp - 1].value.to_int %%= vm->stack[call->tp].value.to_int;\n");
+            break;
+
+        case OP_DIVF:
+            fprintf(out, "    call->tp--;\n");
+            fprintf(out, "    if (vm->stack[call->tp].value.to_float == 0.0) he_error(vm, call, %zu, \"Zero division error!\");\n", k);
+            fprintf(out, "    vm->stack[call->tp - 1].value.to_float /= vm->stack[call->tp].value.to_float;\n");
+            break;
+
+        // a passing guard skips the jump to the generic code
+        case OP_GUARDI:
+        case OP_GUARDF:
+            fprintf(out, "    if (vars[%i].type == %s) goto ", i.sx.sx, i.stackop.op == OP_GUARDI ? "VM_INT" : "VM_FLOAT");
+            aot_label(w, p, k + 2);
+            fprintf(out, ";\n");
+            break;
+
+        // a non-empty range skips the jump past the loop
+        case OP_FORPREP:
+            fprintf(out, "    he_step(vm, call, %zu, %i, %u);\n", k, i.stackop.op, i.ux.ux);
+            fprintf(out, "    if (call->pc == %zu) goto ", k + 1);
+            aot_label(w, p, k + 2);
+            fprintf(out, ";\n");
+            break;
+
+        case OP_FORLOOP:
+            fprintf(out, "    if (%s[%u].type != VM_INT) he_error(vm, call, %zu, \"Loop counter must be an integer!\");\n",
+                vars, FOR_COUNTER(i.ux.ux), k);
+            fprintf(out, "    if (!__builtin_add_overflow(%s[%u].value.to_int, %s[%u].value.to_int, &%s[%u].value.to_int) &&\n",
+                vars, FOR_COUNTER(i.ux.ux), vars, FOR_LIMIT(i.ux.ux) + 1, vars, FOR_COUNTER(i.ux.ux));
+            fprintf(out, "        (%s[%u].value.to_int > 0 ? %s[%u].value.to_int %s %s[%u].value.to_int : %s[%u].value.to_int %s %s[%u].value.to_int)) goto ",
+                vars, FOR_LIMIT(i.ux.ux) + 1, vars, FOR_COUNTER(i.ux.ux), i.ux.ux & FOR_EXCLUSIVE ? "<" : "<=", vars, FOR_LIMIT(i.ux.ux),
+                vars, FOR_COUNTER(i.ux.ux), i.ux.ux & FOR_EXCLUSIVE ? ">" : ">=", vars, FOR_LIMIT(i.ux.ux));
+            aot_label(w, p, k + p->code[k + 1].sx.sx + 2);
+            fprintf(out, ";\n    goto ");
+            aot_label(w, p, k + 2);
+            fprintf(out, ";\n");
+            break;
+
+        // calls, closures, tables and the rest are left to the interpreter
+        default:
+            fprintf(out, "    he_step(vm, call, %zu, %i, %u);\n", k, i.stackop.op, i.ux.ux);
+            break;
+    }
+}
+
+static void aot_function(aot_writer* w, program* p)
+{
+    FILE* out = w->out;
+    boolean* targets = aot_targets(p);
+
+    fprintf(out, "static int he_function_%zu(virtual_machine* vm, call_info* call, Value* vars, Value* top, Value* limit)\n{\n",
+        aot_index(&w->programs, p));
+
+    for (size_t k = 0; k < p->length; k++)
+    {
+        if (targets[k]) {
+            fprintf(out, "L%zu:\n", k);
+        }
+
+        aot_instruction(w, p, k);
+    }
+
+    if (targets[p->length]) {
+        fprintf(out, "end:\n");
+    }
+    fprintf(out, "    return JIT_RETURN;\n}\n\n");
+
+    free(targets);
+}
+
+static void aot_program(aot_writer* w, program* p)
+{
+    FILE* out = w->out;
+    size_t index = aot_index(&w->programs, p);
+
+    fprintf(out, "    {\n");
+    fprintf(out, "        .argc = %zu,\n", p->argc);
+
+    if (p->prev != NULL) {
+        fprintf(out, "        .prev = &he_programs[%zu],\n", aot_index(&w->programs, p->prev));
+    }
+
+    if (p->native == NULL) {
+        fprintf(out, "        .jit = (void*) he_function_%zu,\n", index);
+    }
+
+    if (p->constant_table.size > 0) {
+        fprintf(out, "        .constants = he_constants_%zu,\n", index);
+    }
+
+    if (p->line_address_table.size > 0) {
+        fprintf(out, "        .line_address_table = { .keys = he_lines_%zu, .values = he_addresses_%zu, .size = %zu, .capacity = %zu },\n",
+            index, index, p->line_address_table.size, p->line_address_table.size);
+    }
+
+    // only the frame size of the symbol table is used at runtime
+    fprintf(out, "        .symbol_table = { .size = %zu },\n", p->symbol_table.size);
+    fprintf(out, "    },\n");
+}
+
+void aot_emit(program* p, const char* origin, FILE* out)
+{
+    aot_writer w = { .out = out };
+
+    aot_flatten(&w, p);
+
+    for (size_t j = 0; j < w.programs.size; j++) {
+        program* q = w.programs.items[j];
+
+        for (size_t i = 0; i < q->line_address_table.size; i++) {
+            aot_collect(&w, q->line_address_table.values[i]);
+        }
+    }
+
+    fprintf(out, "// Compiled ahead of time by helium from ");
+    aot_string(out, origin, false);
+    fprintf(out, "\n\n#include <math.h>\n\n#include \"vm.h\"\n#include \"jit.h\"\n#include \"lib.h\"\n\n");
+    fprintf(out, "virtual_machine* current_vm;\n\n");
+    fprintf(out, "%s", aot_prelude);
+
+    // source texts and positions for stack traces
+    for (size_t j = 0; j < w.sources.size; j++) {
+        fprintf(out, "static const char he_source_%zu[] =\n    ", j);
+        aot_string(out, w.sources.items[j], true);
+        fprintf(out, ";\n\n");
+    }
+
+    if (w.positions.size > 0) {
+        fprintf(out, "static lxpos he_positions[] = {\n");
+
+        for (size_t j = 0; j < w.positions.size; j++) {
+            const lxpos* pos = w.positions.items[j];
+
+            fprintf(out, "    { .col_pos = %i, .line_pos = %i, .char_offset = %i, .line_offset = %i, .origin = ",
+                pos->col_pos, pos->line_pos, pos->char_offset, pos->line_offset);
+            aot_string(out, pos->origin, false);
+            fprintf(out, ", .src = he_source_%zu", aot_index(&w.sources, pos->src));
+
+            if (pos->caller != NULL) {
+                fprintf(out, ", .caller = &he_positions[%zu]", aot_index(&w.positions, pos->caller));
+            }
+            fprintf(out, " },\n");
+        }
+
+        fprintf(out, "};\n\n");
+    }
+
+    // programs are referenced by constants before they are defined
+    fprintf(out, "static program he_programs[%zu];\n\n", w.programs.size);
+
+    for (size_t j = 0; j < w.programs.size; j++) {
+        fprintf(out, "static code_object he_code_%zu = { &he_programs[%zu], NULL };\n", j, j);
+    }
+    fprintf(out, "\n");
+
+    for (size_t j = 0; j < w.programs.size; j++)
+    {
+        program* q = w.programs.items[j];
+
+        if (q->native == NULL) {
+            fprintf(out, "static int he_function_%zu(virtual_machine* vm, call_info* call, Value* vars, Value* top, Value* limit);\n", j);
+        }
+
+        if (q->constant_table.size > 0) {
+            fprintf(out, "\nstatic Value he_constants_%zu[] = {\n", j);
+
+            for (size_t i = 0; i < q->constant_table.size; i++) {
+                fprintf(out, "    ");
+                aot_value(&w, q->constants[i]);
+                fprintf(out, ",\n");
+            }
+            fprintf(out, "};\n");
+        }
+
+        if (q->line_address_table.size > 0) {
+            fprintf(out, "\nstatic const char* he_lines_%zu[] = {", j);
+
+            for (size_t i = 0; i < q->line_address_table.size; i++) {
+                fprintf(out, "%s\"%s\"", i > 0 ? ", " : " ", q->line_address_table.keys[i]);
+            }
+            fprintf(out, " };\nstatic void* he_addresses_%zu[] = {", j);
+
+            for (size_t i = 0; i < q->line_address_table.size; i++) {
+                fprintf(out, "%s&he_positions[%zu]", i > 0 ? ", " : " ",
+                    aot_index(&w.positions, q->line_address_table.values[i]));
+            }
+            fprintf(out, " };\n");
+        }
+
+        fprintf(out, "\n");
+    }
+
+    fprintf(out, "static program he_programs[%zu] = {\n", w.programs.size);
+
+    for (size_t j = 0; j < w.programs.size; j++) {
+        aot_program(&w, w.programs.items[j]);
+    }
+    fprintf(out, "};\n\n");
+
+    for (size_t j = 0; j < w.programs.size; j++)
+    {
+        program* q = w.programs.items[j];
+
+        if (q->native == NULL) {
+            aot_function(&w, q);
+        }
+    }
+
+    fprintf(out, "int main()\n{\n");
+
+    for (size_t j = 0; j < w.programs.size; j++)
+    {
+        program* q = w.programs.items[j];
+
+        if (q->native != NULL) {
+            fprintf(out, "    he_programs[%zu].native = find_native(\"%s\", NULL)->f;\n", j, find_native(NULL, q->native)->name);
+        }
+    }
+
+    fprintf(out,
+        "\n"
+        "    virtual_machine vm = {\n"
+        "        .ci = 0,\n"
+        "        .call_stack = malloc(sizeof(call_info) * MAX_CALL_STACK),\n"
+        "        .heap = calloc(MAX_HEAP_SIZE, sizeof(Value)),\n"
+        "        .stack = calloc(MAX_STACK_SIZE, sizeof(Value)),\n"
+        "    };\n"
+        "\n"
+        "    current_vm = &vm;\n"
+        "\n"
+        "    // every function already runs as native code, nothing is compiled at runtime\n"
+        "    tiers.call_threshold = tiers.trace_threshold = tiers.osr_threshold = 0;\n"
+        "    jit_enabled = true;\n"
+        "\n"
+        "    vm.call_stack[0] = (call_info) { .program = &he_code_0, .prev = NULL };\n"
+        "    he_function_0(&vm, &vm.call_stack[0], vm.stack, vm.stack, &vm.stack[MAX_STACK_SIZE]);\n"
+        "    return 0;\n"
+        "}\n");
+
+    aot_table_delete(&w.programs);
+    aot_table_delete(&w.positions);
+    aot_table_delete(&w.sources);
+}
@@ -0,0 +1,42 @@
+#ifndef HE_AOT_HEADER
+#define HE_AOT_HEADER
+
+#include "common.h"
+#include "compiler.h"
+#include "lib.h"
+
+/*
+ * The ahead-of-time compiler translates a compiled script into a C
+ * source file which builds into a standalone executable against the
+ * runtime alone (common, datatypes, value, lib, vm, jit, stencil, regvm
+ * and tier), with no lexer, parser or compiler linked in.
+ *
+ * Every program becomes a C function with the signature of the baseline
+ * JIT's native code, placed in the jit slot of a statically initialized
+ * program. Frames, calls, closures and tables are still handled by the
+ * VM, so generated functions and natives call each other exactly as
+ * interpreted and JIT compiled code do. Jumps become gotos, stack traffic
+ * and typed arithmetic are emitted inline, generic operations take an
+ * inline int fast path, and everything else runs through decode_execute
+ * for the single instruction. Line address tables and source texts are
+ * embedded, so runtime errors print the same stack traces.
+ *
+ *  he_source_N      source texts
+ *  he_positions     line positions and the call sites of inlined code
+ *  he_constants_N   constant pools
+ *  he_function_N    code of each program, global program first
+ *  he_programs      programs, parents before children
+ *  main             runs the global program
+ */
+
+/**
+ * @brief Writes the C translation of a compiled program and of every
+ *      function it references.
+ *
+ * @param p Reference to the global program
+ * @param origin Path of the script, named in the header of the output
+ * @param out Stream the C source is written to
+ */
+void aot_emit(program* p, const char* origin, FILE* out);
+
+#endif
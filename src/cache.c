@@ -0,0 +1,736 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include "cache.h"
+#include "regvm.h"
+
+// Growable byte buffer holding one section of an image being written
+typedef struct image_section {
+    char* data;
+    uint32_t size;
+    uint32_t capacity;
+} image_section;
+
+// Image under construction, each section is written out in order
+typedef struct image_builder {
+    image_section sources;
+    image_section programs;
+    image_section constants;
+    image_section symbols;
+    image_section lines;
+    image_section code;
+    image_section strings;
+
+    vector flat;   // programs in image order
+    map interned;  // string offsets in string section
+    map* origins;  // source files by index
+    boolean ok;
+} image_builder;
+
+// Mapped image being linked into programs
+typedef struct image_reader {
+    const char* base;
+    const image_header* header;
+    program** programs;
+    const char** sources;
+} image_reader;
+
+// ---------------- CACHE FILES -----------------
+
+const char* cache_path(const char* script_path)
+{
+    size_t len = strlen(script_path);
+    char* path = malloc(sizeof(char) * (len + 5));
+    strcpy(path, script_path);
+
+    if (len > 3 && streq(script_path + len - 3, ".he")) {
+        strcat(path, "c");
+    } else {
+        strcat(path, ".hec");
+    }
+    return path;
+}
+
+// Modification time of a file in nanoseconds, 0 if it cannot be accessed
+uint64_t source_mtime(const char* path, uint64_t* size)
+{
+    struct stat st;
+
+    if (stat(path, &st) == -1) {
+        return 0;
+    }
+
+    *size = st.st_size;
+    return (uint64_t) st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+// FNV-1a hash of an image, continued from the hash of the bytes before it
+uint64_t image_checksum(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = data;
+
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3;
+    }
+    return hash;
+}
+
+// ---------------- IMAGE WRITER ----------------
+
+void* section_alloc(image_section* s, uint32_t size)
+{
+    if (s->size + size > s->capacity) {
+        s->capacity = (s->size + size) * 2;
+        s->data = realloc(s->data, s->capacity);
+    }
+
+    void* out = s->data + s->size;
+    memset(out, 0, size);
+    s->size += size;
+    return out;
+}
+
+uint32_t intern_string(image_builder* b, const char* str)
+{
+    if (map_has(&b->interned, str)) {
+        return (uintptr_t) map_get(&b->interned, str);
+    }
+
+    uint32_t offset = b->strings.size;
+    strcpy(section_alloc(&b->strings, strlen(str) + 1), str);
+    map_put(&b->interned, str, (void*) (uintptr_t) offset);
+    return offset;
+}
+
+uint32_t program_index(image_builder* b, program* p)
+{
+    for (size_t i = 0; i < b->flat.size; i++) {
+        if (b->flat.items[i] == p) return i;
+    }
+    return HE_IMAGE_NONE;
+}
+
+// Orders programs so that parents always precede their children
+void flatten_program(image_builder* b, program* p)
+{
+    vector_push(&b->flat, p);
+
+    for (size_t i = 0; i < p->constant_table.size; i++) {
+        Value v = p->constants[i];
+
+        if (v.type == VM_PROGRAM && program_index(b, v.value.to_code->p) == HE_IMAGE_NONE) {
+            flatten_program(b, v.value.to_code->p);
+        }
+    }
+}
+
+uint32_t emit_symbols(image_builder* b, map* m)
+{
+    uint32_t start = b->symbols.size / sizeof(image_symbol);
+
+    for (size_t i = 0; i < m->size; i++) {
+        image_symbol* s = section_alloc(&b->symbols, sizeof(image_symbol));
+        s->name = intern_string(b, m->keys[i]);
+        s->address = ((Value*) m->values[i])->value.to_int;
+    }
+    return start;
+}
+
+uint32_t emit_line(image_builder* b, const lxpos* pos, uint32_t address)
+{
+    uint32_t index = b->lines.size / sizeof(image_line);
+    image_line* l = section_alloc(&b->lines, sizeof(image_line));
+
+    // line addresses refer to source files by index
+    l->source = 0;
+    while (l->source < b->origins->size && strcmp(b->origins->keys[l->source], pos->origin)) {
+        l->source++;
+    }
+
+    if (l->source == b->origins->size) {
+        b->ok = false;
+    }
+
+    l->address = address;
+    l->line_pos = pos->line_pos;
+    l->col_pos = pos->col_pos;
+    l->char_offset = pos->char_offset;
+    l->line_offset = pos->line_offset;
+    l->caller = HE_IMAGE_NONE;
+    return index;
+}
+
+uint32_t emit_call_sites(image_builder* b, const lxpos* pos)
+{
+    uint32_t index = emit_line(b, pos, 0);
+
+    if (pos->caller != NULL) {
+        uint32_t caller = emit_call_sites(b, pos->caller);
+        ((image_line*) b->lines.data)[index].caller = caller;
+    }
+    return index;
+}
+
+uint32_t emit_lines(image_builder* b, map* m)
+{
+    uint32_t start = b->lines.size / sizeof(image_line);
+
+    for (size_t i = 0; i < m->size; i++) {
+        emit_line(b, m->values[i], atoi(m->keys[i]));
+    }
+
+    // call sites are stored past the table so it stays a contiguous range
+    for (size_t i = 0; i < m->size; i++)
+    {
+        const lxpos* pos = m->values[i];
+
+        if (pos->caller != NULL) {
+            uint32_t caller = emit_call_sites(b, pos->caller);
+            ((image_line*) b->lines.data)[start + i].caller = caller;
+        }
+    }
+    return start;
+}
+
+void emit_program(image_builder* b, program* p, uint32_t parent)
+{
+    image_program* ip = section_alloc(&b->programs, sizeof(image_program));
+    ip->parent = parent;
+    ip->argc = p->argc;
+    ip->native = HE_IMAGE_NONE;
+
+    // native methods are stored by name and relinked on load
+    if (p->native != NULL) {
+        const native_method* m = find_native(NULL, p->native);
+
+        if (m == NULL) {
+            b->ok = false;
+            return;
+        }
+
+        ip->flags = HE_IMAGE_NATIVE;
+        ip->native = intern_string(b, m->name);
+        return;
+    }
+
+    ip->code = b->code.size / sizeof(instruction);
+    ip->length = p->length;
+    memcpy(section_alloc(&b->code, sizeof(instruction) * p->length), p->code, sizeof(instruction) * p->length);
+
+    ip->symbols = emit_symbols(b, &p->symbol_table);
+    ip->nsymbols = p->symbol_table.size;
+    ip->closures = emit_symbols(b, &p->closure_table);
+    ip->nclosures = p->closure_table.size;
+    ip->lines = emit_lines(b, &p->line_address_table);
+    ip->nlines = p->line_address_table.size;
+
+    ip->constants = b->constants.size / sizeof(image_constant);
+    ip->nconstants = p->constant_table.size;
+
+    for (size_t i = 0; i < p->constant_table.size; i++)
+    {
+        Value v = p->constants[i];
+        image_constant* c = section_alloc(&b->constants, sizeof(image_constant));
+        c->type = v.type;
+
+        switch (v.type)
+        {
+            case VM_NULL:
+                break;
+            case VM_INT:
+                c->value.to_int = v.value.to_int;
+                break;
+            case VM_FLOAT:
+                c->value.to_float = v.value.to_float;
+                break;
+            case VM_BOOL:
+                c->value.to_int = v.value.to_bool;
+                break;
+            case VM_STRING:
+                c->ref = intern_string(b, v.value.to_str);
+                break;
+            case VM_PROGRAM:
+                c->ref = program_index(b, v.value.to_code->p);
+                break;
+            default:
+                b->ok = false;
+                break;
+        }
+    }
+}
+
+void write_section(FILE* f, image_section* s, uint32_t* offset, uint32_t* count, uint32_t* position, uint32_t entry, uint64_t* checksum)
+{
+    // sections are aligned so they can be used in place
+    static const char padding[8] = { 0 };
+    uint32_t aligned = (*position + 7) & ~7u;
+
+    fwrite(padding, 1, aligned - *position, f);
+    fwrite(s->data, 1, s->size, f);
+    *checksum = image_checksum(image_checksum(*checksum, padding, aligned - *position), s->data, s->size);
+
+    *offset = aligned;
+    *count = s->size / entry;
+    *position = aligned + s->size;
+}
+
+void cache_store(program* p, const char* script_path)
+{
+    image_builder b = {
+        .flat = vector_new(16),
+        .interned = map_new(64),
+        .origins = &p->source_table,
+        .ok = true,
+    };
+
+    // reserves offset zero so that no string is ever at the null offset
+    section_alloc(&b.strings, 1);
+
+    flatten_program(&b, p);
+
+    for (size_t i = 0; i < b.flat.size; i++) {
+        program* p0 = b.flat.items[i];
+        emit_program(&b, p0, i == 0 ? HE_IMAGE_NONE : program_index(&b, p0->prev));
+    }
+
+    // the script is always the first source file
+    for (size_t i = 0; i < p->source_table.size; i++)
+    {
+        image_source* s = section_alloc(&b.sources, sizeof(image_source));
+        s->path = intern_string(&b, p->source_table.keys[i]);
+        s->mtime = source_mtime(p->source_table.keys[i], &s->size);
+        s->hash = strhash(p->source_table.values[i]);
+
+        if (s->mtime == 0) b.ok = false;
+    }
+
+    if (!b.ok) {
+        return;
+    }
+
+    // writes to a temporary file so readers never see a partial cache
+    const char* path = cache_path(script_path);
+    char* tmp = malloc(sizeof(char) * (strlen(path) + 32));
+    sprintf(tmp, "%s.%i.tmp", path, getpid());
+
+    FILE* f = fopen(tmp, "wb");
+
+    if (f == NULL) {
+        return;
+    }
+
+    image_header h = {
+        .magic = HE_CACHE_MAGIC,
+        .version = HE_CACHE_VERSION,
+        .instruction_size = sizeof(instruction),
+        .optimization_level = optimization_level,
+    };
+    uint32_t position = sizeof(image_header);
+    uint64_t checksum = HE_IMAGE_CHECKSUM;
+
+    fwrite(&h, sizeof(image_header), 1, f);
+    write_section(f, &b.sources, &h.sources, &h.nsources, &position, sizeof(image_source), &checksum);
+    write_section(f, &b.programs, &h.programs, &h.nprograms, &position, sizeof(image_program), &checksum);
+    write_section(f, &b.constants, &h.constants, &h.nconstants, &position, sizeof(image_constant), &checksum);
+    write_section(f, &b.symbols, &h.symbols, &h.nsymbols, &position, sizeof(image_symbol), &checksum);
+    write_section(f, &b.lines, &h.lines, &h.nlines, &position, sizeof(image_line), &checksum);
+    write_section(f, &b.code, &h.code, &h.ncode, &position, sizeof(instruction), &checksum);
+    write_section(f, &b.strings, &h.strings, &h.nstrings, &position, sizeof(char), &checksum);
+    h.size = position;
+    h.checksum = image_checksum(checksum, &h, sizeof(image_header));
+
+    // header is rewritten once every section offset is known
+    boolean ok = !ferror(f) && fseek(f, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(image_header), 1, f) == 1;
+
+    if (fclose(f) != 0 || !ok || rename(tmp, path) != 0) {
+        remove(tmp);
+    }
+}
+
+// ---------------- IMAGE READER ----------------
+
+boolean section_valid(const image_header* h, uint32_t offset, uint32_t count, size_t entry)
+{
+    return offset % 8 == 0 && (uint64_t) offset + (uint64_t) count * entry <= h->size;
+}
+
+boolean range_valid(uint32_t start, uint32_t count, uint32_t total)
+{
+    return (uint64_t) start + count <= total;
+}
+
+boolean image_valid(const image_header* h, size_t size)
+{
+    if (h->magic != HE_CACHE_MAGIC || h->version != HE_CACHE_VERSION ||
+        h->instruction_size != sizeof(instruction) || h->optimization_level != (uint32_t) optimization_level ||
+        h->size != size) {
+        return false;
+    }
+
+    image_header header = *h;
+    header.checksum = 0;
+
+    if (image_checksum(image_checksum(HE_IMAGE_CHECKSUM, h + 1, h->size - sizeof(image_header)), &header, sizeof(image_header)) != h->checksum) {
+        return false;
+    }
+
+    // strings are the final section, the image always ends in a terminator
+    return section_valid(h, h->sources, h->nsources, sizeof(image_source)) &&
+        section_valid(h, h->programs, h->nprograms, sizeof(image_program)) &&
+        section_valid(h, h->constants, h->nconstants, sizeof(image_constant)) &&
+        section_valid(h, h->symbols, h->nsymbols, sizeof(image_symbol)) &&
+        section_valid(h, h->lines, h->nlines, sizeof(image_line)) &&
+        section_valid(h, h->code, h->ncode, sizeof(instruction)) &&
+        section_valid(h, h->strings, h->nstrings, sizeof(char)) &&
+        (uint64_t) h->strings + h->nstrings == h->size && h->nstrings > 0 &&
+        ((const char*) h)[h->size - 1] == '\0' && h->nsources > 0 && h->nprograms > 0;
+}
+
+const char* image_string(image_reader* r, uint32_t offset)
+{
+    return offset < r->header->nstrings ? r->base + r->header->strings + offset : NULL;
+}
+
+boolean link_symbols(image_reader* r, map* m, uint32_t start, uint32_t count)
+{
+    const image_symbol* symbols = (const image_symbol*) (r->base + r->header->symbols);
+
+    if (!range_valid(start, count, r->header->nsymbols)) {
+        return false;
+    }
+
+    for (uint32_t i = start; i < start + count; i++)
+    {
+        const char* name = image_string(r, symbols[i].name);
+
+        if (name == NULL || map_has(m, name)) return false;
+
+        Value* address = malloc(sizeof(Value));
+        *address = vInt(symbols[i].address);
+        map_put(m, name, address);
+    }
+    return true;
+}
+
+lxpos* link_line(image_reader* r, uint32_t index)
+{
+    const image_header* h = r->header;
+    const image_source* sources = (const image_source*) (r->base + h->sources);
+    const image_line* line = (const image_line*) (r->base + h->lines) + index;
+
+    if (line->source >= h->nsources) {
+        return NULL;
+    }
+
+    lxpos* pos = malloc(sizeof(lxpos));
+    pos->line_pos = line->line_pos;
+    pos->col_pos = line->col_pos;
+    pos->char_offset = line->char_offset;
+    pos->line_offset = line->line_offset;
+    pos->origin = image_string(r, sources[line->source].path);
+    pos->src = r->sources[line->source];
+    pos->caller = NULL;
+
+    // call sites always follow the lines referring to them, so chains cannot cycle
+    if (line->caller != HE_IMAGE_NONE)
+    {
+        if (line->caller <= index || line->caller >= h->nlines || (pos->caller = link_line(r, line->caller)) == NULL) {
+            free(pos);
+            return NULL;
+        }
+    }
+    return pos;
+}
+
+// whether an instruction at k of a linked program only refers to its own code, constants and variables
+boolean instruction_valid(program* p, size_t k)
+{
+    instruction i = p->code[k];
+    size_t locals = p->symbol_table.size;
+    int64_t target;
+
+    switch (i.stackop.op)
+    {
+        case OP_PUSHK:
+            return i.ux.ux < p->constant_table.size;
+
+        case OP_LOADG: case OP_STORG:
+            return i.sx.sx >= 0 && i.sx.sx < MAX_HEAP_SIZE;
+
+        case OP_LOADL: case OP_STORL: case OP_GUARDI: case OP_GUARDF:
+            if (i.sx.sx < 0 || (size_t) i.sx.sx >= locals) return false;
+            break;
+
+        case OP_LOADC: case OP_STORC:
+            return i.ux.ux < p->closure_table.size;
+
+        case OP_CALL: case OP_TAILCALL: case OP_CLOSE:
+            return i.ux.ux <= MAX_LOCAL_VARIABLES;
+
+        case OP_JMP:
+            target = (int64_t) k + i.sx.sx + 1;
+            return target >= 0 && target <= (int64_t) p->length;
+
+        // counted loops of the global program keep their variables in the heap
+        case OP_FORPREP: case OP_FORLOOP:
+            if (i.ux.ux & ~(FOR_OPERAND(0xff, 0xff) | FOR_EXCLUSIVE)) return false;
+            if (p->prev != NULL && (FOR_COUNTER(i.ux.ux) >= locals || FOR_LIMIT(i.ux.ux) + 1 >= locals)) return false;
+            if (i.stackop.op == OP_FORLOOP) return k + 1 < p->length && p->code[k + 1].stackop.op == OP_JMP;
+            break;
+
+        default:
+            if (i.stackop.op > OP_TAILCALL) return false;
+            break;
+    }
+
+    // conditional instructions skip the jump following them
+    if (i.stackop.op == OP_JIF || i.stackop.op == OP_GUARDI || i.stackop.op == OP_GUARDF || i.stackop.op == OP_FORPREP) {
+        return k + 1 < p->length;
+    }
+    return true;
+}
+
+void unlink_line(lxpos* pos)
+{
+    while (pos != NULL) {
+        lxpos* caller = (lxpos*) pos->caller;
+        free(pos);
+        pos = caller;
+    }
+}
+
+// frees what linking allocated for a program, its code and strings belong to the mapping
+void unlink_program(program* p)
+{
+    for (size_t i = 0; i < p->symbol_table.size; i++) free(p->symbol_table.values[i]);
+    for (size_t i = 0; i < p->closure_table.size; i++) free(p->closure_table.values[i]);
+
+    for (size_t i = 0; i < p->line_address_table.size; i++) {
+        free((char*) p->line_address_table.keys[i]);
+        unlink_line(p->line_address_table.values[i]);
+    }
+
+    for (size_t i = 0; i < p->constant_table.size; i++) {
+        if (p->constants[i].type == VM_PROGRAM) free(p->constants[i].value.to_code);
+    }
+
+    free(p->symbol_table.keys);
+    free(p->symbol_table.values);
+    free(p->closure_table.keys);
+    free(p->closure_table.values);
+    free(p->line_address_table.keys);
+    free(p->line_address_table.values);
+    free(p->source_table.keys);
+    free(p->source_table.values);
+    free(p->constants);
+    free(p->constant_table.slots);
+    free(p);
+}
+
+boolean link_program(image_reader* r, uint32_t index)
+{
+    const image_header* h = r->header;
+    const image_program* ip = (const image_program*) (r->base + h->programs) + index;
+    program* p = r->programs[index];
+
+    p->argc = ip->argc;
+
+    if (ip->flags & HE_IMAGE_NATIVE) {
+        const char* name = image_string(r, ip->native);
+        const native_method* m = name == NULL ? NULL : find_native(name, NULL);
+
+        if (m == NULL) return false;
+
+        p->native = m->f;
+        return true;
+    }
+
+    if (!range_valid(ip->code, ip->length, h->ncode) || !range_valid(ip->constants, ip->nconstants, h->nconstants) ||
+        !range_valid(ip->lines, ip->nlines, h->nlines) || ip->nconstants > MAX_OPERAND + 1) {
+        return false;
+    }
+
+    // instructions are executed straight from the mapping
+    p->code = (instruction*) (r->base + h->code) + ip->code;
+    p->length = ip->length;
+
+    if (!link_symbols(r, &p->symbol_table, ip->symbols, ip->nsymbols) ||
+        !link_symbols(r, &p->closure_table, ip->closures, ip->nclosures)) {
+        return false;
+    }
+
+    const image_line* lines = (const image_line*) (r->base + h->lines);
+
+    for (uint32_t i = ip->lines; i < ip->lines + ip->nlines; i++)
+    {
+        // addresses are ordered and within the code, positions are looked up by address
+        if (lines[i].address > ip->length || (i > ip->lines && lines[i].address <= lines[i - 1].address)) {
+            return false;
+        }
+
+        lxpos* pos = link_line(r, i);
+
+        if (pos == NULL) {
+            return false;
+        }
+
+        char* buf = malloc(sizeof(char) * 12);
+        sprintf(buf, "%u", lines[i].address);
+        map_put(&p->line_address_table, buf, pos);
+    }
+
+    // constant values hold pointers, so the pool itself is rebuilt
+    const image_constant* constants = (const image_constant*) (r->base + h->constants) + ip->constants;
+
+    for (uint32_t i = 0; i < ip->nconstants; i++)
+    {
+        Value v = vNull();
+
+        switch (constants[i].type)
+        {
+            case VM_NULL:
+                break;
+            case VM_INT:
+                v = vInt(constants[i].value.to_int);
+                break;
+            case VM_FLOAT:
+                v = vFloat(constants[i].value.to_float);
+                break;
+            case VM_BOOL:
+                v = vBool(constants[i].value.to_int);
+                break;
+            case VM_STRING:
+                // strings are used in place, the VM never writes to them
+                v.type = VM_STRING;
+                v.value.to_str = image_string(r, constants[i].ref);
+
+                if (v.value.to_str == NULL) return false;
+                break;
+            case VM_PROGRAM:
+                if (constants[i].ref == 0 || constants[i].ref >= h->nprograms) return false;
+
+                v = vCode(r->programs[constants[i].ref], NULL);
+                break;
+            default:
+                return false;
+        }
+
+        // equal strings share one offset in the image, so no constant of a valid pool is merged
+        if (pool_constant(p, v) != i) {
+            if (v.type == VM_PROGRAM) free(v.value.to_code);
+            return false;
+        }
+    }
+
+    for (size_t k = 0; k < p->length; k++) {
+        if (!instruction_valid(p, k)) return false;
+    }
+
+    return reg_stack_valid(p);
+}
+
+// frees the programs and tables of an image which failed to link
+boolean unlink_image(image_reader* r)
+{
+    for (uint32_t i = 0; r->programs != NULL && i < r->header->nprograms; i++) {
+        if (r->programs[i] != NULL) unlink_program(r->programs[i]);
+    }
+
+    free(r->programs);
+    free(r->sources);
+    return false;
+}
+
+boolean link_image(image_reader* r, program* p, const char* script_path)
+{
+    const image_header* h = r->header;
+
+    // validates every source file the program was compiled from
+    const image_source* sources = (const image_source*) (r->base + h->sources);
+    r->sources = malloc(sizeof(char*) * h->nsources);
+    r->programs = NULL;
+
+    for (uint32_t i = 0; i < h->nsources; i++)
+    {
+        const char* path = i == 0 ? script_path : image_string(r, sources[i].path);
+        uint64_t size = 0;
+        uint64_t mtime = path == NULL ? 0 : source_mtime(path, &size);
+
+        // the script itself is already loaded by the caller
+        if (i == 0) {
+            r->sources[i] = map_get(&p->source_table, script_path);
+        } else {
+            r->sources[i] = mtime == 0 ? NULL : read_file(path);
+        }
+
+        if (r->sources[i] == NULL || mtime != sources[i].mtime || size != sources[i].size || strhash(r->sources[i]) != sources[i].hash) {
+            return unlink_image(r);
+        }
+    }
+
+    // programs are allocated first so constants can refer to any of them
+    const image_program* programs = (const image_program*) (r->base + h->programs);
+    r->programs = calloc(h->nprograms, sizeof(program*));
+    r->programs[0] = program_new(NULL);
+
+    for (uint32_t i = 1; i < h->nprograms; i++)
+    {
+        if (programs[i].parent >= i) {
+            return unlink_image(r);
+        }
+
+        // the global program is moved into place once linked
+        r->programs[i] = program_new(programs[i].parent == 0 ? p : r->programs[programs[i].parent]);
+    }
+
+    for (uint32_t i = 0; i < h->nprograms; i++) {
+        if (!link_program(r, i)) return unlink_image(r);
+    }
+
+    // the linked global program is moved into place, only the sources of the empty one are kept
+    program linked = *r->programs[0];
+    *r->programs[0] = *p;
+    r->programs[0]->source_table = linked.source_table;
+    linked.source_table = p->source_table;
+    *p = linked;
+    unlink_program(r->programs[0]);
+
+    for (uint32_t i = 1; i < h->nsources; i++) {
+        map_put(&p->source_table, image_string(r, sources[i].path), (void*) r->sources[i]);
+    }
+
+    free(r->programs);
+    free(r->sources);
+    return true;
+}
+
+boolean cache_load(program* p, const char* script_path)
+{
+    int fd = open(cache_path(script_path), O_RDONLY);
+    struct stat st;
+
+    if (fd == -1) {
+        return false;
+    }
+
+    if (fstat(fd, &st) == -1 || st.st_size < (off_t) sizeof(image_header)) {
+        close(fd);
+        return false;
+    }
+
+    // shared read-only mapping, every process uses the same page cache
+    const char* base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    image_reader r = { .base = base, .header = (const image_header*) base };
+
+    if (!image_valid(r.header, st.st_size) || !link_image(&r, p, script_path)) {
+        munmap((void*) base, st.st_size);
+        return false;
+    }
+    return true;
+}
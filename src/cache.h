@@ -0,0 +1,143 @@
+#ifndef HE_CACHE_HEADER
+#define HE_CACHE_HEADER
+
+#include <sys/stat.h>
+
+#include "common.h"
+#include "compiler.h"
+#include "lib.h"
+#include "optimizer.h"
+
+#define HE_CACHE_MAGIC 0x00434548 // "HEC"
+#define HE_CACHE_VERSION 11
+
+#define HE_IMAGE_NONE 0xffffffff
+#define HE_IMAGE_NATIVE 0x1
+#define HE_IMAGE_CHECKSUM 0xcbf29ce484222325 // FNV-1a offset basis
+
+/*
+ * A bytecode cache is a single image which is mapped read-only and used
+ * in place. Every reference inside the image is an index or an offset
+ * relative to the start of its section, so the image contains no
+ * pointers and needs no relocation. Instructions and strings are never
+ * copied out of the mapping, processes running the same script share
+ * one physical copy of them. Constant pools, symbol tables and line
+ * tables hold pointers at run time and are still rebuilt on load.
+ *
+ * A checksum over the whole image detects caches which were truncated
+ * or corrupted after they were written. Linking also checks every
+ * instruction against the tables of its program, and the stack depth
+ * along every path. An image with a matching checksum but inconsistent
+ * contents therefore cannot index outside its tables either.
+ *
+ *  image_header
+ *  image_source[nsources]      files the image was compiled from
+ *  image_program[nprograms]    global program first, parents before children
+ *  image_constant[nconstants]
+ *  image_symbol[nsymbols]      symbol and closure tables
+ *  image_line[nlines]          line address tables, each followed by the
+ *                              call sites of inlined code it refers to
+ *  instruction[ncode]
+ *  char[nstrings]              NUL terminated strings
+ */
+
+typedef struct image_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t instruction_size;
+    uint32_t optimization_level;
+    uint32_t size;
+    uint32_t reserved;
+    uint64_t checksum; // of the sections, then of the header with this field cleared
+
+    // section offsets from the start of the image, and entry counts
+    uint32_t sources, nsources;
+    uint32_t programs, nprograms;
+    uint32_t constants, nconstants;
+    uint32_t symbols, nsymbols;
+    uint32_t lines, nlines;
+    uint32_t code, ncode;
+    uint32_t strings, nstrings;
+} image_header;
+
+typedef struct image_source {
+    uint32_t path;
+    uint32_t reserved;
+    uint64_t mtime;
+    uint64_t size;
+    uint64_t hash;
+} image_source;
+
+typedef struct image_program {
+    uint32_t flags;
+    uint32_t native;
+    uint32_t parent;
+    uint32_t argc;
+    uint32_t code, length;
+    uint32_t constants, nconstants;
+    uint32_t symbols, nsymbols;
+    uint32_t closures, nclosures;
+    uint32_t lines, nlines;
+} image_program;
+
+typedef struct image_constant {
+    uint32_t type;
+    uint32_t ref; // string offset or program index
+    union {
+        int64_t to_int;
+        double to_float;
+    } value;
+} image_constant;
+
+typedef struct image_symbol {
+    uint32_t name;
+    int32_t address;
+} image_symbol;
+
+typedef struct image_line {
+    uint32_t address;
+    uint32_t source;
+    uint32_t line_pos;
+    uint32_t col_pos;
+    uint32_t char_offset;
+    uint32_t line_offset;
+    uint32_t caller; // call site of inlined code, HE_IMAGE_NONE otherwise
+} image_line;
+
+/**
+ * @brief Returns the path of the bytecode cache file for a script, the
+ *      cache of "script.he" is stored alongside it as "script.hec".
+ *
+ * @param script_path Path to script
+ * @return Path to cache file
+ */
+const char* cache_path(const char* script_path);
+
+/**
+ * @brief Maps the bytecode image of a script and links its programs.
+ *      The cache is only used if every source file it was compiled
+ *      from (the script and its includes) still has the recorded
+ *      modification time and content hash, and the image was built at
+ *      the current optimization level. Images which fail validation
+ *      are unmapped and everything linked from them is freed. The
+ *      script source must already be registered in the program's
+ *      source table.
+ *
+ * @param p Reference to empty global program
+ * @param script_path Path to script
+ * @return True if the program was loaded from cache
+ */
+boolean cache_load(program* p, const char* script_path);
+
+/**
+ * @brief Lays out a compiled global program, its nested code objects
+ *      and the source files it depends on as a bytecode image stored
+ *      in the cache of the script. Failure to write the cache is
+ *      silently ignored.
+ *
+ * @param p Reference to compiled global program
+ * @param script_path Path to script
+ */
+void cache_store(program* p, const char* script_path);
+
+#endif
@@ -1,5 +1,9 @@
 #include "common.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 void file_error(const char* msg, const char* fname)
 {
     fprintf(stderr, "%sError! %s: %s%s\n", ERR_COL, msg, fname, DEF_COL);
@@ -8,39 +12,80 @@ void file_error(const char* msg, const char* fname)
 
 const char* read_file(const char* filepath)
 {
-    FILE* fptr = fopen(filepath, "r+");
+    int fd = open(filepath, O_RDONLY);
 
-    if (fptr == NULL) {
+    if (fd == -1) {
         file_error("Failed to open file", filepath);
     }
 
-    // goes to end of file
-    if (fseek(fptr, 0, SEEK_END) != 0) {
-        fclose(fptr);
+    struct stat st;
+
+    if (fstat(fd, &st) == -1) {
+        close(fd);
         file_error("Failed to read file", filepath);
     }
 
-    // size of file in bytes
-    long fsize = ftell(fptr);
+    // pipes, terminals and other streams cannot be mapped
+    if (!S_ISREG(st.st_mode)) {
+        const char* buffer = read_stream(fd, filepath);
+        close(fd);
+        return buffer;
+    }
 
-    if (fsize == -1) {
-        fclose(fptr);
-        file_error("Failed to read file", filepath);
+    if (st.st_size == 0) {
+        close(fd);
+        return "";
     }
 
-    fseek(fptr, 0, SEEK_SET);
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t fsize = st.st_size;
+    char* buffer;
 
-    char* buffer = (char*) calloc(fsize, sizeof(char));
-    size_t new_size = fread(buffer, sizeof(char), fsize, fptr);
+    if (fsize % page != 0) {
+        // the tail of the last page is zero filled by the kernel which
+        // terminates the source string
+        buffer = mmap(NULL, fsize, PROT_READ, MAP_PRIVATE, fd, 0);
+    } else {
+        // reserves an extra zeroed guard page to act as the terminator
+        // and maps the file over the start of the reservation
+        buffer = mmap(NULL, fsize + page, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        
+        if (buffer != MAP_FAILED) {
+            buffer = mmap(buffer, fsize, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+        }
+    }
+
+    close(fd);
 
-    if (ferror(fptr) != 0) {
-        fclose(fptr);
+    if (buffer == MAP_FAILED) {
         file_error("Failed to read file", filepath);
-    } else {
-        buffer[new_size++] = '\0';
     }
-    
-    fclose(fptr);
+
+    return buffer;
+}
+
+const char* read_stream(int fd, const char* name)
+{
+    size_t size = 0;
+    size_t capacity = 4096;
+    char* buffer = malloc(sizeof(char) * capacity);
+    ssize_t n;
+
+    while ((n = read(fd, buffer + size, capacity - size - 1)) > 0)
+    {
+        size += n;
+
+        if (size == capacity - 1) {
+            capacity *= 2;
+            buffer = realloc(buffer, sizeof(char) * capacity);
+        }
+    }
+
+    if (n == -1) {
+        file_error("Failed to read file", name);
+    }
+
+    buffer[size] = '\0';
     return buffer;
 }
 
@@ -20,7 +20,6 @@
 #define MAX_CALL_STACK 0xff
 #define MAX_STACK_SIZE 0xff
 #define MAX_HEAP_SIZE 0xfff
-#define MAX_LOCAL_CONSTANTS 0xff
 #define MAX_LOCAL_VARIABLES 0xff
 
 // #define HE_DEBUG_MODE
@@ -40,14 +39,25 @@ typedef unsigned char boolean;
 void file_error(const char* msg, const char* fname);
 
 /**
- * @brief Reads file from path into character buffer and returns
- *      pointer.
+ * @brief Maps file from path into memory read-only and returns a
+ *      pointer to the NUL terminated contents. Streams such as pipes
+ *      fall back to being read into a character buffer.
  * 
  * @param filepath Path to file 
  * @return String buffer
  */
 const char* read_file(const char* filepath);
 
+/**
+ * @brief Reads an unmappable stream (pipe, terminal) until end of file
+ *      into a NUL terminated character buffer.
+ * 
+ * @param fd File descriptor to read from
+ * @param name Name of stream used for error messages
+ * @return String buffer
+ */
+const char* read_stream(int fd, const char* name);
+
 /**
  * @brief Returns a substring beginning at a specified position
  *      till the end of the line (till newline character is reached).
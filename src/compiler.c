@@ -1,7 +1,7 @@
 #include "compiler.h"
+#include "vm.h"
+#include "optimizer.h"
 
-vm_op decode_binary_op(const char* operator);
-vm_op decode_unary_op(const char* operator);
 void runtimeerr(virtual_machine* vm, const char* msg);
 
 vm_op scope_load_op_map[] = {
@@ -18,199 +18,315 @@ vm_op scope_store_op_map[] = {
     OP_NOP,
 };
 
+// operations indexed by lexer operator kind, OP_NOP entries have no
+// bytecode equivalent
+vm_op binary_op_map[] = {
+    [LXOP_NONE] = OP_NOP,
+    [LXOP_ADD] = OP_ADD,
+    [LXOP_SUB] = OP_SUB,
+    [LXOP_MUL] = OP_MUL,
+    [LXOP_DIV] = OP_DIV,
+    [LXOP_MOD] = OP_MOD,
+    [LXOP_LT] = OP_LT,
+    [LXOP_LE] = OP_LE,
+    [LXOP_GT] = OP_GT,
+    [LXOP_GE] = OP_GE,
+    [LXOP_EQ] = OP_EQ,
+    [LXOP_NE] = OP_NE,
+    [LXOP_AND] = OP_AND,
+    [LXOP_OR] = OP_OR,
+    [LXOP_NOT] = OP_NOP,
+    [LXOP_BAND] = OP_NOP,
+    [LXOP_BOR] = OP_NOP,
+    [LXOP_BXOR] = OP_NOP,
+    [LXOP_BNOT] = OP_NOP,
+};
+
+// unary plus is the only operator which legitimately compiles to OP_NOP
+vm_op unary_op_map[] = {
+    [LXOP_NONE] = OP_NOP,
+    [LXOP_ADD] = OP_NOP,
+    [LXOP_SUB] = OP_NEG,
+    [LXOP_MUL] = OP_NOP,
+    [LXOP_DIV] = OP_NOP,
+    [LXOP_MOD] = OP_NOP,
+    [LXOP_LT] = OP_NOP,
+    [LXOP_LE] = OP_NOP,
+    [LXOP_GT] = OP_NOP,
+    [LXOP_GE] = OP_NOP,
+    [LXOP_EQ] = OP_NOP,
+    [LXOP_NE] = OP_NOP,
+    [LXOP_AND] = OP_NOP,
+    [LXOP_OR] = OP_NOP,
+    [LXOP_NOT] = OP_NOT,
+    [LXOP_BAND] = OP_NOP,
+    [LXOP_BOR] = OP_NOP,
+    [LXOP_BXOR] = OP_NOP,
+    [LXOP_BNOT] = OP_NOP,
+};
+
 // -------------- COMPILER METHODS --------------
 
-void compile(program* p, astnode* block)
+program* program_new(program* prev)
+{
+    program* p = (program*) malloc(sizeof(program));
+    p->code = NULL;
+    p->length = 0;
+    p->capacity = 0;
+    p->argc = 0;
+    p->constants = NULL;
+    p->prev = prev;
+    p->native = NULL;
+    p->calls = 0;
+    p->jit = NULL;
+    p->anchors = NULL;
+    p->reg = NULL;
+    p->symbol_table = map_new(8);
+    p->constant_table = (constant_index) {};
+    p->closure_table = map_new(4);
+    p->line_address_table = map_new(8);
+    p->source_table = map_new(1);
+    return p;
+}
+
+size_t push_instruction(program* p, vm_op op, int32_t operand)
+{
+    if (p->length >= p->capacity) {
+        p->capacity = p->capacity ? p->capacity * 2 : 64;
+        p->code = realloc(p->code, sizeof(instruction) * p->capacity);
+    }
+
+    p->code[p->length] = (instruction) { .sx = { op, operand } };
+    return p->length++;
+}
+
+void patch_jump(program* p, lxpos pos, size_t address, size_t target)
+{
+    int64_t offset = (int64_t) target - (int64_t) address - 1;
+
+    if (offset > MAX_JUMP || offset < -MAX_JUMP - 1) {
+        compilererr(p, pos, "Jump is too long, split the block into functions!");
+    }
+
+    p->code[address] = (instruction) { .sx = { OP_JMP, offset } };
+}
+
+void compile(program* p, ast* t, astref block)
 {
-    for (size_t i = 0; i < block->children.size; i++)
+    for (astref st = t->children[block]; st != ASTREF_NONE; st = t->siblings[st])
     {
-        compile_statement(p, vector_get(&block->children, i));
+        compile_statement(p, t, st);
     }
 }
 
-void compile_statement(program* p, astnode* statement)
+void compile_statement(program* p, ast* t, astref statement)
 {
-    recordaddress(p, &statement->pos);
+    lxpos pos = ast_pos(t, statement);
+    recordaddress(p, &pos);
 
-    switch (statement->type)
+    switch (t->kinds[statement])
     {
         case AST_ASSIGN:
-            compile_assignment(p, statement);
+            compile_assignment(p, t, statement);
             break;
         
         case AST_CALL:
-            compile_call(p, statement);
-            p->code[p->length++].stackop.op = OP_POP;
+            compile_call(p, t, statement);
+            push_instruction(p, OP_POP, 0);
             break;
         
         case AST_RETURN:
             if (p->prev == NULL) {
-                compilererr(p, statement->pos, "Cannot use return statement in global scope!");
+                compilererr(p, pos, "Cannot use return statement in global scope!");
             }
 
-            compile_expression(p, vector_get(&statement->children, 0));
-            p->code[p->length++].stackop.op = OP_RET;
+            compile_expression(p, t, t->children[statement]);
+
+            // a returned call reuses the frame of the caller
+            if (t->kinds[t->children[statement]] == AST_CALL) {
+                p->code[p->length - 1].stackop.op = OP_TAILCALL;
+            }
+            push_instruction(p, OP_RET, 0);
             break;
 
         case AST_INCLUDE:
-            astnode* fp = vector_get(&statement->children, 0);
-            run_import(p, fp);
+            run_import(p, t, t->children[statement]);
             break;
 
         case AST_LOOP:
-            compile_loop(p, statement);
+            compile_loop(p, t, statement);
+            break;
+
+        case AST_FOR:
+            compile_for(p, t, statement);
             break;
 
         case AST_BRANCHES:
-            compile_branches(p, statement);
+            compile_branches(p, t, statement);
             break;
 
         case AST_PUT:
-            compile_table_put(p, statement);
+            compile_table_put(p, t, statement);
+            push_instruction(p, OP_POP, 0);
             break;
         
         case AST_GET:
-            compile_table_get(p, statement);
+            compile_table_get(p, t, statement);
+            push_instruction(p, OP_POP, 0);
             break;
 
         default:
-            compilererr(p, statement->pos, "Failed to compile statement into bytecode!");
+            compilererr(p, pos, "Failed to compile statement into bytecode!");
     }
 }
 
-void compile_assignment(program* p, astnode* s)
+void compile_assignment(program* p, ast* t, astref s)
 {
     vm_scope scope;
-    astnode* rhs = vector_get(&s->children, 0);
-    int16_t address = register_variable(p, s->value, &scope);
+    astref rhs = t->children[s];
+    int16_t address = register_variable(p, ast_value(t, s), &scope);
 
     if (address >= MAX_LOCAL_VARIABLES) {
-        compilererr(p, s->pos, "Maxmum variables in local scope achieved!");
+        compilererr(p, ast_pos(t, s), "Maxmum variables in local scope achieved!");
     }
 
-    compile_expression(p, rhs);
-    p->code[p->length].sx.sx = address;
-    p->code[p->length].sx.op = scope_store_op_map[scope];
-    p->length++;
+    compile_expression(p, t, rhs);
+    push_instruction(p, scope_store_op_map[scope], address);
 }
 
-void compile_call(program* p, astnode* call)
+void compile_call(program* p, ast* t, astref call)
 {
-    for (size_t i = 1; i < call->children.size; i++)
+    // first child is the callee followed by the arguments
+    astref callee = t->children[call];
+    size_t argc = 0;
+
+    for (astref arg = t->siblings[callee]; arg != ASTREF_NONE; arg = t->siblings[arg])
     {
-        compile_expression(p, vector_get(&call->children, i));   
+        compile_expression(p, t, arg);
+        argc++;
     }
-    
-    // vm_scope scope;
-    // p->code[p->length].sx.sx = dereference_variable(p, call->value, &scope);
-    // p->code[p->length].sx.op = scope_load_op_map[scope];
-    // p->length++;
 
-    // if (scope == VM_UNKNOWN_SCOPE) {
-    //     compilererr(p, call->pos, "Unknown function name!");
-    // }
+    compile_expression(p, t, callee);
 
-    compile_expression(p, vector_rm(&call->children, 0));
-
-    p->code[p->length].ux.op = OP_CALL;
-    p->code[p->length].ux.ux = call->children.size;
-    p->length++;
+    push_instruction(p, OP_CALL, argc);
 }
 
-void compile_function(program* p, astnode* function)
+void compile_function(program* p, ast* t, astref function)
 {
-    program* p0 = malloc(sizeof(program));
-    p0->code = malloc(sizeof(instruction) * 0xff);
-    p0->length = 0;
-    p0->constants = malloc(sizeof(Value) * 0xff);
-    p0->prev = p;
-    p0->constant_table = map_new(37);
-    p0->symbol_table = map_new(37);
-    p0->line_address_table = map_new(37);
-    p0->native = NULL;
+    program* p0 = program_new(p);
 
     // register parameter names
-    astnode* params = vector_get(&function->children, 0);
-    for (p0->argc = 0; p0->argc < params->children.size; p0->argc++)
+    astref params = t->children[function];
+    p0->argc = 0;
+
+    for (astref param = t->children[params]; param != ASTREF_NONE; param = t->siblings[param])
     {
         vm_scope scope;
-        astnode* param = vector_get(&params->children, p0->argc);
-        register_unique_variable_local(p0, param->value, &scope);  
+        register_unique_variable_local(p0, ast_value(t, param), &scope);  
+        p0->argc++;
     
         if (scope == VM_DUPLICATE_IN_SCOPE) {
-            compilererr(p0, param->pos, "Duplicate variable name in function definition!");
+            compilererr(p0, ast_pos(t, param), "Duplicate variable name in function definition!");
         }
     }
 
     // compiles program code
-    compile(p0, vector_get(&function->children, 1));;
+    compile(p0, t, t->siblings[params]);
 
-    if (p0->code[p0->length-1].stackop.op != OP_RET) {
-        p0->code[p0->length].ux.op = OP_PUSHK;
-        p0->code[p0->length++].ux.ux = register_constant(p0, vNull());
-        p0->code[p0->length++].stackop.op = OP_RET;
+    if (p0->length == 0 || p0->code[p0->length-1].stackop.op != OP_RET) {
+        push_instruction(p0, OP_PUSHK, register_constant(p0, vNull()));
+        push_instruction(p0, OP_RET, 0);
     }
 
     // stores code object as local constant
-    p->code[p->length].ux.op = OP_PUSHK;
-    p->code[p->length].ux.ux = register_constant(p, vCode(p0, NULL));
-    p->length++;
+    push_instruction(p, OP_PUSHK, register_constant(p, vCode(p0, NULL)));
 
     if (p0->closure_table.size) {
 
         // loads closure values to create closure object
         for (size_t i = 0; i < p0->closure_table.size; i++) {
             vm_scope scope;
-            p->code[p->length].sx.sx = dereference_variable(p, p0->closure_table.keys[i], &scope);
-            p->code[p->length].sx.op = scope_load_op_map[scope];
-            p->length++;
+            int16_t address = dereference_variable(p, p0->closure_table.keys[i], &scope);
+            push_instruction(p, scope_load_op_map[scope], address);
         }
         
-        p->code[p->length].ux.op = OP_CLOSE;
-        p->code[p->length].ux.ux = p0->closure_table.size;
-        p->length++;
+        push_instruction(p, OP_CLOSE, p0->closure_table.size);
     }
 }
 
-void compile_expression(program* p, astnode* expression)
+void compile_expression(program* p, ast* t, astref expression)
 {
-    switch (expression->type)
+    lxop op = t->ops[expression];
+    Value folded;
+    astref operand;
+
+    switch (t->kinds[expression])
     {
         case AST_BINARY_EXPRESSION:
-            compile_expression(p, vector_get(&expression->children, 0));
-            compile_expression(p, vector_get(&expression->children, 1));
-            p->code[p->length++].stackop.op = decode_binary_op(expression->value);
+            if (binary_op_map[op] == OP_NOP) {
+                compilererr(p, ast_pos(t, expression), "Failed to decode binary operator!");
+            }
+
+            if (optimization_level > 0 && fold_constant(t, expression, &folded)) {
+                push_instruction(p, OP_PUSHK, register_constant(p, folded));
+                break;
+            }
+
+            if (optimization_level > 0 && (operand = identity_operand(t, expression)) != ASTREF_NONE) {
+                compile_expression(p, t, operand);
+                break;
+            }
+
+            // x + "a" + "b" is compiled as x + "ab"
+            if (optimization_level > 0 && (operand = fold_concatenation(t, expression, &folded)) != ASTREF_NONE) {
+                compile_expression(p, t, operand);
+                push_instruction(p, OP_PUSHK, register_constant(p, folded));
+                push_instruction(p, OP_ADD, 0);
+                break;
+            }
+
+            compile_expression(p, t, ast_child(t, expression, 0));
+            compile_expression(p, t, ast_child(t, expression, 1));
+            push_instruction(p, binary_op_map[op], 0);
             break;
         
         case AST_UNARY_EXPRESSION:
-            compile_expression(p, vector_get(&expression->children, 0));
-            p->code[p->length++].stackop.op = decode_unary_op(expression->value);
+            if (unary_op_map[op] == OP_NOP && op != LXOP_ADD) {
+                compilererr(p, ast_pos(t, expression), "Failed to decode unary operator!");
+            }
+
+            if (optimization_level > 0 && fold_constant(t, expression, &folded)) {
+                push_instruction(p, OP_PUSHK, register_constant(p, folded));
+                break;
+            }
+
+            compile_expression(p, t, t->children[expression]);
+            push_instruction(p, unary_op_map[op], 0);
             break;
 
         case AST_CALL:
-            compile_call(p, expression);
+            compile_call(p, t, expression);
             break;
         
         case AST_FUNCTION:
-            compile_function(p, expression);
+            compile_function(p, t, expression);
             break;
 
         case AST_REFERENCE:
             vm_scope scope;
-            p->code[p->length].sx.sx = dereference_variable(p, expression->value, &scope);
-            p->code[p->length].sx.op = scope_load_op_map[scope];
-            p->length++;
+            int16_t address = dereference_variable(p, ast_value(t, expression), &scope);
+            push_instruction(p, scope_load_op_map[scope], address);
 
             if (scope == VM_UNKNOWN_SCOPE)
-                compilererr(p, expression->pos, "Unknown variable name!");
+                compilererr(p, ast_pos(t, expression), "Unknown variable name!");
             break;
         
         case AST_TABLE:
-            compile_table(p, expression);
+            compile_table(p, t, expression);
             break;
         
         case AST_GET:
-            compile_table_get(p, expression);
+            compile_table_get(p, t, expression);
             break;
 
         case AST_INTEGER:
@@ -218,64 +334,115 @@ void compile_expression(program* p, astnode* expression)
         case AST_STRING:
         case AST_BOOL:
         case AST_NULL:
-            p->code[p->length].ux.op = OP_PUSHK;
-            p->code[p->length].ux.ux = register_constant(p, value_from_node(expression));
-            p->length++;
+            push_instruction(p, OP_PUSHK, register_constant(p, value_from_node(t, expression)));
             break;
         
         default:
-            compilererr(p, expression->pos, "Failed to compile expression!");
+            compilererr(p, ast_pos(t, expression), "Failed to compile expression!");
     }
 }
 
-void compile_loop(program* p, astnode* loop)
+void compile_loop(program* p, ast* t, astref loop)
 {
-    int pos0 = p->length;
+    size_t pos0 = p->length;
+    astref cond = t->children[loop];
 
-    compile_expression(p, vector_get(&loop->children, 0));
-    p->code[p->length++].stackop.op = OP_JIF;
+    compile_expression(p, t, cond);
+    push_instruction(p, OP_JIF, 0);
 
-    int pos1 = p->length++;
+    size_t pos1 = push_instruction(p, OP_JMP, 0);
     
-    compile(p, vector_get(&loop->children, 1));
+    compile(p, t, t->siblings[cond]);
 
     // restart loop
-    p->code[p->length].sx.op = OP_JMP;
-    p->code[p->length].sx.sx = pos0 - p->length - 1;
-    p->length++;
+    patch_jump(p, ast_pos(t, loop), push_instruction(p, OP_JMP, 0), pos0);
 
     // jump to end
-    p->code[pos1].sx.op = OP_JMP;
-    p->code[pos1].sx.sx = p->length - pos1 - 1;
+    patch_jump(p, ast_pos(t, loop), pos1, p->length);
 }
 
-void compile_branches(program* p, astnode* branches)
+void compile_for(program* p, ast* t, astref loop)
 {
+    vm_scope scope;
+    astref start = t->children[loop];
+    astref limit = t->siblings[start];
+    astref step = ast_count(t, loop) > 3 ? t->siblings[limit] : ASTREF_NONE;
+    astref body = ast_child(t, loop, ast_count(t, loop) - 1);
+
+    // the counter belongs to the scope of the loop, even if an enclosing scope has the same name
+    int16_t counter = register_unique_variable_local(p, ast_value(t, loop), &scope);
+    int16_t hidden = p->symbol_table.size;
+
+    // limit and step are kept in two hidden variables following each other
+    for (size_t i = 0; i < 2; i++)
+    {
+        char* name = malloc(sizeof(char) * 24);
+        Value* address = malloc(sizeof(Value));
+        sprintf(name, "$for%li", p->symbol_table.size);
+        *address = vInt(p->symbol_table.size);
+        map_put(&p->symbol_table, name, address);
+    }
+
+    if (p->symbol_table.size >= MAX_LOCAL_VARIABLES) {
+        compilererr(p, ast_pos(t, loop), "Maxmum variables in local scope achieved!");
+    }
+
+    compile_expression(p, t, start);
+    push_instruction(p, p->prev == NULL ? OP_STORG : OP_STORL, counter);
+
+    compile_expression(p, t, limit);
+
+    if (step != ASTREF_NONE) {
+        compile_expression(p, t, step);
+    } else {
+        push_instruction(p, OP_PUSHK, register_constant(p, vInt(1)));
+    }
+
+    // an empty range jumps past the loop
+    push_instruction(p, OP_FORPREP, FOR_OPERAND(counter, hidden));
+
+    size_t pos0 = push_instruction(p, OP_JMP, 0);
+
+    compile(p, t, body);
+
+    // increments counter and restarts loop while it is in range
+    push_instruction(p, OP_FORLOOP, FOR_OPERAND(counter, hidden));
+
+    patch_jump(p, ast_pos(t, loop), push_instruction(p, OP_JMP, 0), pos0 + 1);
+
+    // jump to end
+    patch_jump(p, ast_pos(t, loop), pos0, p->length);
+}
+
+void compile_branches(program* p, ast* t, astref branches)
+{
+    astref cond = t->children[branches];
+    astref body = t->siblings[cond];
+
     // compile condition
-    compile_expression(p, vector_get(&branches->children, 0));
-    p->code[p->length++].stackop.op = OP_JIF;
-    int pos0 = p->length++;
+    compile_expression(p, t, cond);
+    push_instruction(p, OP_JIF, 0);
+    size_t pos0 = push_instruction(p, OP_JMP, 0);
 
     // compile body
-    compile(p, vector_get(&branches->children, 1));
-    int pos1 = p->length++;
+    compile(p, t, body);
+    size_t pos1 = push_instruction(p, OP_JMP, 0);
 
     // skip body if condition not met
-    p->code[pos0].sx.op = OP_JMP;
-    p->code[pos0].sx.sx = p->length - pos0 - 1;
+    patch_jump(p, ast_pos(t, branches), pos0, p->length);
 
-    astnode* alt = vector_get(&branches->children, 2);
+    astref alt = t->siblings[body];
 
-    if (alt != NULL) 
+    if (alt != ASTREF_NONE) 
     {
-        if (streq(alt->value, "conditional")) {
-            compile_branches(p, alt);
+        // else branches only hold a body
+        if (t->siblings[t->children[alt]] != ASTREF_NONE) {
+            compile_branches(p, t, alt);
         } else {
-            compile(p, vector_get(&alt->children, 0));
+            compile(p, t, t->children[alt]);
         }
 
-        p->code[pos1].sx.op = OP_JMP;
-        p->code[pos1].sx.sx = p->length - pos1 - 1;
+        patch_jump(p, ast_pos(t, branches), pos1, p->length);
     } 
     else 
     {
@@ -283,59 +450,93 @@ void compile_branches(program* p, astnode* branches)
     }
 }
 
-void compile_table(program* p, astnode* table)
+void compile_table(program* p, ast* t, astref table)
 {
-    p->code[p->length++].stackop.op = OP_TNEW;
+    push_instruction(p, OP_TNEW, 0);
 
-    for (size_t i = 0; i < table->children.size; i++)
+    for (astref pair = t->children[table]; pair != ASTREF_NONE; pair = t->siblings[pair])
     {
-        astnode* pair = vector_get(&table->children, i);
-        compile_expression(p, pair->children.items[0]); 
-        compile_expression(p, pair->children.items[1]);
-        p->code[p->length++].stackop.op = OP_TPUT;
+        astref key = t->children[pair];
+        compile_expression(p, t, key); 
+        compile_expression(p, t, t->siblings[key]);
+        push_instruction(p, OP_TPUT, 0);
     }
 }
 
-void compile_table_put(program* p, astnode* put) 
+void compile_table_put(program* p, ast* t, astref put) 
 {
     vm_scope scope;
-    p->code[p->length].sx.sx = dereference_variable(p, put->value, &scope);
-    p->code[p->length].sx.op = scope_load_op_map[scope];
-    p->length++;
+    int16_t address = dereference_variable(p, ast_value(t, put), &scope);
+    push_instruction(p, scope_load_op_map[scope], address);
 
-    compile_expression(p, vector_get(&put->children, 0));
-    compile_expression(p, vector_get(&put->children, 1));
-    p->code[p->length++].stackop.op = OP_TPUT;
+    astref key = t->children[put];
+    compile_expression(p, t, key);
+    compile_expression(p, t, t->siblings[key]);
+    push_instruction(p, OP_TPUT, 0);
 }
 
-void compile_table_get(program* p, astnode* get)
+void compile_table_get(program* p, ast* t, astref get)
 {
     vm_scope scope;
-    p->code[p->length].sx.sx = dereference_variable(p, get->value, &scope);
-    p->code[p->length].sx.op = scope_load_op_map[scope];
-    p->length++;
+    int16_t address = dereference_variable(p, ast_value(t, get), &scope);
+    push_instruction(p, scope_load_op_map[scope], address);
+
+    compile_expression(p, t, t->children[get]);
+    push_instruction(p, OP_TGET, 0);
+}
+
+Value value_from_node(ast* t, astref node)
+{
+    Value v;
+    const char* value = ast_value(t, node);
+    
+    switch (t->kinds[node])
+    {
+        case AST_INTEGER:
+            v.type = VM_INT;
+            v.value.to_int = strtol(value, NULL, 10);
+            break;
+        
+        case AST_FLOAT:
+            v.type = VM_FLOAT;
+            v.value.to_float = atof(value);
+            break;
+        
+        case AST_BOOL:
+            v.type = VM_BOOL;
+            v.value.to_bool = streq(value, "true");
+            break;
+        
+        case AST_STRING:
+            v.type = VM_STRING;
+            v.value.to_str = value;
+            break;
+        
+        case AST_NULL:
+            v.type = VM_NULL;
+            v.value.to_code = NULL;
+            break;
 
-    compile_expression(p, vector_get(&get->children, 0));
-    p->code[p->length++].stackop.op = OP_TGET;
+        default: failure("Failed to coerce node to value!");
+    }
+
+    return v;
+}
+
+void register_all_natives(program* p)
+{
+    for (const native_method* m = native_methods; m->name != NULL; m++) {
+        create_native(p, m->name, m->f, m->argc);
+    }
 }
 
 void create_native(program* p, const char* name, Value (*f)(Value[]), int argc)
 {
-    program* p0 = (program*) malloc(sizeof(program));
-    p0->code = NULL;
-    p0->length = 0;
+    program* p0 = program_new(p);
     p0->argc = argc;
-    p0->constants = NULL;
-    p0->symbol_table = map_new(0);
-    p0->constant_table = map_new(0);
-    p0->closure_table = map_new(0);
-    p0->line_address_table = map_new(0);
-    p0->prev = p;
     p0->native = f;
 
-    p->code[p->length].ux.op = OP_PUSHK;
-    p->code[p->length].ux.ux = register_constant(p, vCode(p0, NULL));
-    p->length++;
+    push_instruction(p, OP_PUSHK, register_constant(p, vCode(p0, NULL)));
 
     vm_scope scope;
     uint16_t address = register_variable(p, name, &scope);
@@ -346,26 +547,25 @@ void create_native(program* p, const char* name, Value (*f)(Value[]), int argc)
     }
 
     // stores code at address
-    p->code[p->length].sx.sx = address;
-    p->code[p->length].sx.op = scope_store_op_map[scope];
-    p->length++;
+    push_instruction(p, scope_store_op_map[scope], address);
 }
 
-void run_import(program* p, astnode* filepath)
+void run_import(program* p, ast* t, astref filepath)
 {
     if (p->prev != NULL) {
-        compilererr(p, filepath->pos, "Cannot import in local scope!");
+        compilererr(p, ast_pos(t, filepath), "Cannot import in local scope!");
     }
 
     // determines absolute system path of include
     char* path = (char*)malloc(sizeof(char) * 512);
     path[0] = '\0';
-    strcpy(path, filepath->pos.origin);
+    strcpy(path, t->origin);
     dirname(path);
     strcat(path, "/");
-    strcat(path, filepath->value);
+    strcat(path, ast_value(t, filepath));
 
     const char* src = read_file(path);
+    map_put(&p->source_table, path, (void*) src);
 
     vector tokens = vector_new(64);
     lexer lx = lexer_new(src, path);
@@ -374,34 +574,402 @@ void run_import(program* p, astnode* filepath)
     parser p0 = {
         .position = 0,
         .source = src,
-        .tokens = tokens
+        .tokens = tokens,
+        .tree = ast_new(path, src)
     };
 
-    astnode* tree = parse(&p0);
+    astref tree = parse(&p0);
     
-    compile(p, tree);
+    compile(p, &p0.tree, tree);
+    ast_delete(&p0.tree);
+}
+
+// -------------- CONSTANT FOLDING --------------
+
+#define IS_NUMERIC(type) ((type) == VM_INT || (type) == VM_FLOAT || (type) == VM_BOOL)
+
+// Checks whether the VM can apply an operation to constants without
+// raising a runtime error, mirroring the type checks of value.c
+boolean foldable_operation(vm_op op, Value a, Value b)
+{
+    boolean numeric = IS_NUMERIC(a.type) && IS_NUMERIC(b.type);
+
+    switch (op)
+    {
+        case OP_ADD:
+            return numeric || (a.type == VM_STRING && b.type == VM_STRING);
+
+        case OP_SUB:
+        case OP_MUL:
+        case OP_LT:
+        case OP_LE:
+        case OP_GT:
+        case OP_GE:
+            return numeric;
+
+        // vDiv reads the divisor as a float when checking for zero
+        case OP_DIV:
+            if (a.type == VM_INT && b.type == VM_INT && b.value.to_int == -1) return false;
+
+            return (a.type == VM_INT || a.type == VM_FLOAT) &&
+                ((b.type == VM_INT && b.value.to_int != 0 && b.value.to_float != 0.0) ||
+                (b.type == VM_FLOAT && b.value.to_float != 0.0));
+
+        case OP_MOD:
+            if (a.type == VM_STRING && b.type == VM_INT) {
+                return b.value.to_int >= 0 && b.value.to_int < strlen(a.value.to_str);
+            }
+            return a.type == VM_INT && b.type == VM_INT && b.value.to_int != 0 && b.value.to_int != -1;
+
+        case OP_EQ:
+        case OP_NE:
+        case OP_AND:
+        case OP_OR:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+// Fold state of a node, every subtree is folded once and its result kept
+enum { FOLD_UNKNOWN, FOLD_CONSTANT, FOLD_NONE };
+
+static boolean fold_node(ast* t, astref expression, Value* out);
+
+boolean fold_constant(ast* t, astref expression, Value* out)
+{
+    // the tree is complete once compiled, so the caches never grow
+    if (t->folds == NULL) {
+        t->folds = calloc(t->size, sizeof(uint8_t));
+        t->folded = malloc(sizeof(Value) * t->size);
+    }
+
+    if (t->folds[expression] == FOLD_UNKNOWN) {
+        t->folds[expression] = fold_node(t, expression, &t->folded[expression]) ? FOLD_CONSTANT : FOLD_NONE;
+    }
+
+    if (t->folds[expression] == FOLD_NONE) {
+        return false;
+    }
+
+    *out = t->folded[expression];
+    return true;
+}
+
+static boolean fold_node(ast* t, astref expression, Value* out)
+{
+    lxop op = t->ops[expression];
+    Value v0, v1;
+
+    switch (t->kinds[expression])
+    {
+        case AST_INTEGER:
+        case AST_FLOAT:
+        case AST_STRING:
+        case AST_BOOL:
+        case AST_NULL:
+            *out = value_from_node(t, expression);
+            return true;
+
+        case AST_UNARY_EXPRESSION:
+            if (!fold_constant(t, t->children[expression], &v0)) {
+                return false;
+            }
+
+            if (op == LXOP_ADD) {
+                *out = v0;
+            } else if (op == LXOP_SUB && IS_NUMERIC(v0.type)) {
+                *out = vNegate(v0);
+            } else if (op == LXOP_NOT) {
+                *out = vBool(!native_bool_cast(&v0).value.to_bool);
+            } else {
+                return false;
+            }
+            return true;
+
+        case AST_BINARY_EXPRESSION:
+            if (!fold_constant(t, ast_child(t, expression, 0), &v0) || !fold_constant(t, ast_child(t, expression, 1), &v1) ||
+                !foldable_operation(binary_op_map[op], v0, v1)) {
+                return false;
+            }
+
+            *out = apply_vm_op(binary_op_map[op], v0, v1);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static vm_type infer_static_type(ast* t, astref expression);
+
+vm_type static_type(ast* t, astref expression)
+{
+    if (t->types == NULL) {
+        t->types = calloc(t->size, sizeof(uint8_t));
+    }
+
+    if (t->types[expression] == 0) {
+        t->types[expression] = infer_static_type(t, expression) + 1;
+    }
+
+    return t->types[expression] - 1;
+}
+
+static vm_type infer_static_type(ast* t, astref expression)
+{
+    lxop op = t->ops[expression];
+    vm_type a, b;
+
+    switch (t->kinds[expression])
+    {
+        case AST_INTEGER: return VM_INT;
+        case AST_FLOAT: return VM_FLOAT;
+        case AST_BOOL: return VM_BOOL;
+
+        case AST_UNARY_EXPRESSION:
+            if (op == LXOP_NOT) return VM_BOOL;
+
+            a = static_type(t, t->children[expression]);
+            return IS_NUMERIC(a) ? a : VM_NULL;
+
+        case AST_BINARY_EXPRESSION:
+            switch (op)
+            {
+                case LXOP_LT:
+                case LXOP_LE:
+                case LXOP_GT:
+                case LXOP_GE:
+                case LXOP_EQ:
+                case LXOP_NE:
+                case LXOP_AND:
+                case LXOP_OR:
+                    return VM_BOOL;
+
+                case LXOP_ADD:
+                case LXOP_SUB:
+                case LXOP_MUL:
+                case LXOP_DIV:
+                case LXOP_MOD:
+                    a = static_type(t, ast_child(t, expression, 0));
+                    b = static_type(t, ast_child(t, expression, 1));
+
+                    // results take the widest operand type, floats cannot be used in modulo
+                    if (!IS_NUMERIC(a) || !IS_NUMERIC(b) || (op == LXOP_MOD && (a == VM_FLOAT || b == VM_FLOAT))) {
+                        return VM_NULL;
+                    } else if (a == b) {
+                        return a;
+                    } else {
+                        return a == VM_FLOAT || b == VM_FLOAT ? VM_FLOAT : VM_INT;
+                    }
+
+                default:
+                    return VM_NULL;
+            }
+
+        default:
+            return VM_NULL;
+    }
+}
+
+// Checks whether x op c is x for every x of the given type, booleans
+// are only preserved by boolean constants
+boolean is_identity(vm_op op, vm_type type, Value c, boolean right)
+{
+    boolean one = (c.type == VM_INT && c.value.to_int == 1) || (c.type == VM_BOOL && c.value.to_bool);
+    boolean zero = (c.type == VM_INT && c.value.to_int == 0) || (c.type == VM_BOOL && !c.value.to_bool);
+
+    if (!IS_NUMERIC(type) || (type == VM_BOOL && c.type != VM_BOOL)) {
+        return false;
+    }
+
+    switch (op)
+    {
+        case OP_MUL: return one;
+        case OP_DIV: return one && right;
+        case OP_SUB: return zero && right;
+
+        // -0.0 + 0 is 0.0, so floats are excluded
+        case OP_ADD: return zero && type != VM_FLOAT;
+
+        case OP_AND: return type == VM_BOOL && one;
+        case OP_OR: return type == VM_BOOL && zero;
+        default: return false;
+    }
+}
+
+// Operand of a binary expression which an algebraic identity such as
+// x * 1 reduces the expression to
+astref identity_operand(ast* t, astref expression)
+{
+    astref lhs = ast_child(t, expression, 0);
+    astref rhs = ast_child(t, expression, 1);
+    Value c;
+
+    vm_op op = binary_op_map[t->ops[expression]];
+
+    if (fold_constant(t, rhs, &c) && is_identity(op, static_type(t, lhs), c, true)) {
+        return lhs;
+    }
+
+    if (fold_constant(t, lhs, &c) && is_identity(op, static_type(t, rhs), c, false)) {
+        return rhs;
+    }
+
+    return ASTREF_NONE;
+}
+
+// Joins the string literals at the end of a concatenation chain, the
+// remaining operand is returned with the joined suffix as output
+astref fold_concatenation(ast* t, astref expression, Value* out)
+{
+    Value suffix, v;
+    size_t count = 0;
+
+    while (t->kinds[expression] == AST_BINARY_EXPRESSION && t->ops[expression] == LXOP_ADD &&
+        fold_constant(t, ast_child(t, expression, 1), &v) && v.type == VM_STRING)
+    {
+        suffix = count++ == 0 ? v : vAdd(v, suffix);
+        expression = ast_child(t, expression, 0);
+    }
+
+    if (count < 2) {
+        return ASTREF_NONE;
+    }
+
+    *out = suffix;
+    return expression;
 }
 
 // ---------------- MEMORY STORE ----------------
 
-uint16_t register_constant(program* p, Value v)
+// Section shared by every program of the module, holding the first copy of each string constant
+static Value* shared_strings = NULL;
+static constant_index shared_index = {};
+
+// Hashes a constant by its type and bits, or by the contents of a string
+static size_t constant_hash(Value* v, boolean contents)
 {
-    Value* address;
+    uint64_t bits = 0;
+    double f;
 
-    if ((address = map_get(&p->constant_table, value_to_str(&v))) == NULL) 
+    switch (v->type)
     {
-        address = malloc(sizeof(Value));
-        *address = vInt(p->constant_table.size);
+        case VM_NULL:
+            break;
+        case VM_BOOL:
+            bits = v->value.to_bool;
+            break;
+        case VM_INT:
+            bits = v->value.to_int;
+            break;
+        case VM_FLOAT:
+            f = v->value.to_float;
+            memcpy(&bits, &f, sizeof(bits));
+            break;
+        case VM_STRING:
+            bits = contents ? strhash(v->value.to_str) : (uintptr_t) v->value.to_str;
+            break;
+        default:
+            bits = (uintptr_t) v->value.to_code;
+    }
+
+    bits = (bits ^ v->type) * 0x9e3779b97f4a7c15ull;
+    return bits ^ (bits >> 32);
+}
+
+static boolean constant_equal(Value* a, Value* b, boolean contents)
+{
+    double x, y;
+
+    if (a->type != b->type) {
+        return false;
+    }
+
+    switch (a->type)
+    {
+        case VM_NULL:
+            return true;
+        case VM_BOOL:
+            return a->value.to_bool == b->value.to_bool;
+        case VM_INT:
+            return a->value.to_int == b->value.to_int;
+        case VM_FLOAT:
+            // bits are compared, so 0.0 and -0.0 stay apart
+            x = a->value.to_float;
+            y = b->value.to_float;
+            return memcmp(&x, &y, sizeof(double)) == 0;
+        case VM_STRING:
+            return contents ? streq(a->value.to_str, b->value.to_str) : a->value.to_str == b->value.to_str;
+        default:
+            return a->value.to_code == b->value.to_code;
+    }
+}
 
-        if (address->value.to_int >= MAX_LOCAL_CONSTANTS) {
+// Slot holding a constant in the index, or the empty slot it belongs in
+static uint32_t* constant_slot(constant_index* t, Value* pool, Value* v, boolean contents)
+{
+    for (size_t s = constant_hash(v, contents) & t->mask; ; s = (s + 1) & t->mask)
+    {
+        uint32_t* slot = &t->slots[s];
+
+        if (*slot == 0 || constant_equal(&pool[*slot - 1], v, contents)) {
+            return slot;
+        }
+    }
+}
+
+// Adds a constant to a pool unless an equal one is in it, the index is kept at most half full
+static uint32_t constant_put(constant_index* t, Value** pool, Value v, boolean contents)
+{
+    if (2 * (t->size + 1) > t->mask + 1 || t->slots == NULL)
+    {
+        constant_index grown = *t;
+        grown.mask = t->slots == NULL ? 15 : t->mask * 2 + 1;
+        grown.slots = calloc(grown.mask + 1, sizeof(uint32_t));
+
+        for (size_t i = 0; i < t->size; i++) {
+            *constant_slot(&grown, *pool, &(*pool)[i], contents) = i + 1;
+        }
+
+        free(t->slots);
+        *t = grown;
+    }
+
+    uint32_t* slot = constant_slot(t, *pool, &v, contents);
+
+    if (*slot == 0)
+    {
+        if (t->size > MAX_OPERAND) {
             failure("Max constants in local scope reached!");
         }
 
-        map_put(&p->constant_table, value_to_str(&v), address);
-        p->constants[address->value.to_int] = v;
+        if (t->size == t->capacity) {
+            t->capacity = t->capacity ? t->capacity * 2 : 8;
+            *pool = realloc(*pool, sizeof(Value) * t->capacity);
+        }
+
+        (*pool)[t->size] = v;
+        *slot = ++t->size;
     }
-    
-    return address->value.to_int;
+
+    return *slot - 1;
+}
+
+uint32_t pool_constant(program* p, Value v)
+{
+    return constant_put(&p->constant_table, &p->constants, v, false);
+}
+
+uint32_t register_constant(program* p, Value v)
+{
+    if (v.type == VM_STRING) {
+        uint32_t shared = constant_put(&shared_index, &shared_strings, v, true);
+        v = shared_strings[shared];
+    }
+
+    return pool_constant(p, v);
 }
 
 int16_t register_variable(program* p, const char* name, vm_scope* scope)
@@ -474,53 +1042,6 @@ int16_t dereference_variable(program* p, const char* name, vm_scope* scope)
 
 // ------------------- UTILS --------------------
 
-vm_op decode_binary_op(const char* operator)
-{
-    if (streq(operator, "+")) // arithmetic
-        return OP_ADD;
-    else if (streq(operator, "-"))
-        return OP_SUB;
-    else if (streq(operator, "*"))
-        return OP_MUL;
-    else if (streq(operator, "/"))
-        return OP_DIV;
-    else if (streq(operator, "%"))
-        return OP_MOD;
-    else if (streq(operator, "&&")) // boolean
-        return OP_AND;
-    else if (streq(operator, "||"))
-        return OP_OR;
-    else if (streq(operator, "=="))
-        return OP_EQ;
-    else if (streq(operator, "!="))
-        return OP_NE;
-    else if (streq(operator, "<"))
-        return OP_LT;
-    else if (streq(operator, "<="))
-        return OP_LE;
-    else if (streq(operator, ">"))
-        return OP_GT;
-    else if (streq(operator, ">="))
-        return OP_GE;
-    else {
-        failure("Failed to decode binary operator!");
-    }
-    return OP_NOP;
-}
-
-vm_op decode_unary_op(const char* operator)
-{
-    if (streq(operator, "+"))
-        return OP_NOP;
-    else if (streq(operator, "-"))
-        return OP_NEG;
-    else if (streq(operator, "!"))
-        return OP_NOT;
-    else
-        failure("Failed to decode unary operator!");
-    return OP_NOP;
-}
-
 #ifdef HE_DEBUG_MODE
 const char* operation_strings[] = {
     "OP_NOP      ",
@@ -549,6 +1070,7 @@ const char* operation_strings[] = {
     "OP_CALL     ",
     "OP_RET      ",
     "OP_POP      ",
+    "OP_DUP      ",
     "OP_JIF      ",
     "OP_JMP      ",
     "OP_CLOSE    ",
@@ -556,11 +1078,47 @@ const char* operation_strings[] = {
     "OP_TPUT     ",
     "OP_TGET     ",
     "OP_TREM     ",
+    "OP_ADDI     ",
+    "OP_SUBI     ",
+    "OP_MULI     ",
+    "OP_DIVI     ",
+    "OP_MODI     ",
+    "OP_EQI      ",
+    "OP_NEI      ",
+    "OP_LTI      ",
+    "OP_LEI      ",
+    "OP_GTI      ",
+    "OP_GEI      ",
+    "OP_ADDF     ",
+    "OP_SUBF     ",
+    "OP_MULF     ",
+    "OP_DIVF     ",
+    "OP_LTF      ",
+    "OP_LEF      ",
+    "OP_GTF      ",
+    "OP_GEF      ",
+    "OP_GUARDI   ",
+    "OP_GUARDF   ",
+    "OP_FORPREP  ",
+    "OP_FORLOOP  ",
+    "OP_TAILCALL ",
 };
 
 const char* disassemble_program(program* p) 
 {
-    char* buf = malloc(sizeof(char) * 32 * 100);
+    size_t size = 128 * (p->length + 1);
+
+    // nested code objects are appended after the program
+    for (size_t i = 0; i < p->constant_table.size; i++)
+    {
+        Value program = p->constants[i];
+
+        if (program.type == VM_PROGRAM && program.value.to_code->p->native == NULL) {
+            size += 128 + strlen(disassemble_program(program.value.to_code->p));
+        }
+    }
+
+    char* buf = malloc(sizeof(char) * size);
     buf[0] = '\0';
 
     // disassembles instructions
@@ -576,15 +1134,14 @@ const char* disassemble_program(program* p)
 
     for (size_t i = 0; i < p->constant_table.size; i++)
     {
-        Value* index = p->constant_table.values[i];
-        Value program = p->constants[index->value.to_int];
+        Value program = p->constants[i];
 
         if (program.type == VM_PROGRAM && program.value.to_code->p->native == NULL)
         {
             strcat(buf, "\n");
             strcat(buf, value_to_str(&program));
             strcat(buf, ":\n");
-            strcat(buf, disassemble_program(p->constants[index->value.to_int].value.to_code->p));
+            strcat(buf, disassemble_program(program.value.to_code->p));
         }
     }
     
@@ -592,7 +1149,7 @@ const char* disassemble_program(program* p)
 }
 
 const char* disassemble(program* p, instruction i) {
-    char* buf = malloc(sizeof(char) * 32);
+    char* buf = malloc(sizeof(char) * 128);
 
     switch (i.stackop.op)
     {
@@ -613,16 +1170,22 @@ const char* disassemble(program* p, instruction i) {
         case OP_GE:
         case OP_RET:
         case OP_POP:
+        case OP_DUP:
         case OP_NOP:
         case OP_JIF:
         case OP_TNEW:
         case OP_TPUT:
         case OP_TGET:
         case OP_TREM:
+        case OP_ADDI: case OP_SUBI: case OP_MULI: case OP_DIVI: case OP_MODI:
+        case OP_EQI: case OP_NEI: case OP_LTI: case OP_LEI: case OP_GTI: case OP_GEI:
+        case OP_ADDF: case OP_SUBF: case OP_MULF: case OP_DIVF:
+        case OP_LTF: case OP_LEF: case OP_GTF: case OP_GEF:
             sprintf(buf, "%s", operation_strings[i.stackop.op]);
             break;
         
         case OP_CALL:
+        case OP_TAILCALL:
         case OP_CLOSE:
             sprintf(buf, "%s %u", operation_strings[i.stackop.op], i.ux.ux);
             break;
@@ -630,6 +1193,12 @@ const char* disassemble(program* p, instruction i) {
         case OP_JMP:
             sprintf(buf, "%s %i", operation_strings[i.stackop.op], i.sx.sx);
             break;
+
+        case OP_FORPREP:
+        case OP_FORLOOP:
+            sprintf(buf, "%s %u %u%s", operation_strings[i.stackop.op], FOR_COUNTER(i.ux.ux), FOR_LIMIT(i.ux.ux),
+                i.ux.ux & FOR_EXCLUSIVE ? " exclusive" : "");
+            break;
         
         case OP_PUSHK:
             Value k = p->constants[i.ux.ux];
@@ -649,6 +1218,8 @@ const char* disassemble(program* p, instruction i) {
         
         case OP_STORL:
         case OP_LOADL:
+        case OP_GUARDI:
+        case OP_GUARDF:
             const char* vname;
 
             // decodes reference name in local symbol table
@@ -680,25 +1251,15 @@ void compilererr(program* p, lxpos pos, const char* msg)
 
 void recordaddress(program* p, lxpos* pos)
 {
-    lxpos* last = p->line_address_table.values[p->line_address_table.size - 1];
+    lxpos* last = p->line_address_table.size == 0 ? NULL : p->line_address_table.values[p->line_address_table.size - 1];
 
-    if (p->line_address_table.size == 0 || strcmp(last->origin, pos->origin) || last->line_pos < pos->line_pos) {
-        char* buf = malloc(sizeof(char) * 8);
+    if (last == NULL || strcmp(last->origin, pos->origin) || last->line_pos < pos->line_pos) {
+        char* buf = malloc(sizeof(char) * 24);
         sprintf(buf, "%li", p->length);
 
-        map_put(&p->line_address_table, buf, pos);
+        // positions are rebuilt from the syntax tree so a copy is kept
+        lxpos* copy = malloc(sizeof(lxpos));
+        *copy = *pos;
+        map_put(&p->line_address_table, buf, copy);
     }
 }
-
-lxpos* getaddresspos(program* p, int pos)
-{
-    for (size_t i = p->line_address_table.size - 1; i >= 0; i--)
-    {
-        size_t pos0 = atoi(p->line_address_table.keys[i]);
-
-        if (pos0 <= pos) {
-            return p->line_address_table.values[i];
-        }
-    }
-    return NULL;
-}
\ No newline at end of file
@@ -35,6 +35,7 @@ typedef enum vm_op {
     OP_CALL,
     OP_RET,
     OP_POP,
+    OP_DUP,
     OP_JIF,
     OP_JMP,
     OP_CLOSE,
@@ -42,6 +43,30 @@ typedef enum vm_op {
     OP_TPUT,
     OP_TGET,
     OP_TREM,
+    OP_ADDI, // operations on operands known to be ints
+    OP_SUBI,
+    OP_MULI,
+    OP_DIVI,
+    OP_MODI,
+    OP_EQI,
+    OP_NEI,
+    OP_LTI,
+    OP_LEI,
+    OP_GTI,
+    OP_GEI,
+    OP_ADDF, // operations on operands known to be floats
+    OP_SUBF,
+    OP_MULF,
+    OP_DIVF,
+    OP_LTF,
+    OP_LEF,
+    OP_GTF,
+    OP_GEF,
+    OP_GUARDI, // type checks of speculated locals
+    OP_GUARDF,
+    OP_FORPREP, // counted loops over unboxed int variables
+    OP_FORLOOP,
+    OP_TAILCALL, // call in tail position reusing the frame of the caller
 } vm_op;
 
 typedef enum vm_scope {
@@ -52,46 +77,103 @@ typedef enum vm_scope {
     VM_DUPLICATE_IN_SCOPE,
 } vm_scope;
 
+// instructions are 32 bits wide, an 8-bit opcode followed by a 24-bit operand
 typedef union instruction {
     struct {
-        vm_op op;
+        vm_op op : 8;
     } stackop;
 
     struct {
-        vm_op op;
-        uint16_t ux;
+        vm_op op : 8;
+        uint32_t ux : 24;
     } ux;
     
     struct {
-        vm_op op;
-        int16_t sx;
+        vm_op op : 8;
+        int32_t sx : 24;
     } sx;
 
     uint32_t bits;
 } instruction;
 
+#define MAX_OPERAND 0xffffff
+#define MAX_JUMP 0x7fffff  // longest jump in either direction
+
+// counted loop operands pack the counter with the first of the limit and step variables,
+// loops the optimizer counts from a strict comparison stop before their limit
+#define FOR_OPERAND(counter, limit) ((uint32_t) ((counter) | ((limit) << 8)))
+#define FOR_EXCLUSIVE 0x10000
+#define FOR_COUNTER(ux) ((ux) & 0xff)
+#define FOR_LIMIT(ux) (((ux) >> 8) & 0xff)
+
+// Hash index of a constant pool, constants with the same type and bits share one entry
+typedef struct constant_index {
+    uint32_t* slots;  // index of a constant plus one, 0 for an empty slot
+    size_t mask;      // number of slots minus one
+    size_t size;      // constants in the pool
+    size_t capacity;  // constants allocated for the pool
+} constant_index;
+
 typedef struct program {
     instruction* code;
     size_t length;
+    size_t capacity; // instructions allocated for code while it is compiled
     size_t argc;
     Value* constants;
     struct program* prev;
     Value (*native)(Value[]);
+    size_t calls; // frames entered, to find functions worth compiling
+    void* jit;    // native code of a hot function
+    struct trace_anchor* anchors; // loop headers of the tracing JIT, allocated once a loop is taken
+    struct reg_code* reg; // code of the register VM, translated on the first run
 
     map symbol_table;
-    map constant_table;
+    constant_index constant_table;
     map closure_table;
     map line_address_table;
+    map source_table;
 } program;
 
+/**
+ * @brief Program constructor allocates an empty program with no code
+ *      or constants, nested in the scope of a parent program.
+ * 
+ * @param prev Parent program, NULL for global scope
+ * @return Pointer to program
+ */
+program* program_new(program* prev);
+
+/**
+ * @brief Appends an instruction to the code of a program, growing the
+ *      code as it fills up.
+ *
+ * @param p Reference to program
+ * @param op Operation code
+ * @param operand Operand of the instruction, 0 if it takes none
+ * @return Address of the instruction
+ */
+size_t push_instruction(program* p, vm_op op, int32_t operand);
+
+/**
+ * @brief Points the jump at an address to a target, raising a compile
+ *      error if the target is out of reach of the operand.
+ *
+ * @param p Reference to program
+ * @param pos Source position blamed for a jump which is too long
+ * @param address Address of the jump
+ * @param target Address of the instruction jumped to
+ */
+void patch_jump(program* p, lxpos pos, size_t address, size_t target);
+
 /**
  * @brief Compiles block of statements into bytecode and stores
  *      it into program.
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param block Statement block node
  */
-void compile(program* p, astnode* block);
+void compile(program* p, ast* t, astref block);
 
 /**
  * @brief Determines nature of statement and compiles it into
@@ -99,18 +181,20 @@ void compile(program* p, astnode* block);
  *      function calls, return statements.
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param statement Statement node
  */
-void compile_statement(program* p, astnode* statement);
+void compile_statement(program* p, ast* t, astref statement);
 
 /**
  * @brief Compiles variable-value assignment into byte code and
  *      stores in program.
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param s Assignment statement node
  */
-void compile_assignment(program* p, astnode* s);
+void compile_assignment(program* p, ast* t, astref s);
 
 /**
  * @brief Compiles expression nodes into byte code - including:
@@ -118,18 +202,20 @@ void compile_assignment(program* p, astnode* s);
  *      unary and binary expressions.
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param expression Expression node
  */
-void compile_expression(program* p, astnode* expression);
+void compile_expression(program* p, ast* t, astref expression);
 
 /**
  * @brief Compiles function call and argument expressions into 
  *      bytecode.
  * 
  * @param p Reference to program 
+ * @param t Syntax tree being compiled
  * @param call Function call node
  */
-void compile_call(program* p, astnode* call);
+void compile_call(program* p, ast* t, astref call);
 
 /**
  * @brief Compiles function definition, creates a new program
@@ -137,52 +223,147 @@ void compile_call(program* p, astnode* call);
  *      program will be stored as a constant in local scope. 
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param function Function definition node
  */
-void compile_function(program* p, astnode* function);
+void compile_function(program* p, ast* t, astref function);
 
 /**
  * @brief Compiles loop control structure
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param loop Loop block node
  */
-void compile_loop(program* p, astnode* loop);
+void compile_loop(program* p, ast* t, astref loop);
+
+/**
+ * @brief Compiles numeric for loop into a FORPREP and FORLOOP pair.
+ *      The counter is a variable of the current scope, assigned the
+ *      start before the limit and step are evaluated once. Both are
+ *      stored in hidden variables and the limit is inclusive. The body
+ *      may assign the counter, which must remain an int.
+ * 
+ * @param p Reference to program
+ * @param t Syntax tree being compiled
+ * @param loop For loop node
+ */
+void compile_for(program* p, ast* t, astref loop);
 
 /**
  * @brief Compiles if-else_if_else control flow block into intermediate
  *      assembly.
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param branches Branching nodes
  */
-void compile_branches(program* p, astnode* branches);
+void compile_branches(program* p, ast* t, astref branches);
 
 /**
  * @brief Compiles a table declaration and initial entries into intermediate
  *      bytecode assembly.
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param table Table node
  */
-void compile_table(program* p, astnode* table);
+void compile_table(program* p, ast* t, astref table);
 
 /**
  * @brief Compiles a table key-value insertion into intermediate bytecode
  *      assembly.
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param put Table put node
  */
-void compile_table_put(program* p, astnode* put);
+void compile_table_put(program* p, ast* t, astref put);
 
 /**
  * @brief Compiles a table key-fetch into intermediate bytecode assembly.
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param put Table get node
  */
-void compile_table_get(program* p, astnode* get);
+void compile_table_get(program* p, ast* t, astref get);
+
+/**
+ * @brief Evaluates an expression whose operands are all literals at
+ *      compile time using the VM's own operator semantics. Expressions
+ *      which would raise a runtime error are left to the VM.
+ *
+ * @param t Syntax tree being compiled
+ * @param expression Expression node
+ * @param out Folded value output
+ * @return True if expression was folded
+ */
+boolean fold_constant(ast* t, astref expression, Value* out);
+
+/**
+ * @brief Infers the type an expression is guaranteed to evaluate to
+ *      without running it. Only numeric and boolean types are tracked.
+ *
+ * @param t Syntax tree being compiled
+ * @param expression Expression node
+ * @return VM_INT, VM_FLOAT or VM_BOOL, VM_NULL if type is unknown
+ */
+vm_type static_type(ast* t, astref expression);
+
+/**
+ * @brief Checks whether an operation with a constant operand returns its
+ *      other operand unchanged, as x * 1 and x + 0 do, for every value
+ *      of the type of that operand.
+ *
+ * @param op Binary operation
+ * @param type Type of the other operand, VM_NULL if it is unknown
+ * @param c Constant operand
+ * @param right Whether the constant is the right operand
+ * @return True if the operation can be replaced by the other operand
+ */
+boolean is_identity(vm_op op, vm_type type, Value c, boolean right);
+
+/**
+ * @brief Applies algebraic identities such as x * 1 and x + 0 to a
+ *      binary expression. Identities are only used when the static type
+ *      of the other operand guarantees the result is unchanged, variables
+ *      are left to the IR once their types are inferred.
+ *
+ * @param t Syntax tree being compiled
+ * @param expression Binary expression node
+ * @return Operand the expression reduces to, ASTREF_NONE otherwise
+ */
+astref identity_operand(ast* t, astref expression);
+
+/**
+ * @brief Joins consecutive string literals appended to a concatenation
+ *      chain so that x + "a" + "b" allocates a single string at runtime.
+ *
+ * @param t Syntax tree being compiled
+ * @param expression Binary expression node
+ * @param out Joined string literal output
+ * @return Remaining operand, ASTREF_NONE if nothing was joined
+ */
+astref fold_concatenation(ast* t, astref expression, Value* out);
+
+/**
+ * @brief Coerces abstract syntax node into Value object.
+ * 
+ * @param t Reference to syntax tree
+ * @param node Abstract syntax node
+ * @return Value
+ */
+Value value_from_node(ast* t, astref node);
+
+/**
+ * @brief Registers all native, in-built methods to the specified
+ *      program's local scope. These methods will be available in
+ *      the local symbol table and can be called by child methods
+ * 
+ * @param p Program scope
+ */
+void register_all_natives(program* p);
 
 /**
  * @brief Registers native method with C-wrapper as an accessible symbol to program
@@ -200,9 +381,10 @@ void create_native(program* p, const char* name, Value (*f)(Value[]), int argc);
  *      within current program.
  * 
  * @param p Reference to program
+ * @param t Syntax tree being compiled
  * @param filepath String node with path to file
  */
-void run_import(program* p, astnode* filepath);
+void run_import(program* p, ast* t, astref filepath);
 
 /**
  * @brief Prints error message into standard error output and
@@ -215,15 +397,28 @@ void run_import(program* p, astnode* filepath);
 void compilererr(program* p, lxpos pos, const char* msg);
 
 /**
- * @brief Registers constant value in local scope and stores value
- *      string in program's constant table. Method returns the address
- *      of constant (index) in constant stack.
+ * @brief Registers constant value in local scope, reusing an equal
+ *      constant already in the pool. Strings are first looked up in a
+ *      section shared by every program of the module, so equal strings
+ *      share their storage and pools compare them by pointer. Method
+ *      returns the address of constant (index) in constant stack.
  * 
  * @param p Reference to program
  * @param v Value to register
  * @return Address
  */
-uint16_t register_constant(program* p, Value v);
+uint32_t register_constant(program* p, Value v);
+
+/**
+ * @brief Adds a constant to the pool of a program unless one with the
+ *      same type and bits is already in it, growing the pool as it
+ *      fills up. Strings are not shared with other programs.
+ *
+ * @param p Reference to program
+ * @param v Value to add
+ * @return Address
+ */
+uint32_t pool_constant(program* p, Value v);
 
 /**
  * @brief Registers variable symbol and returns the address within
@@ -290,14 +485,4 @@ const char* disassemble(program* p, instruction i);
  */
 void recordaddress(program* p, lxpos* pos);
 
-/**
- * @brief Retrieves the position in source file using the index
- *      of bytecode instruction in provided program.
- * 
- * @param p Reference to program
- * @param pos Instruction position
- * @return Source position
- */
-lxpos* getaddresspos(program* p, int pos);
-
 #endif
\ No newline at end of file
@@ -6,7 +6,15 @@
 #include "lex.h"
 #include "parser.h"
 #include "compiler.h"
+#include "optimizer.h"
+#include "ir.h"
 #include "vm.h"
+#include "jit.h"
+#include "stencil.h"
+#include "regvm.h"
+#include "tier.h"
 #include "lib.h"
+#include "cache.h"
+#include "aot.h"
 
 #endif
\ No newline at end of file
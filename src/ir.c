@@ -0,0 +1,2516 @@
+#include "ir.h"
+
+// integer and float specializations of generic operations
+vm_op int_op_map[] = {
+    [OP_ADD] = OP_ADDI, [OP_SUB] = OP_SUBI, [OP_MUL] = OP_MULI, [OP_DIV] = OP_DIVI, [OP_MOD] = OP_MODI,
+    [OP_EQ] = OP_EQI, [OP_NE] = OP_NEI, [OP_LT] = OP_LTI, [OP_LE] = OP_LEI, [OP_GT] = OP_GTI, [OP_GE] = OP_GEI,
+};
+
+vm_op float_op_map[] = {
+    [OP_ADD] = OP_ADDF, [OP_SUB] = OP_SUBF, [OP_MUL] = OP_MULF, [OP_DIV] = OP_DIVF,
+    [OP_LT] = OP_LTF, [OP_LE] = OP_LEF, [OP_GT] = OP_GTF, [OP_GE] = OP_GEF,
+};
+
+// value number of an expression computed from its operation and operands
+typedef struct ir_value {
+    instruction i;
+    int32_t args[2];
+} ir_value;
+
+// values numbered in a block, with a hash index of the values other values can match
+typedef struct ir_numbering {
+    ir_value* values;
+    size_t size;
+    uint32_t* slots;   // index of a value plus one, 0 for an empty slot
+    size_t mask;       // number of slots minus one
+    int32_t* versions; // value that last assigned each variable
+    int32_t call;      // value of the last call, which may have assigned any global or closed value
+} ir_numbering;
+
+// line addresses of the lowered code, replacing the line table of the program
+typedef struct ir_lines {
+    size_t* addresses;
+    lxpos** positions;
+    size_t size;
+    size_t capacity;
+    lxpos* last; // position of the previous instruction
+} ir_lines;
+
+// ------------------- LIFTING ------------------
+
+boolean ir_lift(program* p, ir_function* f)
+{
+    // lowering may double the code, its jumps must stay within reach of their operands
+    if (p->length > MAX_JUMP / 4) {
+        return false;
+    }
+
+    *f = (ir_function) {
+        .p = p,
+        .nodes = NULL,
+        .size = 0,
+        .capacity = 0,
+        .graph = cfg_new(p),
+        .types = NULL,
+        .speculated = NULL,
+        .lines = malloc(sizeof(lxpos*) * (p->length + 1)),
+    };
+
+    f->blocks = calloc(f->graph.size + 1, sizeof(ir_block));
+    irref* stack = malloc(sizeof(irref) * (p->length + 1));
+
+    // positions are taken before lowering rewrites the line table
+    for (size_t i = 0, l = 0; i <= p->length; i++)
+    {
+        while (l < p->line_address_table.size && (size_t) atoi(p->line_address_table.keys[l]) <= i) l++;
+        f->lines[i] = l > 0 ? p->line_address_table.values[l - 1] : NULL;
+    }
+
+    for (size_t b = 0; b < f->graph.size; b++)
+    {
+        basic_block* block = &f->graph.blocks[b];
+        size_t depth = 0;
+        f->blocks[b].start = block->start;
+        f->blocks[b].counted = IRREF_NONE;
+
+        for (size_t i = block->start; i < block->end; i++)
+        {
+            instruction in = p->code[i];
+            uint32_t pops, pushes;
+
+            if (in.stackop.op == OP_NOP) {
+                continue;
+            }
+
+            if (!ir_stack_effect(in, &pops, &pushes) || pops > depth) {
+                free(stack);
+                ir_delete(f);
+                return false;
+            }
+
+            depth -= pops;
+            irref node = ir_node_new(f, in, pops, i);
+
+            for (uint32_t a = 0; a < pops; a++) {
+                f->nodes[node].args[a] = stack[depth + a];
+            }
+
+            // jumps refer to blocks, the block past the last one is the end of the program
+            if (in.stackop.op == OP_JMP) {
+                size_t target = jump_target(p, i);
+                f->nodes[node].target = target < p->length ? f->graph.block_of[target] : f->graph.size;
+            }
+
+            if (pushes > 0) {
+                stack[depth++] = node;
+                continue;
+            }
+
+            // values left below a statement cannot be expressed as trees
+            if (depth > 0) {
+                free(stack);
+                ir_delete(f);
+                return false;
+            }
+
+            ir_block_append(&f->blocks[b], node);
+        }
+
+        if (depth > 0) {
+            free(stack);
+            ir_delete(f);
+            return false;
+        }
+    }
+
+    free(stack);
+    return true;
+}
+
+boolean ir_stack_effect(instruction i, uint32_t* pops, uint32_t* pushes)
+{
+    switch (i.stackop.op)
+    {
+        case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV: case OP_MOD:
+        case OP_AND: case OP_OR: case OP_EQ: case OP_NE:
+        case OP_LT: case OP_LE: case OP_GT: case OP_GE:
+        case OP_TGET:
+            *pops = 2; *pushes = 1;
+            return true;
+
+        case OP_NEG: case OP_NOT:
+            *pops = 1; *pushes = 1;
+            return true;
+
+        case OP_PUSHK: case OP_LOADG: case OP_LOADL: case OP_LOADC: case OP_TNEW:
+            *pops = 0; *pushes = 1;
+            return true;
+
+        case OP_STORG: case OP_STORL: case OP_STORC:
+        case OP_POP: case OP_RET: case OP_JIF:
+            *pops = 1; *pushes = 0;
+            return true;
+
+        case OP_JMP: case OP_FORLOOP:
+            *pops = 0; *pushes = 0;
+            return true;
+
+        case OP_FORPREP:
+            *pops = 2; *pushes = 0;
+            return true;
+
+        case OP_CALL: case OP_TAILCALL: case OP_CLOSE:
+            *pops = i.ux.ux + 1; *pushes = 1;
+            return true;
+
+        case OP_TPUT:
+            *pops = 3; *pushes = 1;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+// ------------------- LOWERING -----------------
+
+static void ir_mark_line(ir_lines* lines, size_t address, lxpos* pos)
+{
+    if (lines->size >= lines->capacity) {
+        lines->capacity = lines->capacity ? lines->capacity * 2 : 16;
+        lines->addresses = realloc(lines->addresses, sizeof(size_t) * lines->capacity);
+        lines->positions = realloc(lines->positions, sizeof(lxpos*) * lines->capacity);
+    }
+
+    lines->addresses[lines->size] = address;
+    lines->positions[lines->size++] = pos;
+}
+
+// operand an identity such as x * 1 reduces a typed operation to, IRREF_NONE if there is none
+static irref ir_identity(ir_function* f, irref n)
+{
+    ir_node* node = &f->nodes[n];
+
+    if (node->argc != 2 || node->keep) {
+        return IRREF_NONE;
+    }
+
+    for (uint32_t a = 0; a < 2; a++)
+    {
+        ir_node* k = &f->nodes[node->args[1 - a]];
+
+        if (k->i.stackop.op == OP_PUSHK && !k->keep &&
+            is_identity(node->i.stackop.op, f->types[node->args[a]], f->p->constants[k->i.ux.ux], a == 0)) {
+            return node->args[a];
+        }
+    }
+
+    return IRREF_NONE;
+}
+
+static void ir_emit(ir_function* f, irref n, boolean typed, instruction* code, size_t* length, size_t* index, ir_lines* lines)
+{
+    ir_node* node = &f->nodes[n];
+    instruction i = node->i;
+    irref operand = typed ? ir_identity(f, n) : IRREF_NONE;
+
+    if (index != NULL && index[node->pc] == CFG_EXIT) {
+        index[node->pc] = *length;
+    }
+
+    // types are only known in the typed copy, where guards have checked them
+    if (operand != IRREF_NONE) {
+        ir_emit(f, operand, typed, code, length, index, lines);
+        return;
+    }
+
+    for (uint32_t a = 0; a < node->argc; a++) {
+        ir_emit(f, node->args[a], typed, code, length, index, lines);
+    }
+
+    // inlined code and the code resuming after it start new line addresses
+    if (node->pos != NULL && node->pos != lines->last) {
+        ir_mark_line(lines, *length, node->pos);
+        lines->last = node->pos;
+    }
+
+    if (node->keep) {
+        code[*length].ux.op = OP_DUP;
+        code[*length].ux.ux = 0;
+        (*length)++;
+    }
+
+    if (typed && node->argc == 2) {
+        vm_op op = typed_operation(i.stackop.op, f->types[node->args[0]], f->types[node->args[1]]);
+        if (op != OP_NOP) i.stackop.op = op;
+    }
+
+    code[(*length)++] = i;
+}
+
+static void ir_emit_guard(int16_t local, vm_type type, instruction* code, size_t* length)
+{
+    code[*length].sx.op = type == VM_INT ? OP_GUARDI : OP_GUARDF;
+    code[*length].sx.sx = local;
+    (*length)++;
+
+    // jump offset is patched once the generic copy is laid out
+    code[*length].sx.op = OP_JMP;
+    code[*length].sx.sx = 0;
+    (*length)++;
+}
+
+static void ir_emit_counted(ir_function* f, irref counted, instruction* code, size_t* length, size_t* index, ir_lines* lines)
+{
+    ir_emit(f, counted, true, code, length, index, lines);
+
+    // the jump back into the body is patched like the jump it replaces
+    if (f->nodes[counted].i.stackop.op == OP_FORLOOP) {
+        code[*length].sx.op = OP_JMP;
+        code[*length].sx.sx = 0;
+        (*length)++;
+    }
+}
+
+// lays out one copy of the function, roots holds the position of each statement
+static void ir_emit_copy(ir_function* f, boolean typed, instruction* code, size_t* length, size_t* starts,
+    size_t* roots, size_t* index, ir_lines* lines, size_t* guards, size_t* nguards)
+{
+    lines->last = NULL;
+
+    for (size_t b = 0, root = 0; b < f->graph.size; b++)
+    {
+        irref counted = typed ? f->blocks[b].counted : IRREF_NONE;
+        size_t replaced = counted == IRREF_NONE ? 0 : f->nodes[counted].i.stackop.op == OP_FORPREP ? 1 : 2;
+        starts[b] = *length;
+
+        for (size_t r = 0; r < f->blocks[b].size; r++)
+        {
+            ir_node* node = &f->nodes[f->blocks[b].roots[r]];
+            roots[root++] = *length;
+
+            // counted loops replace the condition of the header, and the increment and jump of the latch
+            if (r + replaced >= f->blocks[b].size) {
+                if (r + 1 == f->blocks[b].size) ir_emit_counted(f, counted, code, length, index, lines);
+                continue;
+            }
+
+            // hoisted code keeps the source lines of the loop body
+            ir_emit(f, f->blocks[b].roots[r], typed, code, length, f->blocks[b].preheader ? NULL : index, lines);
+
+            // a failed guard continues after the store in the generic copy
+            if (typed && node->guard != VM_NULL) {
+                ir_emit_guard(node->i.sx.sx, node->guard, code, length);
+                guards[(*nguards)++] = *length - 1;
+                guards[(*nguards)++] = root;
+            }
+        }
+
+        roots[root++] = *length;
+    }
+
+    starts[f->graph.size] = *length;
+}
+
+// every lowered node carries its position, so the lines marked while emitting replace the table
+static void ir_store_lines(program* p, ir_lines* lines)
+{
+    map table = map_new(2 * lines->size + 1);
+
+    for (size_t l = 0; l < lines->size; l++)
+    {
+        char* buf = malloc(sizeof(char) * 24);
+        sprintf(buf, "%li", lines->addresses[l]);
+        map_put(&table, buf, lines->positions[l]);
+    }
+
+    free(p->line_address_table.keys);
+    free(p->line_address_table.values);
+    p->line_address_table = table;
+}
+
+void ir_lower(ir_function* f)
+{
+    program* p = f->p;
+    boolean typed = f->types != NULL;
+    boolean speculative = typed && f->speculated != NULL;
+    size_t length = 0, nroots = 0, nguards = 0, guarded = 0;
+
+    for (size_t b = 0; b < f->graph.size; b++)
+    {
+        nroots += f->blocks[b].size + 1;
+
+        for (size_t r = 0; r < f->blocks[b].size; r++) {
+            length += ir_size(f, f->blocks[b].roots[r]);
+            guarded += f->nodes[f->blocks[b].roots[r]].guard != VM_NULL;
+        }
+
+        if (typed && f->blocks[b].counted != IRREF_NONE) {
+            length += ir_size(f, f->blocks[b].counted) + 1;
+        }
+    }
+
+    if (speculative) {
+        length = 2 * length + 2 * (guarded + p->argc);
+    }
+
+    if (length > p->length) {
+        p->code = realloc(p->code, sizeof(instruction) * length);
+        p->capacity = length;
+    }
+
+    instruction* code = malloc(sizeof(instruction) * (length + 1));
+    size_t* starts = malloc(sizeof(size_t) * (f->graph.size + 1));
+    size_t* generic_starts = malloc(sizeof(size_t) * (f->graph.size + 1));
+    size_t* roots = malloc(sizeof(size_t) * (nroots + 1));
+    size_t* generic_roots = malloc(sizeof(size_t) * (nroots + 1));
+    size_t* guards = malloc(sizeof(size_t) * 2 * (guarded + p->argc + 1));
+    size_t* index = malloc(sizeof(size_t) * (p->length + 1));
+    size_t* generic_index = malloc(sizeof(size_t) * (p->length + 1));
+    ir_lines lines = { .addresses = NULL, .positions = NULL, .size = 0, .capacity = 0 };
+    length = 0;
+
+    for (size_t i = 0; i <= p->length; i++) {
+        index[i] = generic_index[i] = CFG_EXIT;
+    }
+
+    // speculated parameters are checked once on entry
+    for (size_t a = 0; speculative && a < p->argc; a++)
+    {
+        if (f->speculated[a] != VM_NULL) {
+            ir_emit_guard(a, f->speculated[a], code, &length);
+            guards[nguards++] = length - 1;
+            guards[nguards++] = 0;
+        }
+    }
+
+    // blocks keep their order so fall-through edges are preserved
+    ir_emit_copy(f, typed, code, &length, starts, roots, index, &lines, guards, &nguards);
+
+    if (speculative) {
+        ir_emit_copy(f, false, code, &length, generic_starts, generic_roots, generic_index, &lines, guards, &nguards);
+    }
+
+    for (size_t copy = 0; copy < 1 + speculative; copy++)
+    {
+        size_t* s = copy == 0 ? starts : generic_starts;
+
+        for (size_t b = 0; b < f->graph.size; b++)
+        {
+            if (f->blocks[b].size == 0) {
+                continue;
+            }
+
+            ir_node* last = &f->nodes[f->blocks[b].roots[f->blocks[b].size - 1]];
+            irref counted = copy == 0 && typed ? f->blocks[b].counted : IRREF_NONE;
+            size_t i = s[b + 1] - 1;
+
+            // the latch of a counted loop jumps back past the condition
+            if (counted != IRREF_NONE && f->nodes[counted].i.stackop.op == OP_FORLOOP) {
+                last = &f->nodes[counted];
+            }
+
+            if (last->i.stackop.op == OP_JMP || (counted != IRREF_NONE && last == &f->nodes[counted])) {
+                size_t target = last->target < f->graph.size ? s[last->target] : length;
+                code[i].sx.sx = target - i - 1;
+            }
+        }
+    }
+
+    for (size_t g = 0; g < nguards; g += 2) {
+        code[guards[g]].sx.sx = generic_roots[guards[g + 1]] - guards[g] - 1;
+    }
+
+    index[p->length] = speculative ? generic_starts[0] : length;
+    generic_index[p->length] = length;
+
+    // instructions which were removed map to the one following them
+    for (size_t i = p->length; i-- > 0;)
+    {
+        if (index[i] == CFG_EXIT) index[i] = index[i + 1];
+        if (generic_index[i] == CFG_EXIT) generic_index[i] = generic_index[i + 1];
+    }
+
+    memcpy(p->code, code, sizeof(instruction) * length);
+
+    // code without a known position keeps the lines of the instructions it replaced
+    if (lines.size > 0) {
+        ir_store_lines(p, &lines);
+    } else {
+        remap_line_addresses(p, index, speculative ? generic_index : NULL);
+    }
+
+    p->length = length;
+
+    free(code);
+    free(starts);
+    free(generic_starts);
+    free(roots);
+    free(generic_roots);
+    free(guards);
+    free(index);
+    free(generic_index);
+    free(lines.addresses);
+    free(lines.positions);
+}
+
+// ------------------- IR METHODS ---------------
+
+int32_t ir_temporary(ir_function* f, const char* prefix)
+{
+    program* p = f->p;
+
+    if (p->symbol_table.size >= MAX_LOCAL_VARIABLES) {
+        return IRREF_NONE;
+    }
+
+    // names cannot clash with identifiers of the language
+    char* name = malloc(sizeof(char) * (strlen(prefix) + 24));
+    Value* address = malloc(sizeof(Value));
+    sprintf(name, "$%s%li", prefix, p->symbol_table.size);
+    *address = vInt(p->symbol_table.size);
+    map_put(&p->symbol_table, name, address);
+    return address->value.to_int;
+}
+
+void ir_insert_preheader(ir_function* f, size_t header, boolean* loop)
+{
+    size_t size = f->graph.size;
+
+    f->blocks = realloc(f->blocks, sizeof(ir_block) * (size + 2));
+    f->graph.blocks = realloc(f->graph.blocks, sizeof(basic_block) * (size + 2));
+
+    // jump targets and successors after the header move one block down
+    for (size_t b = 0; b < size; b++)
+    {
+        basic_block* block = &f->graph.blocks[b];
+
+        for (size_t s = 0; s < block->nsuccessors; s++)
+        {
+            size_t succ = block->successors[s];
+
+            if (succ != CFG_EXIT && succ >= header && (succ != header || loop[b])) {
+                block->successors[s] = succ + 1;
+            }
+        }
+
+        ir_node* last = f->blocks[b].size > 0 ? &f->nodes[f->blocks[b].roots[f->blocks[b].size - 1]] : NULL;
+
+        if (last != NULL && last->i.stackop.op == OP_JMP && last->target >= (int32_t) header &&
+            (last->target != (int32_t) header || loop[b])) {
+            last->target++;
+        }
+    }
+
+    memmove(&f->blocks[header + 1], &f->blocks[header], sizeof(ir_block) * (size - header));
+    memmove(&f->graph.blocks[header + 1], &f->graph.blocks[header], sizeof(basic_block) * (size - header));
+
+    f->blocks[header] = (ir_block) {
+        .roots = NULL,
+        .size = 0,
+        .capacity = 0,
+        .start = f->blocks[header + 1].start,
+        .preheader = true,
+        .counted = IRREF_NONE,
+    };
+
+    f->graph.blocks[header] = (basic_block) {
+        .start = f->graph.blocks[header + 1].start,
+        .end = f->graph.blocks[header + 1].start,
+        .successors = { header + 1 },
+        .nsuccessors = 1,
+        .reachable = f->graph.blocks[header + 1].reachable,
+    };
+
+    f->graph.size++;
+}
+
+void ir_delete(ir_function* f)
+{
+    for (size_t n = 0; n < f->size; n++) {
+        free(f->nodes[n].args);
+    }
+
+    for (size_t b = 0; b < f->graph.size; b++) {
+        free(f->blocks[b].roots);
+    }
+
+    free(f->nodes);
+    free(f->blocks);
+    free(f->types);
+    free(f->speculated);
+    free(f->lines);
+    cfg_delete(&f->graph);
+    f->nodes = NULL;
+    f->blocks = NULL;
+    f->size = 0;
+}
+
+irref ir_node_new(ir_function* f, instruction i, uint32_t argc, uint32_t pc)
+{
+    if (f->size >= f->capacity) {
+        f->capacity = f->capacity ? f->capacity * 2 : 64;
+        f->nodes = realloc(f->nodes, sizeof(ir_node) * f->capacity);
+    }
+
+    f->nodes[f->size] = (ir_node) {
+        .i = i,
+        .args = calloc(argc + 1, sizeof(irref)),
+        .argc = argc,
+        .pc = pc,
+        .target = IRREF_NONE,
+        .keep = false,
+        .guard = VM_NULL,
+        .pos = pc <= f->p->length ? f->lines[pc] : NULL,
+    };
+
+    return f->size++;
+}
+
+void ir_block_append(ir_block* b, irref node)
+{
+    if (b->size >= b->capacity) {
+        b->capacity = b->capacity ? b->capacity * 2 : 8;
+        b->roots = realloc(b->roots, sizeof(irref) * b->capacity);
+    }
+
+    b->roots[b->size++] = node;
+}
+
+boolean ir_effect_free(ir_function* f, irref node)
+{
+    ir_node* n = &f->nodes[node];
+
+    switch (n->i.stackop.op)
+    {
+        case OP_PUSHK: case OP_LOADG: case OP_LOADL: case OP_LOADC:
+        case OP_TNEW: case OP_CLOSE:
+            break;
+
+        default:
+            return false;
+    }
+
+    for (uint32_t a = 0; a < n->argc; a++) {
+        if (!ir_effect_free(f, n->args[a])) return false;
+    }
+
+    return !n->keep;
+}
+
+size_t ir_size(ir_function* f, irref node)
+{
+    size_t size = 1 + f->nodes[node].keep;
+
+    for (uint32_t a = 0; a < f->nodes[node].argc; a++) {
+        size += ir_size(f, f->nodes[node].args[a]);
+    }
+
+    return size;
+}
+
+uint32_t ir_first_pc(ir_function* f, irref node)
+{
+    // arguments are evaluated first, the leftmost leaf starts the tree
+    while (f->nodes[node].argc > 0) {
+        node = f->nodes[node].args[0];
+    }
+
+    return f->nodes[node].pc;
+}
+
+// ------------------- IR PASSES ----------------
+
+// variables are numbered locals first, then globals, then closed values
+static size_t ir_variable(ir_function* f, instruction i)
+{
+    size_t nlocals = f->p->prev != NULL ? f->p->symbol_table.size : 0;
+    program* global = f->p;
+
+    while (global->prev != NULL) {
+        global = global->prev;
+    }
+
+    switch (i.stackop.op)
+    {
+        case OP_LOADL: case OP_STORL:
+            return i.ux.ux;
+
+        case OP_LOADG: case OP_STORG:
+            return nlocals + i.ux.ux;
+
+        case OP_LOADC: case OP_STORC:
+            return nlocals + global->symbol_table.size + i.ux.ux;
+
+        // counted loops read their counter, which FORLOOP also assigns
+        case OP_FORPREP: case OP_FORLOOP:
+            return FOR_COUNTER(i.ux.ux);
+
+        default:
+            return CFG_EXIT;
+    }
+}
+
+static size_t ir_variable_count(ir_function* f)
+{
+    instruction last = { .ux = { .op = OP_LOADC, .ux = f->p->closure_table.size } };
+    return ir_variable(f, last);
+}
+
+static boolean same_instruction(instruction a, instruction b)
+{
+    return a.ux.op == b.ux.op && a.ux.ux == b.ux.ux;
+}
+
+// assignments to globals anywhere in the program, used to resolve the functions calls refer to
+typedef struct ir_globals {
+    program* global;
+    size_t* stores;   // stores to each global
+    size_t size;      // number of globals counted
+    size_t entry;     // end of the entry block of the global program
+} ir_globals;
+
+// counts the stores to every global in a program and the functions nested in it
+static void count_global_stores(program* p, size_t* stores)
+{
+    for (size_t i = 0; i < p->length; i++)
+    {
+        if (p->code[i].stackop.op == OP_STORG) {
+            stores[p->code[i].ux.ux]++;
+        }
+    }
+
+    for (size_t k = 0; k < p->constant_table.size; k++)
+    {
+        Value* v = &p->constants[k];
+
+        if (v->type == VM_PROGRAM && v->value.to_code->p->native == NULL) {
+            count_global_stores(v->value.to_code->p, stores);
+        }
+    }
+}
+
+static void ir_globals_new(ir_function* f, ir_globals* g)
+{
+    g->global = f->p;
+
+    while (g->global->prev != NULL) {
+        g->global = g->global->prev;
+    }
+
+    g->size = g->global->symbol_table.size;
+    g->stores = calloc(g->size + 1, sizeof(size_t));
+    count_global_stores(g->global, g->stores);
+
+    cfg graph = cfg_new(g->global);
+    g->entry = graph.size > 0 ? graph.blocks[0].end : 0;
+    cfg_delete(&graph);
+}
+
+// finds where a global assigned only once is defined, the entry block runs before any other code
+static size_t global_definition(ir_globals* g, uint16_t address)
+{
+    program* global = g->global;
+
+    if (address >= g->size || g->stores[address] != 1) {
+        return CFG_EXIT;
+    }
+
+    for (size_t i = 1; i < g->entry; i++)
+    {
+        if (global->code[i].stackop.op == OP_STORG && global->code[i].ux.ux == address &&
+            global->code[i - 1].stackop.op == OP_PUSHK) {
+            return i;
+        }
+    }
+
+    return CFG_EXIT;
+}
+
+// resolves the constant code object a callee evaluates to
+static Value* constant_callee(ir_function* f, irref callee, ir_globals* g)
+{
+    ir_node* node = &f->nodes[callee];
+    Value* k = NULL;
+    size_t definition;
+
+    if (node->i.stackop.op == OP_PUSHK) {
+        k = &f->p->constants[node->i.ux.ux];
+    }
+
+    if (node->i.stackop.op == OP_LOADG && (definition = global_definition(g, node->i.ux.ux)) != CFG_EXIT) {
+        k = &g->global->constants[g->global->code[definition - 1].ux.ux];
+    }
+
+    return k != NULL && k->type == VM_PROGRAM ? k : NULL;
+}
+
+static const native_method* native_callee(ir_function* f, irref callee, ir_globals* g)
+{
+    Value* k = constant_callee(f, callee, g);
+
+    if (k == NULL || k->value.to_code->p->native == NULL) {
+        return NULL;
+    }
+
+    return find_native(NULL, k->value.to_code->p->native);
+}
+
+// a function can only run once the global program pushed its code object
+static boolean defined_before(ir_function* f, ir_globals* g, uint16_t callee, uint32_t pc)
+{
+    size_t definition = global_definition(g, callee);
+    program* global = g->global;
+
+    if (definition == CFG_EXIT) {
+        return false;
+    }
+
+    if (f->p == global) {
+        return pc >= g->entry || definition < pc;
+    }
+
+    for (size_t i = 0; i < global->length; i++)
+    {
+        instruction in = global->code[i];
+
+        if (in.stackop.op == OP_PUSHK && global->constants[in.ux.ux].type == VM_PROGRAM &&
+            global->constants[in.ux.ux].value.to_code->p == f->p) {
+            return i < g->entry && definition < i;
+        }
+    }
+
+    return false;
+}
+
+static boolean inlinable_tree(ir_function* body, irref n, ir_globals* g)
+{
+    ir_node* node = &body->nodes[n];
+    Value* k;
+
+    for (uint32_t a = 0; a < node->argc; a++) {
+        if (!inlinable_tree(body, node->args[a], g)) return false;
+    }
+
+    switch (node->i.stackop.op)
+    {
+        case OP_LOADC: case OP_STORC: case OP_CLOSE: case OP_JMP: case OP_JIF:
+            return false;
+
+        // further calls would let recursive functions grow without bound
+        case OP_CALL: case OP_TAILCALL:
+            return native_callee(body, node->args[node->argc - 1], g) != NULL;
+
+        // constants are registered in the caller, nested functions are not
+        case OP_PUSHK:
+            k = &body->p->constants[node->i.ux.ux];
+            return k->type != VM_PROGRAM || k->value.to_code->p->native != NULL;
+
+        default:
+            return true;
+    }
+}
+
+// lifts the body of the function a call refers to if it can be inlined
+static boolean inline_callee(ir_function* f, irref call, ir_globals* g, ir_function* body)
+{
+    ir_node* node = &f->nodes[call];
+    irref callee = node->args[node->argc - 1];
+    Value* k = constant_callee(f, callee, g);
+    size_t size = 0;
+    boolean valid;
+
+    if (k == NULL || k->value.to_code->closure != NULL) {
+        return false;
+    }
+
+    program* q = k->value.to_code->p;
+
+    if (q->native != NULL || q == f->p || q->closure_table.size > 0 || q->line_address_table.size == 0 || node->i.ux.ux != q->argc) {
+        return false;
+    }
+
+    if (f->nodes[callee].i.stackop.op == OP_LOADG && !defined_before(f, g, f->nodes[callee].i.ux.ux, node->pc)) {
+        return false;
+    }
+
+    // locals and constants of the callee are added to the caller
+    if (f->p->symbol_table.size + q->symbol_table.size >= MAX_LOCAL_VARIABLES ||
+        f->p->constant_table.size + q->constant_table.size > MAX_OPERAND || !ir_lift(q, body)) {
+        return false;
+    }
+
+    ir_block* block = &body->blocks[0];
+    valid = body->graph.size > 0 && block->size > 0 && body->nodes[block->roots[block->size - 1]].i.stackop.op == OP_RET;
+
+    for (size_t r = 0; r < block->size && valid; r++) {
+        size += ir_size(body, block->roots[r]);
+        valid = inlinable_tree(body, block->roots[r], g);
+    }
+
+    if (!valid || size > IR_INLINE_SIZE) {
+        ir_delete(body);
+        return false;
+    }
+
+    return true;
+}
+
+// finds the first call to inline in evaluation order, code evaluated before
+// it is moved after the inlined body so it may only read constants and locals
+static irref* find_inline_call(ir_function* f, irref* slot, ir_globals* g, boolean* clean, ir_function* body)
+{
+    ir_node* node = &f->nodes[*slot];
+    vm_op op = node->i.stackop.op;
+    boolean before = *clean;
+
+    for (uint32_t a = 0; a < node->argc; a++)
+    {
+        irref* found = find_inline_call(f, &f->nodes[*slot].args[a], g, clean, body);
+
+        if (found != NULL) {
+            return found;
+        }
+    }
+
+    if (before && (op == OP_CALL || op == OP_TAILCALL) && inline_callee(f, *slot, g, body)) {
+        return slot;
+    }
+
+    *clean = *clean && (op == OP_PUSHK || op == OP_LOADL) && !node->keep;
+    return NULL;
+}
+
+// positions of inlined code are chained to the call site they were inlined into
+static lxpos* inline_position(const lxpos* pos, const lxpos* site)
+{
+    lxpos* copy = malloc(sizeof(lxpos));
+
+    *copy = *pos;
+    copy->caller = pos->caller != NULL ? inline_position(pos->caller, site) : site;
+    return copy;
+}
+
+// copies a tree of the callee, its locals are replaced by the variables of the caller
+static irref inline_tree(ir_function* f, ir_function* body, irref n, int32_t* locals, uint32_t pc, lxpos** positions)
+{
+    ir_node* node = &body->nodes[n];
+    instruction i = node->i;
+    boolean local = f->p->prev != NULL;
+
+    switch (i.stackop.op)
+    {
+        case OP_LOADL:
+            i.ux.op = local ? OP_LOADL : OP_LOADG;
+            i.ux.ux = locals[i.ux.ux];
+            break;
+
+        case OP_STORL:
+            i.ux.op = local ? OP_STORL : OP_STORG;
+            i.ux.ux = locals[i.ux.ux];
+            break;
+
+        case OP_PUSHK:
+            i.ux.ux = register_constant(f->p, body->p->constants[i.ux.ux]);
+            break;
+
+        // the returned call of the callee is no longer in tail position
+        case OP_TAILCALL:
+            i.ux.op = OP_CALL;
+            break;
+
+        default:
+            break;
+    }
+
+    irref copy = ir_node_new(f, i, node->argc, pc);
+    f->nodes[copy].pos = positions[node->pc];
+
+    for (uint32_t a = 0; a < node->argc; a++) {
+        irref arg = inline_tree(f, body, node->args[a], locals, pc, positions);
+        f->nodes[copy].args[a] = arg;
+    }
+
+    return copy;
+}
+
+// inlines the first eligible call of a statement, the statements of the body are appended to out
+static boolean inline_call(ir_function* f, irref* root, ir_globals* g, ir_block* out)
+{
+    ir_function body;
+    boolean clean = true;
+    irref* slot = find_inline_call(f, root, g, &clean, &body);
+
+    if (slot == NULL) {
+        return false;
+    }
+
+    program* q = body.p;
+    irref call = *slot;
+    uint32_t pc = f->nodes[call].pc;
+    const lxpos* site = getaddresspos(f->p, pc);
+    int32_t* locals = malloc(sizeof(int32_t) * (q->symbol_table.size + 1));
+    lxpos** positions = calloc(q->length + 1, sizeof(lxpos*));
+    ir_block* block = &body.blocks[0];
+
+    for (size_t v = 0; v < q->symbol_table.size; v++) {
+        locals[v] = ir_temporary(f, "inl");
+    }
+
+    // instructions on the same line of the callee share one position
+    for (size_t i = 0; i < q->length; i++)
+    {
+        const lxpos* pos = getaddresspos(q, i);
+        positions[i] = i > 0 && getaddresspos(q, i - 1) == pos ? positions[i - 1] : inline_position(pos, site);
+    }
+
+    // arguments are evaluated in order into the parameters
+    for (uint32_t a = 0; a < q->argc; a++)
+    {
+        instruction i = { .ux = { .op = f->p->prev != NULL ? OP_STORL : OP_STORG, .ux = locals[a] } };
+        irref stor = ir_node_new(f, i, 1, pc);
+        f->nodes[stor].args[0] = f->nodes[call].args[a];
+        ir_block_append(out, stor);
+    }
+
+    for (size_t r = 0; r + 1 < block->size; r++) {
+        ir_block_append(out, inline_tree(f, &body, block->roots[r], locals, pc, positions));
+    }
+
+    // the returned value takes the place of the call
+    irref ret = block->roots[block->size - 1];
+    *slot = inline_tree(f, &body, body.nodes[ret].args[0], locals, pc, positions);
+
+    free(locals);
+    free(positions);
+    ir_delete(&body);
+    return true;
+}
+
+boolean ir_inline_calls(ir_function* f)
+{
+    ir_globals g;
+    boolean changed = false;
+
+    // inlined code is mapped to the lines of its call sites
+    if (f->p->line_address_table.size == 0) {
+        return false;
+    }
+
+    ir_globals_new(f, &g);
+
+    for (size_t b = 0; b < f->graph.size; b++)
+    {
+        ir_block out = { .roots = NULL, .size = 0, .capacity = 0 };
+
+        for (size_t r = 0; r < f->blocks[b].size; r++)
+        {
+            irref root = f->blocks[b].roots[r];
+
+            // inlined bodies only call natives, so every statement runs out of calls to inline
+            while (inline_call(f, &root, &g, &out)) {
+                changed = true;
+            }
+
+            ir_block_append(&out, root);
+        }
+
+        free(f->blocks[b].roots);
+        f->blocks[b].roots = out.roots;
+        f->blocks[b].size = out.size;
+        f->blocks[b].capacity = out.capacity;
+    }
+
+    free(g.stores);
+    return changed;
+}
+
+// applies a statement tree to the copies known to hold before it
+static boolean propagate_tree(ir_function* f, irref n, instruction* copies, size_t nvariables, boolean rewrite)
+{
+    ir_node* node = &f->nodes[n];
+    boolean changed = false;
+    size_t var = ir_variable(f, node->i);
+    size_t globals = ir_variable(f, (instruction) { .ux = { .op = OP_LOADG, .ux = 0 } });
+
+    for (uint32_t a = 0; a < node->argc; a++) {
+        changed = propagate_tree(f, node->args[a], copies, nvariables, rewrite) || changed;
+    }
+
+    switch (node->i.stackop.op)
+    {
+        case OP_LOADL:
+        case OP_LOADG:
+            if (rewrite && copies[var].stackop.op != OP_NOP) {
+                node->i = copies[var];
+                changed = true;
+            }
+            break;
+
+        case OP_CALL: case OP_TAILCALL:
+            // callees may assign any global
+            for (size_t v = 0; v < nvariables; v++) {
+                if (v >= globals || copies[v].stackop.op == OP_LOADG) copies[v].stackop.op = OP_NOP;
+            }
+            break;
+
+        // FORLOOP assigns its counter in place, which never makes it a copy
+        case OP_FORLOOP:
+        case OP_STORL:
+        case OP_STORG:
+        case OP_STORC: {
+            instruction value = node->argc > 0 ? f->nodes[node->args[0]].i : node->i;
+            size_t source = ir_variable(f, value);
+
+            if (!rewrite && (value.stackop.op == OP_LOADL || value.stackop.op == OP_LOADG) &&
+                copies[source].stackop.op != OP_NOP) {
+                value = copies[source];
+            }
+
+            copies[var].stackop.op = OP_NOP;
+
+            for (size_t v = 0; v < nvariables; v++) {
+                if (copies[v].stackop.op != OP_NOP && copies[v].stackop.op != OP_PUSHK && ir_variable(f, copies[v]) == var) {
+                    copies[v].stackop.op = OP_NOP;
+                }
+            }
+
+            boolean copied = value.stackop.op == OP_PUSHK ||
+                ((value.stackop.op == OP_LOADL || value.stackop.op == OP_LOADG) && ir_variable(f, value) != var);
+
+            if (node->i.stackop.op != OP_STORC && copied && f->nodes[node->args[0]].argc == 0) {
+                copies[var] = value;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return changed;
+}
+
+boolean ir_propagate_copies(ir_function* f)
+{
+    size_t nblocks = f->graph.size;
+    size_t nvariables = ir_variable_count(f);
+    instruction** in = calloc(nblocks + 1, sizeof(instruction*));
+    instruction* state = malloc(sizeof(instruction) * (nvariables + 1));
+    boolean changed = nblocks > 0;
+
+    if (nblocks > 0) {
+        in[0] = calloc(nvariables + 1, sizeof(instruction));
+    }
+
+    // a copy holds on entry to a block only if it holds at the end of every predecessor
+    while (changed)
+    {
+        changed = false;
+
+        for (size_t b = 0; b < nblocks; b++)
+        {
+            if (in[b] == NULL) {
+                continue;
+            }
+
+            memcpy(state, in[b], sizeof(instruction) * nvariables);
+
+            for (size_t r = 0; r < f->blocks[b].size; r++) {
+                propagate_tree(f, f->blocks[b].roots[r], state, nvariables, false);
+            }
+
+            for (size_t s = 0; s < f->graph.blocks[b].nsuccessors; s++)
+            {
+                size_t succ = f->graph.blocks[b].successors[s];
+
+                if (succ == CFG_EXIT) {
+                    continue;
+                }
+
+                if (in[succ] == NULL) {
+                    in[succ] = malloc(sizeof(instruction) * (nvariables + 1));
+                    memcpy(in[succ], state, sizeof(instruction) * nvariables);
+                    changed = true;
+                    continue;
+                }
+
+                for (size_t v = 0; v < nvariables; v++)
+                {
+                    if (in[succ][v].stackop.op != OP_NOP && !same_instruction(in[succ][v], state[v])) {
+                        in[succ][v].stackop.op = OP_NOP;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    for (size_t b = 0; b < nblocks; b++)
+    {
+        if (in[b] == NULL) {
+            continue;
+        }
+
+        memcpy(state, in[b], sizeof(instruction) * nvariables);
+
+        for (size_t r = 0; r < f->blocks[b].size; r++) {
+            changed = propagate_tree(f, f->blocks[b].roots[r], state, nvariables, true) || changed;
+        }
+
+        free(in[b]);
+    }
+
+    free(in);
+    free(state);
+    return changed;
+}
+
+static boolean pure_operation(vm_op op)
+{
+    return (op >= OP_ADD && op <= OP_GE);
+}
+
+static boolean same_value(ir_value* a, ir_value* b)
+{
+    return same_instruction(a->i, b->i) && a->args[0] == b->args[0] && a->args[1] == b->args[1];
+}
+
+static size_t value_hash(ir_value* v)
+{
+    uint64_t bits = ((uint64_t) v->i.ux.op << 32 | v->i.ux.ux) * 0x9e3779b97f4a7c15ull;
+    bits = (bits ^ (uint32_t) v->args[0]) * 0x9e3779b97f4a7c15ull;
+    bits = (bits ^ (uint32_t) v->args[1]) * 0x9e3779b97f4a7c15ull;
+    return bits ^ (bits >> 32);
+}
+
+// slot holding an equal value in the index, or the empty slot it belongs in
+static uint32_t* value_slot(ir_numbering* t, ir_value* v)
+{
+    for (size_t s = value_hash(v) & t->mask; ; s = (s + 1) & t->mask)
+    {
+        uint32_t* slot = &t->slots[s];
+
+        if (*slot == 0 || same_value(&t->values[*slot - 1], v)) {
+            return slot;
+        }
+    }
+}
+
+// numbers a tree bottom up, equal numbers always compute equal values
+static void number_tree(ir_function* f, irref n, int32_t* numbers, ir_numbering* t)
+{
+    ir_node* node = &f->nodes[n];
+    ir_value v = { .i = node->i, .args = { -1, -1 } };
+    size_t var = ir_variable(f, node->i);
+    size_t globals = ir_variable(f, (instruction) { .ux = { .op = OP_LOADG, .ux = 0 } });
+    boolean unique = false;
+
+    for (uint32_t a = 0; a < node->argc; a++) {
+        number_tree(f, node->args[a], numbers, t);
+    }
+
+    switch (node->i.stackop.op)
+    {
+        case OP_PUSHK:
+            break;
+
+        // globals and closed values loaded after a call are numbered after it
+        case OP_LOADL: case OP_LOADG: case OP_LOADC:
+            v.args[0] = var >= globals && t->call > t->versions[var] ? t->call : t->versions[var];
+            break;
+
+        case OP_STORL: case OP_STORG: case OP_STORC: case OP_FORLOOP:
+            t->versions[var] = t->size;
+            unique = true;
+            break;
+
+        case OP_CALL: case OP_TAILCALL:
+            t->call = t->size;
+            unique = true;
+            break;
+
+        default:
+            if (!pure_operation(node->i.stackop.op)) {
+                unique = true;
+            }
+
+            for (uint32_t a = 0; a < node->argc && !unique; a++) {
+                v.args[a] = numbers[node->args[a]];
+            }
+    }
+
+    // values with side effects never match another value
+    if (unique) {
+        v.i.ux.op = OP_NOP;
+        t->values[t->size] = v;
+        numbers[n] = t->size++;
+        return;
+    }
+
+    uint32_t* slot = value_slot(t, &v);
+
+    if (*slot == 0) {
+        t->values[t->size] = v;
+        *slot = ++t->size;
+    }
+
+    numbers[n] = *slot - 1;
+}
+
+static void count_tree(ir_function* f, irref n, int32_t* numbers, size_t* counts)
+{
+    ir_node* node = &f->nodes[n];
+
+    // repeated expressions are replaced as a whole, their operands are not counted
+    if (counts[numbers[n]]++ > 0 && pure_operation(node->i.stackop.op)) {
+        return;
+    }
+
+    for (uint32_t a = 0; a < node->argc; a++) {
+        count_tree(f, node->args[a], numbers, counts);
+    }
+}
+
+static irref replace_tree(ir_function* f, irref n, int32_t* numbers, size_t* counts, int32_t* temps)
+{
+    program* p = f->p;
+    int32_t number = numbers[n];
+    vm_op op = f->nodes[n].i.stackop.op;
+
+    // a temporary costs a duplicate, a store and a load per repetition
+    if (pure_operation(op) && counts[number] >= 2 && (counts[number] - 1) * (ir_size(f, n) - 1) > 2)
+    {
+        vm_op store = p->prev != NULL ? OP_STORL : OP_STORG;
+        vm_op load = p->prev != NULL ? OP_LOADL : OP_LOADG;
+
+        if (temps[number] != IRREF_NONE) {
+            instruction i = { .ux = { .op = load, .ux = temps[number] } };
+            return ir_node_new(f, i, 0, ir_first_pc(f, n));
+        }
+
+        if ((temps[number] = ir_temporary(f, "cse")) != IRREF_NONE)
+        {
+            for (uint32_t a = 0; a < f->nodes[n].argc; a++) {
+                irref arg = replace_tree(f, f->nodes[n].args[a], numbers, counts, temps);
+                f->nodes[n].args[a] = arg;
+            }
+
+            instruction i = { .ux = { .op = store, .ux = temps[number] } };
+            irref tee = ir_node_new(f, i, 1, f->nodes[n].pc);
+            f->nodes[tee].args[0] = n;
+            f->nodes[tee].keep = true;
+            return tee;
+        }
+    }
+
+    for (uint32_t a = 0; a < f->nodes[n].argc; a++) {
+        irref arg = replace_tree(f, f->nodes[n].args[a], numbers, counts, temps);
+        f->nodes[n].args[a] = arg;
+    }
+
+    return n;
+}
+
+boolean ir_eliminate_common_subexpressions(ir_function* f)
+{
+    size_t nnodes = f->size;
+    size_t nvariables = 0;
+    int32_t* numbers = malloc(sizeof(int32_t) * (nnodes + 1));
+    size_t* counts = malloc(sizeof(size_t) * (nnodes + 1));
+    int32_t* temps = malloc(sizeof(int32_t) * (nnodes + 1));
+    ir_numbering t = { .values = malloc(sizeof(ir_value) * (nnodes + 1)), .mask = 15, .versions = NULL };
+    size_t before = f->size;
+
+    // the index is kept at most half full
+    while (t.mask + 1 < 2 * (nnodes + 1)) {
+        t.mask = t.mask * 2 + 1;
+    }
+    t.slots = calloc(t.mask + 1, sizeof(uint32_t));
+
+    for (size_t b = 0; b < f->graph.size; b++)
+    {
+        ir_block* block = &f->blocks[b];
+        size_t nvalues;
+
+        // temporaries added to earlier blocks grow the frame
+        nvariables = ir_variable_count(f);
+        t.versions = realloc(t.versions, sizeof(int32_t) * (nvariables + 1));
+        t.size = 0;
+        t.call = INT32_MIN;
+
+        for (size_t v = 0; v < nvariables; v++) {
+            t.versions[v] = -1 - v;
+        }
+
+        for (size_t r = 0; r < block->size; r++) {
+            number_tree(f, block->roots[r], numbers, &t);
+        }
+
+        nvalues = t.size;
+
+        // values of one block never match those of the next, removing them
+        // latest first leaves every probe sequence as it was before they were added
+        for (size_t v = nvalues; v-- > 0; ) {
+            if (t.values[v].i.ux.op != OP_NOP) *value_slot(&t, &t.values[v]) = 0;
+        }
+
+        for (size_t v = 0; v < nvalues; v++) {
+            counts[v] = 0;
+            temps[v] = IRREF_NONE;
+        }
+
+        for (size_t r = 0; r < block->size; r++) {
+            count_tree(f, block->roots[r], numbers, counts);
+        }
+
+        for (size_t r = 0; r < block->size; r++) {
+            block->roots[r] = replace_tree(f, block->roots[r], numbers, counts, temps);
+        }
+    }
+
+    free(numbers);
+    free(counts);
+    free(temps);
+    free(t.values);
+    free(t.slots);
+    free(t.versions);
+    return f->size != before;
+}
+
+static void mark_loads(ir_function* f, irref n, boolean* loaded)
+{
+    ir_node* node = &f->nodes[n];
+
+    if (node->i.stackop.op == OP_LOADL) {
+        loaded[node->i.ux.ux] = true;
+    } else if (node->i.stackop.op == OP_FORPREP || node->i.stackop.op == OP_FORLOOP) {
+        loaded[FOR_COUNTER(node->i.ux.ux)] = true;
+    }
+
+    for (uint32_t a = 0; a < node->argc; a++) {
+        mark_loads(f, node->args[a], loaded);
+    }
+}
+
+boolean ir_eliminate_dead_stores(ir_function* f)
+{
+    program* p = f->p;
+    boolean changed = false;
+
+    // globals may be loaded by any function
+    if (p->prev == NULL) {
+        return false;
+    }
+
+    boolean* loaded = calloc(p->symbol_table.size + 1, sizeof(boolean));
+
+    for (size_t b = 0; b < f->graph.size; b++) {
+        for (size_t r = 0; r < f->blocks[b].size; r++) {
+            mark_loads(f, f->blocks[b].roots[r], loaded);
+        }
+    }
+
+    for (size_t b = 0; b < f->graph.size; b++)
+    {
+        ir_block* block = &f->blocks[b];
+        size_t size = 0;
+
+        for (size_t r = 0; r < block->size; r++)
+        {
+            ir_node* node = &f->nodes[block->roots[r]];
+            vm_op op = node->i.stackop.op;
+
+            if (op == OP_STORL && !loaded[node->i.ux.ux]) {
+                node->i.stackop.op = op = OP_POP;
+                changed = true;
+            }
+
+            if (op == OP_POP && ir_effect_free(f, node->args[0])) {
+                changed = true;
+                continue;
+            }
+
+            block->roots[size++] = block->roots[r];
+        }
+
+        block->size = size;
+    }
+
+    free(loaded);
+    return changed;
+}
+
+vm_op typed_operation(vm_op op, vm_type a, vm_type b)
+{
+    if (op > OP_GE || a != b) {
+        return OP_NOP;
+    }
+
+    return a == VM_INT ? int_op_map[op] : a == VM_FLOAT ? float_op_map[op] : OP_NOP;
+}
+
+static boolean numeric_type(vm_type t)
+{
+    return t == VM_INT || t == VM_FLOAT || t == VM_BOOL;
+}
+
+// result type of an operation following the type pairs handled in value.c
+static vm_type result_type(vm_op op, vm_type a, vm_type b)
+{
+    switch (op)
+    {
+        case OP_EQ: case OP_NE: case OP_AND: case OP_OR: case OP_NOT:
+            return VM_BOOL;
+
+        case OP_LT: case OP_LE: case OP_GT: case OP_GE:
+            return numeric_type(a) && numeric_type(b) ? VM_BOOL : VM_NULL;
+
+        case OP_NEG:
+            return numeric_type(a) ? a : VM_NULL;
+
+        case OP_ADD:
+            if (a == VM_STRING && b == VM_STRING) return VM_STRING;
+
+        case OP_SUB: case OP_MUL: case OP_DIV:
+            if (!numeric_type(a) || !numeric_type(b)) return VM_NULL;
+            return a == VM_FLOAT || b == VM_FLOAT ? VM_FLOAT : a == VM_INT || b == VM_INT ? VM_INT : VM_BOOL;
+
+        case OP_MOD:
+            if (!numeric_type(a) || !numeric_type(b) || a == VM_FLOAT || b == VM_FLOAT) return VM_NULL;
+            return a == VM_INT || b == VM_INT ? VM_INT : VM_BOOL;
+
+        case OP_TNEW:
+            return VM_TABLE;
+
+        case OP_CLOSE:
+            return VM_PROGRAM;
+
+        default:
+            return VM_NULL;
+    }
+}
+
+static vm_type infer_tree(ir_function* f, irref n, vm_type* locals)
+{
+    ir_node* node = &f->nodes[n];
+    vm_type a = VM_NULL, b = VM_NULL, t;
+
+    for (uint32_t i = 0; i < node->argc; i++) {
+        infer_tree(f, node->args[i], locals);
+    }
+
+    if (node->argc > 0) a = f->types[node->args[0]];
+    if (node->argc > 1) b = f->types[node->args[1]];
+
+    switch (node->i.stackop.op)
+    {
+        case OP_PUSHK:
+            t = f->p->constants[node->i.ux.ux].type;
+            break;
+
+        case OP_LOADL:
+            t = locals[node->i.ux.ux];
+            break;
+
+        case OP_STORL:
+            node->guard = VM_NULL;
+
+            // unknown values stored into a speculated local are checked
+            if (a == VM_NULL && !node->keep && f->speculated != NULL && f->speculated[node->i.ux.ux] != VM_NULL &&
+                f->nodes[node->args[0]].i.stackop.op != OP_PUSHK) {
+                node->guard = a = f->speculated[node->i.ux.ux];
+            }
+
+            t = locals[node->i.ux.ux] = a;
+            break;
+
+        // counted loops raise an error unless their counter is an int
+        case OP_FORPREP: case OP_FORLOOP:
+            t = locals[FOR_COUNTER(node->i.ux.ux)] = VM_INT;
+            break;
+
+        default:
+            t = result_type(node->i.stackop.op, a, b);
+    }
+
+    return f->types[n] = t;
+}
+
+// solves the types of locals on entry to every block and types each value
+static void infer_function(ir_function* f)
+{
+    size_t nblocks = f->graph.size;
+    size_t nlocals = f->p->symbol_table.size;
+    vm_type** in = calloc(nblocks + 1, sizeof(vm_type*));
+    vm_type* state = malloc(sizeof(vm_type) * (nlocals + 1));
+    boolean changed = nblocks > 0;
+
+    free(f->types);
+    f->types = calloc(f->size + 1, sizeof(vm_type));
+
+    if (nblocks > 0) {
+        in[0] = calloc(nlocals + 1, sizeof(vm_type));
+
+        for (size_t a = 0; f->speculated != NULL && a < f->p->argc; a++) {
+            in[0][a] = f->speculated[a];
+        }
+    }
+
+    // a local has a type on entry to a block only if it has it at the end of every predecessor
+    while (changed)
+    {
+        changed = false;
+
+        for (size_t b = 0; b < nblocks; b++)
+        {
+            if (in[b] == NULL) {
+                continue;
+            }
+
+            memcpy(state, in[b], sizeof(vm_type) * nlocals);
+
+            for (size_t r = 0; r < f->blocks[b].size; r++) {
+                infer_tree(f, f->blocks[b].roots[r], state);
+            }
+
+            for (size_t s = 0; s < f->graph.blocks[b].nsuccessors; s++)
+            {
+                size_t succ = f->graph.blocks[b].successors[s];
+
+                if (succ == CFG_EXIT) {
+                    continue;
+                }
+
+                if (in[succ] == NULL) {
+                    in[succ] = malloc(sizeof(vm_type) * (nlocals + 1));
+                    memcpy(in[succ], state, sizeof(vm_type) * nlocals);
+                    changed = true;
+                    continue;
+                }
+
+                for (size_t v = 0; v < nlocals; v++)
+                {
+                    if (in[succ][v] != VM_NULL && in[succ][v] != state[v]) {
+                        in[succ][v] = VM_NULL;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // values are typed with the final block entry states
+    for (size_t b = 0; b < nblocks; b++)
+    {
+        if (in[b] == NULL) {
+            continue;
+        }
+
+        memcpy(state, in[b], sizeof(vm_type) * nlocals);
+
+        for (size_t r = 0; r < f->blocks[b].size; r++) {
+            infer_tree(f, f->blocks[b].roots[r], state);
+        }
+
+        free(in[b]);
+    }
+
+    free(in);
+    free(state);
+}
+
+// records the type a local should be speculated to have
+static void propose_type(vm_type* proposed, boolean* conflicts, size_t local, vm_type t)
+{
+    if (t != VM_INT && t != VM_FLOAT) {
+        conflicts[local] = true;
+    } else if (proposed[local] == VM_NULL) {
+        proposed[local] = t;
+    } else if (proposed[local] != t) {
+        conflicts[local] = true;
+    }
+}
+
+static void collect_speculation(ir_function* f, irref n, vm_type* proposed, boolean* conflicts, boolean* unknown, boolean* used)
+{
+    ir_node* node = &f->nodes[n];
+
+    for (uint32_t i = 0; i < node->argc; i++) {
+        collect_speculation(f, node->args[i], proposed, conflicts, unknown, used);
+    }
+
+    if (node->i.stackop.op == OP_STORL)
+    {
+        ir_node* value = &f->nodes[node->args[0]];
+        vm_type t = f->types[node->args[0]];
+
+        if (t == VM_NULL && !node->keep && value->i.stackop.op != OP_PUSHK) {
+            unknown[node->i.ux.ux] = true;
+        } else {
+            propose_type(proposed, conflicts, node->i.ux.ux, t);
+        }
+    }
+
+    // an untyped local used with a typed operand is expected to share its type
+    if (node->argc == 2 && int_op_map[node->i.stackop.op <= OP_GE ? node->i.stackop.op : OP_NOP] != OP_NOP)
+    {
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            ir_node* local = &f->nodes[node->args[i]];
+            vm_type other = f->types[node->args[1 - i]];
+
+            if (local->i.stackop.op == OP_LOADL && f->types[node->args[i]] == VM_NULL && (other == VM_INT || other == VM_FLOAT)) {
+                propose_type(proposed, conflicts, local->i.ux.ux, other);
+                used[local->i.ux.ux] = true;
+            }
+        }
+    }
+}
+
+static boolean has_typed_operation(ir_function* f, irref n)
+{
+    ir_node* node = &f->nodes[n];
+
+    if (node->argc == 2 && typed_operation(node->i.stackop.op, f->types[node->args[0]], f->types[node->args[1]]) != OP_NOP) {
+        return true;
+    }
+
+    for (uint32_t i = 0; i < node->argc; i++) {
+        if (has_typed_operation(f, node->args[i])) return true;
+    }
+
+    return false;
+}
+
+boolean ir_infer_types(ir_function* f)
+{
+    program* p = f->p;
+    size_t nlocals = p->symbol_table.size;
+    boolean typed = false, speculated = false;
+
+    // only function locals are private to the code being typed
+    if (p->prev == NULL || p->length == 0) {
+        return false;
+    }
+
+    free(f->speculated);
+    f->speculated = NULL;
+    infer_function(f);
+
+    vm_type* proposed = calloc(nlocals + 1, sizeof(vm_type));
+    boolean* conflicts = calloc(nlocals + 1, sizeof(boolean));
+    boolean* unknown = calloc(nlocals + 1, sizeof(boolean));
+    boolean* used = calloc(nlocals + 1, sizeof(boolean));
+
+    for (size_t b = 0; b < f->graph.size; b++) {
+        for (size_t r = 0; r < f->blocks[b].size; r++) {
+            collect_speculation(f, f->blocks[b].roots[r], proposed, conflicts, unknown, used);
+        }
+    }
+
+    // the generic copy follows the typed one, so the function may not fall off its end
+    for (size_t v = 0; v < nlocals && p->code[p->length - 1].stackop.op == OP_RET; v++)
+    {
+        if (!conflicts[v] && used[v] && proposed[v] != VM_NULL && (unknown[v] || v < p->argc)) {
+            speculated = true;
+        } else {
+            proposed[v] = VM_NULL;
+        }
+    }
+
+    if (speculated) {
+        f->speculated = proposed;
+        infer_function(f);
+    } else {
+        free(proposed);
+    }
+
+    for (size_t b = 0; b < f->graph.size && !typed; b++) {
+        for (size_t r = 0; r < f->blocks[b].size && !typed; r++) {
+            typed = has_typed_operation(f, f->blocks[b].roots[r]);
+        }
+    }
+
+    // without specialized operations the generic code is kept as it is
+    if (!typed) {
+        free(f->types);
+        free(f->speculated);
+        f->types = NULL;
+        f->speculated = NULL;
+
+        for (size_t n = 0; n < f->size; n++) {
+            f->nodes[n].guard = VM_NULL;
+        }
+    }
+
+    free(conflicts);
+    free(unknown);
+    free(used);
+    return false;
+}
+
+// what the code of a loop may change while it runs
+typedef struct ir_loop {
+    boolean* blocks;    // blocks inside the loop
+    boolean* stored;    // variables assigned inside the loop
+    boolean calls;      // calls code which may have side effects
+    boolean tables;     // writes table entries
+    ir_globals globals;
+} ir_loop;
+
+static boolean pure_call(ir_function* f, irref n, ir_loop* loop)
+{
+    ir_node* node = &f->nodes[n];
+    const native_method* m = native_callee(f, node->args[node->argc - 1], &loop->globals);
+
+    return m != NULL && m->pure && node->i.ux.ux == m->argc;
+}
+
+static void collect_loop_effects(ir_function* f, irref n, ir_loop* loop)
+{
+    ir_node* node = &f->nodes[n];
+    size_t var = ir_variable(f, node->i);
+
+    for (uint32_t a = 0; a < node->argc; a++) {
+        collect_loop_effects(f, node->args[a], loop);
+    }
+
+    switch (node->i.stackop.op)
+    {
+        case OP_STORL: case OP_STORG: case OP_STORC: case OP_FORLOOP:
+            loop->stored[var] = true;
+            break;
+
+        case OP_CALL: case OP_TAILCALL:
+            loop->calls = loop->calls || !pure_call(f, n, loop);
+            break;
+
+        case OP_TPUT:
+            loop->tables = true;
+            break;
+
+        default:
+            break;
+    }
+}
+
+// divisions are only hoisted by constants which cannot fault
+static boolean safe_divisor(ir_function* f, irref n, vm_op op)
+{
+    ir_node* node = &f->nodes[n];
+
+    if (node->i.stackop.op != OP_PUSHK) {
+        return false;
+    }
+
+    Value* k = &f->p->constants[node->i.ux.ux];
+
+    if (k->type == VM_INT) {
+        return k->value.to_int != 0 && k->value.to_int != -1;
+    }
+
+    return op == OP_DIV && k->type == VM_FLOAT && k->value.to_float != 0.0;
+}
+
+// an invariant tree computes the same value on every iteration and can neither fail nor change state
+static boolean invariant_tree(ir_function* f, irref n, ir_loop* loop)
+{
+    ir_node* node = &f->nodes[n];
+    vm_op op = node->i.stackop.op;
+    vm_type a = node->argc > 0 ? f->types[node->args[0]] : VM_NULL;
+    vm_type b = node->argc > 1 ? f->types[node->args[1]] : VM_NULL;
+
+    if (node->keep) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < node->argc; i++) {
+        if (!invariant_tree(f, node->args[i], loop)) return false;
+    }
+
+    switch (op)
+    {
+        case OP_PUSHK:
+            return true;
+
+        case OP_LOADL:
+            return !loop->stored[ir_variable(f, node->i)];
+
+        // callees may assign globals and closed values
+        case OP_LOADG: case OP_LOADC:
+            return !loop->stored[ir_variable(f, node->i)] && !loop->calls;
+
+        case OP_EQ: case OP_NE: case OP_AND: case OP_OR: case OP_NOT:
+            return true;
+
+        case OP_ADD: case OP_SUB: case OP_MUL: case OP_NEG:
+        case OP_LT: case OP_LE: case OP_GT: case OP_GE:
+            return result_type(op, a, b) != VM_NULL;
+
+        case OP_DIV: case OP_MOD:
+            return result_type(op, a, b) != VM_NULL && safe_divisor(f, node->args[1], op);
+
+        case OP_CALL: case OP_TAILCALL:
+            return pure_call(f, n, loop);
+
+        case OP_TGET:
+            return a == VM_TABLE && !loop->tables && !loop->calls;
+
+        default:
+            return false;
+    }
+}
+
+// replaces the largest invariant trees by temporaries assigned in the preheader
+static irref hoist_tree(ir_function* f, irref n, ir_loop* loop, ir_block* preheader, boolean* hoisted)
+{
+    vm_op store = f->p->prev != NULL ? OP_STORL : OP_STORG;
+    vm_op load = f->p->prev != NULL ? OP_LOADL : OP_LOADG;
+
+    if (f->nodes[n].argc > 0 && invariant_tree(f, n, loop))
+    {
+        int32_t temp = ir_temporary(f, "licm");
+
+        if (temp != IRREF_NONE)
+        {
+            instruction i = { .ux = { .op = store, .ux = temp } };
+            irref stor = ir_node_new(f, i, 1, f->nodes[n].pc);
+            f->nodes[stor].args[0] = n;
+            ir_block_append(preheader, stor);
+            *hoisted = true;
+
+            i.ux.op = load;
+            return ir_node_new(f, i, 0, ir_first_pc(f, n));
+        }
+
+        return n;
+    }
+
+    for (uint32_t a = 0; a < f->nodes[n].argc; a++) {
+        irref arg = hoist_tree(f, f->nodes[n].args[a], loop, preheader, hoisted);
+        f->nodes[n].args[a] = arg;
+    }
+
+    return n;
+}
+
+// finds the blocks of the loop entered at a header, the union of the natural loops of its back edges
+static boolean* natural_loop(ir_function* f, size_t header)
+{
+    size_t nblocks = f->graph.size;
+    size_t* stack = malloc(sizeof(size_t) * (nblocks + 1));
+    boolean* blocks = calloc(nblocks + 1, sizeof(boolean));
+    size_t top = 0;
+
+    blocks[header] = true;
+
+    for (size_t b = header; b < nblocks; b++)
+    {
+        for (size_t s = 0; s < f->graph.blocks[b].nsuccessors; s++)
+        {
+            if (f->graph.blocks[b].successors[s] == header && !blocks[b]) {
+                blocks[b] = true;
+                stack[top++] = b;
+            }
+        }
+    }
+
+    // blocks reaching a back edge without passing the header
+    while (top > 0)
+    {
+        size_t block = stack[--top];
+
+        for (size_t b = 0; b < nblocks; b++)
+        {
+            for (size_t s = 0; s < f->graph.blocks[b].nsuccessors; s++)
+            {
+                if (f->graph.blocks[b].successors[s] == block && !blocks[b]) {
+                    blocks[b] = true;
+                    stack[top++] = b;
+                }
+            }
+        }
+    }
+
+    free(stack);
+    return blocks;
+}
+
+// checks that a preheader can be laid out right before the header of a loop
+static boolean preheader_valid(ir_function* f, size_t header, boolean* blocks)
+{
+    for (size_t b = 0; b < header; b++) {
+        if (blocks[b]) return false;
+    }
+
+    // the instruction skipped by a conditional jump cannot be moved away from it
+    for (size_t b = header; b-- > 0;)
+    {
+        if (f->blocks[b].size > 0) {
+            ir_node* last = &f->nodes[f->blocks[b].roots[f->blocks[b].size - 1]];
+            return !conditional_skip(last->i.stackop.op);
+        }
+    }
+
+    return true;
+}
+
+// appends statements to the preheader of a loop, returns the new index of its header
+static size_t append_preheader(ir_function* f, size_t header, boolean* blocks, ir_block* statements)
+{
+    // loops which were hoisted from before reuse their preheader
+    if (header == 0 || !f->blocks[header - 1].preheader) {
+        ir_insert_preheader(f, header, blocks);
+        header++;
+    }
+
+    for (size_t r = 0; r < statements->size; r++) {
+        ir_block_append(&f->blocks[header - 1], statements->roots[r]);
+    }
+
+    return header;
+}
+
+// hoists out of the loop entered at a header
+static boolean hoist_loop(ir_function* f, size_t header, ir_loop* loop)
+{
+    size_t nblocks = f->graph.size;
+    boolean hoisted = false;
+
+    loop->blocks = natural_loop(f, header);
+    loop->stored = calloc(ir_variable_count(f) + 1, sizeof(boolean));
+    loop->calls = false;
+    loop->tables = false;
+
+    boolean valid = preheader_valid(f, header, loop->blocks);
+
+    for (size_t b = header; b < nblocks && valid; b++) {
+        for (size_t r = 0; loop->blocks[b] && r < f->blocks[b].size; r++) {
+            collect_loop_effects(f, f->blocks[b].roots[r], loop);
+        }
+    }
+
+    ir_block preheader = { .roots = NULL, .size = 0, .capacity = 0 };
+
+    for (size_t b = header; b < nblocks && valid; b++)
+    {
+        for (size_t r = 0; loop->blocks[b] && r < f->blocks[b].size; r++)
+        {
+            irref root = f->blocks[b].roots[r];
+
+            // statements are kept, only the values they compute are hoisted
+            for (uint32_t a = 0; a < f->nodes[root].argc; a++) {
+                irref arg = hoist_tree(f, f->nodes[root].args[a], loop, &preheader, &hoisted);
+                f->nodes[root].args[a] = arg;
+            }
+        }
+    }
+
+    if (hoisted) {
+        append_preheader(f, header, loop->blocks, &preheader);
+    }
+
+    free(preheader.roots);
+    free(loop->blocks);
+    free(loop->stored);
+    return hoisted;
+}
+
+boolean ir_hoist_loop_invariants(ir_function* f)
+{
+    boolean changed = false, hoisted = true;
+    ir_loop loop;
+
+    ir_globals_new(f, &loop.globals);
+
+    // only proven types are used, hoisted code runs before any guard of the loop
+    free(f->speculated);
+    f->speculated = NULL;
+
+    // inner loops have later headers and are hoisted first
+    while (hoisted)
+    {
+        hoisted = false;
+        infer_function(f);
+
+        for (size_t h = f->graph.size; h-- > 0 && !hoisted;)
+        {
+            boolean entered = false;
+
+            for (size_t b = h; b < f->graph.size; b++) {
+                for (size_t s = 0; s < f->graph.blocks[b].nsuccessors; s++) {
+                    entered = entered || f->graph.blocks[b].successors[s] == h;
+                }
+            }
+
+            if (entered) {
+                hoisted = hoist_loop(f, h, &loop);
+                changed = changed || hoisted;
+            }
+        }
+    }
+
+    // types are inferred again once the IR settles
+    free(f->types);
+    f->types = NULL;
+
+    free(loop.globals.stores);
+    return changed;
+}
+
+// registers an int constant, IRREF_NONE if the pool is full
+static int32_t int_constant(ir_function* f, int64_t value)
+{
+    if (f->p->constant_table.size > MAX_OPERAND) {
+        return IRREF_NONE;
+    }
+
+    return register_constant(f->p, vInt(value));
+}
+
+static boolean stores_local(ir_function* f, irref n, uint16_t local)
+{
+    ir_node* node = &f->nodes[n];
+
+    if ((node->i.stackop.op == OP_STORL && node->i.ux.ux == local) ||
+        (node->i.stackop.op == OP_FORLOOP && FOR_COUNTER(node->i.ux.ux) == local)) {
+        return true;
+    }
+
+    for (uint32_t a = 0; a < node->argc; a++) {
+        if (stores_local(f, node->args[a], local)) return true;
+    }
+
+    return false;
+}
+
+// the step of a statement adding an int constant to a local, 0 if it is not one
+static int64_t induction_step(ir_function* f, irref root, uint16_t* local)
+{
+    ir_node* node = &f->nodes[root];
+
+    if (node->i.stackop.op != OP_STORL || node->keep) {
+        return 0;
+    }
+
+    ir_node* value = &f->nodes[node->args[0]];
+    vm_op op = value->i.stackop.op;
+
+    if (op != OP_ADD && op != OP_SUB) {
+        return 0;
+    }
+
+    irref a = value->args[0], b = value->args[1];
+
+    if (op == OP_ADD && f->nodes[a].i.stackop.op == OP_PUSHK) {
+        a = value->args[1];
+        b = value->args[0];
+    }
+
+    if (f->nodes[a].i.stackop.op != OP_LOADL || f->nodes[a].i.ux.ux != node->i.ux.ux || f->nodes[b].i.stackop.op != OP_PUSHK) {
+        return 0;
+    }
+
+    Value* k = &f->p->constants[f->nodes[b].i.ux.ux];
+
+    if (k->type != VM_INT) {
+        return 0;
+    }
+
+    *local = node->i.ux.ux;
+    return op == OP_ADD ? k->value.to_int : -k->value.to_int;
+}
+
+// a counting loop has a single latch whose last statements increment its counter and jump to the header
+static boolean counting_loop(ir_function* f, size_t header, boolean* blocks, size_t* latch, uint16_t* counter, int64_t* step)
+{
+    size_t latches = 0;
+
+    for (size_t b = header; b < f->graph.size; b++)
+    {
+        for (size_t s = 0; s < f->graph.blocks[b].nsuccessors; s++)
+        {
+            if (blocks[b] && f->graph.blocks[b].successors[s] == header) {
+                *latch = b;
+                latches++;
+            }
+        }
+    }
+
+    ir_block* block = &f->blocks[*latch];
+
+    if (latches != 1 || block->size < 2 || f->nodes[block->roots[block->size - 1]].i.stackop.op != OP_JMP) {
+        return false;
+    }
+
+    if ((*step = induction_step(f, block->roots[block->size - 2], counter)) == 0) {
+        return false;
+    }
+
+    for (size_t b = header; b < f->graph.size; b++)
+    {
+        for (size_t r = 0; blocks[b] && r < f->blocks[b].size; r++)
+        {
+            if ((b != *latch || r != block->size - 2) && stores_local(f, f->blocks[b].roots[r], *counter)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// a derived induction variable is a linear function counter * scale + offset of proven int type
+static boolean derived_form(ir_function* f, irref n, uint16_t counter, int64_t* scale, int64_t* offset)
+{
+    ir_node* node = &f->nodes[n];
+    vm_op op = node->i.stackop.op;
+
+    if (node->keep || f->types[n] != VM_INT) {
+        return false;
+    }
+
+    if (op == OP_LOADL) {
+        *scale = 1;
+        *offset = 0;
+        return node->i.ux.ux == counter;
+    }
+
+    if (op != OP_ADD && op != OP_SUB && op != OP_MUL) {
+        return false;
+    }
+
+    irref a = node->args[0], b = node->args[1];
+
+    if (op != OP_SUB && f->nodes[a].i.stackop.op == OP_PUSHK) {
+        a = node->args[1];
+        b = node->args[0];
+    }
+
+    if (f->nodes[b].i.stackop.op != OP_PUSHK || f->p->constants[f->nodes[b].i.ux.ux].type != VM_INT ||
+        !derived_form(f, a, counter, scale, offset)) {
+        return false;
+    }
+
+    int64_t k = f->p->constants[f->nodes[b].i.ux.ux].value.to_int;
+
+    if (op == OP_MUL) {
+        *scale *= k;
+        *offset *= k;
+    } else {
+        *offset += op == OP_ADD ? k : -k;
+    }
+
+    return true;
+}
+
+// occurrences of one derived induction variable
+typedef struct ir_derived {
+    int64_t scale;
+    int64_t offset;
+    irref first;      // moved into the preheader to initialize the temporary
+    size_t saving;    // instructions saved on every iteration
+    int32_t k;        // constant the temporary advances by
+    int32_t temp;
+} ir_derived;
+
+static void collect_derived(ir_function* f, irref n, uint16_t counter, ir_derived* derived, size_t* nderived)
+{
+    int64_t scale, offset;
+
+    if (f->nodes[n].argc > 0 && derived_form(f, n, counter, &scale, &offset))
+    {
+        size_t d = 0;
+
+        while (d < *nderived && (derived[d].scale != scale || derived[d].offset != offset)) {
+            d++;
+        }
+
+        if (d == *nderived && d < MAX_LOCAL_VARIABLES) {
+            derived[(*nderived)++] = (ir_derived) { .scale = scale, .offset = offset, .first = n, .saving = 0, .k = IRREF_NONE, .temp = IRREF_NONE };
+        }
+
+        if (d < *nderived) {
+            derived[d].saving += ir_size(f, n) - 1;
+        }
+        return;
+    }
+
+    for (uint32_t a = 0; a < f->nodes[n].argc; a++) {
+        collect_derived(f, f->nodes[n].args[a], counter, derived, nderived);
+    }
+}
+
+static irref reduce_tree(ir_function* f, irref n, uint16_t counter, ir_derived* derived, size_t nderived)
+{
+    int64_t scale, offset;
+
+    if (f->nodes[n].argc > 0 && derived_form(f, n, counter, &scale, &offset))
+    {
+        for (size_t d = 0; d < nderived; d++)
+        {
+            if (derived[d].temp != IRREF_NONE && derived[d].scale == scale && derived[d].offset == offset) {
+                instruction i = { .ux = { .op = OP_LOADL, .ux = derived[d].temp } };
+                return ir_node_new(f, i, 0, ir_first_pc(f, n));
+            }
+        }
+        return n;
+    }
+
+    for (uint32_t a = 0; a < f->nodes[n].argc; a++) {
+        irref arg = reduce_tree(f, f->nodes[n].args[a], counter, derived, nderived);
+        f->nodes[n].args[a] = arg;
+    }
+
+    return n;
+}
+
+static boolean reduce_loop(ir_function* f, size_t header)
+{
+    boolean* blocks = natural_loop(f, header);
+    ir_derived* derived = malloc(sizeof(ir_derived) * (MAX_LOCAL_VARIABLES + 1));
+    ir_block preheader = { .roots = NULL, .size = 0, .capacity = 0 };
+    size_t latch, nderived = 0;
+    uint16_t counter;
+    int64_t step;
+
+    if (!preheader_valid(f, header, blocks) || !counting_loop(f, header, blocks, &latch, &counter, &step)) {
+        free(blocks);
+        free(derived);
+        return false;
+    }
+
+    ir_block* block = &f->blocks[latch];
+    irref increment = block->roots[block->size - 2];
+
+    for (size_t b = header; b < f->graph.size; b++) {
+        for (size_t r = 0; blocks[b] && r < f->blocks[b].size; r++) {
+            if (f->blocks[b].roots[r] != increment) collect_derived(f, f->blocks[b].roots[r], counter, derived, &nderived);
+        }
+    }
+
+    // a temporary costs a load, a constant, an add and a store on every iteration
+    for (size_t d = 0; d < nderived; d++)
+    {
+        if (derived[d].saving > 4 && (derived[d].k = int_constant(f, derived[d].scale * step)) != IRREF_NONE) {
+            derived[d].temp = ir_temporary(f, "iv");
+        }
+    }
+
+    for (size_t b = header; b < f->graph.size; b++)
+    {
+        for (size_t r = 0; blocks[b] && r < f->blocks[b].size; r++)
+        {
+            irref root = f->blocks[b].roots[r];
+
+            for (uint32_t a = 0; root != increment && a < f->nodes[root].argc; a++) {
+                irref arg = reduce_tree(f, f->nodes[root].args[a], counter, derived, nderived);
+                f->nodes[root].args[a] = arg;
+            }
+        }
+    }
+
+    for (size_t d = 0; d < nderived; d++)
+    {
+        instruction load = { .ux = { .op = OP_LOADL, .ux = derived[d].temp } };
+        instruction stor = { .ux = { .op = OP_STORL, .ux = derived[d].temp } };
+        instruction push = { .ux = { .op = OP_PUSHK, .ux = derived[d].k } };
+        instruction add = { .stackop = { .op = OP_ADD } };
+        uint32_t pc = f->nodes[increment].pc;
+
+        if (derived[d].temp == IRREF_NONE) {
+            continue;
+        }
+
+        // the first occurrence initializes the temporary before the loop
+        irref init = ir_node_new(f, stor, 1, f->nodes[derived[d].first].pc);
+        f->nodes[init].args[0] = derived[d].first;
+        f->nodes[init].pos = f->nodes[derived[d].first].pos;
+        ir_block_append(&preheader, init);
+
+        // and the temporary advances right before the counter
+        irref update = ir_node_new(f, stor, 1, pc);
+        irref sum = ir_node_new(f, add, 2, pc);
+        f->nodes[sum].args[0] = ir_node_new(f, load, 0, pc);
+        f->nodes[sum].args[1] = ir_node_new(f, push, 0, pc);
+        f->nodes[update].args[0] = sum;
+
+        for (irref n = update; n < (irref) f->size; n++) {
+            f->nodes[n].pos = f->nodes[increment].pos;
+        }
+
+        ir_block_append(block, block->roots[block->size - 1]);
+        block->roots[block->size - 2] = block->roots[block->size - 3];
+        block->roots[block->size - 3] = update;
+    }
+
+    boolean reduced = preheader.size > 0;
+
+    if (reduced) {
+        append_preheader(f, header, blocks, &preheader);
+    }
+
+    free(preheader.roots);
+    free(blocks);
+    free(derived);
+    return reduced;
+}
+
+boolean ir_reduce_induction_variables(ir_function* f)
+{
+    boolean changed = false, reduced = true;
+
+    // only function locals are private to the loop, and only proven types are used
+    if (f->p->prev == NULL) {
+        return false;
+    }
+
+    free(f->speculated);
+    f->speculated = NULL;
+
+    while (reduced)
+    {
+        reduced = false;
+        infer_function(f);
+
+        for (size_t h = f->graph.size; h-- > 0 && !reduced;)
+        {
+            boolean entered = false;
+
+            for (size_t b = h; b < f->graph.size; b++) {
+                for (size_t s = 0; s < f->graph.blocks[b].nsuccessors; s++) {
+                    entered = entered || f->graph.blocks[b].successors[s] == h;
+                }
+            }
+
+            if (entered) {
+                reduced = reduce_loop(f, h);
+                changed = changed || reduced;
+            }
+        }
+    }
+
+    free(f->types);
+    f->types = NULL;
+    return changed;
+}
+
+// builds the FORPREP and FORLOOP of a loop counting up or down to a bound, hidden variables are added
+// unless an earlier selection of the loop already added them
+static boolean select_counted_loop(ir_function* f, size_t header, int32_t limit)
+{
+    ir_block* block = &f->blocks[header];
+
+    if (header + 2 >= f->graph.size || block->size != 1 || f->blocks[header + 1].size != 1) {
+        return false;
+    }
+
+    ir_node* jif = &f->nodes[block->roots[0]];
+    ir_node* exit = &f->nodes[f->blocks[header + 1].roots[0]];
+    ir_node* cond = &f->nodes[jif->args[0]];
+    vm_op op = cond->i.stackop.op;
+
+    if (jif->i.stackop.op != OP_JIF || exit->i.stackop.op != OP_JMP || op < OP_LT || op > OP_GE) {
+        return false;
+    }
+
+    irref bound = cond->args[1];
+    ir_node* var = &f->nodes[cond->args[0]];
+    ir_node* b = &f->nodes[bound];
+
+    if (var->i.stackop.op != OP_LOADL || f->types[cond->args[0]] != VM_INT || f->types[bound] != VM_INT ||
+        (b->i.stackop.op != OP_PUSHK && b->i.stackop.op != OP_LOADL)) {
+        return false;
+    }
+
+    boolean* blocks = natural_loop(f, header);
+    size_t latch;
+    uint16_t counter;
+    int64_t step;
+    boolean valid = counting_loop(f, header, blocks, &latch, &counter, &step);
+
+    // the loop is laid out from its header to its latch, and its exit follows the latch
+    valid = valid && counter == var->i.ux.ux && latch >= header + 2 && exit->target == (int32_t) latch + 1;
+    valid = valid && (op == OP_LT || op == OP_LE ? step > 0 : step < 0);
+
+    for (size_t n = 0; n < f->graph.size && valid; n++)
+    {
+        valid = !blocks[n] || (n >= header && n <= latch);
+
+        for (size_t r = 0; valid && blocks[n] && b->i.stackop.op == OP_LOADL && r < f->blocks[n].size; r++) {
+            valid = !stores_local(f, f->blocks[n].roots[r], b->i.ux.ux);
+        }
+    }
+
+    free(blocks);
+
+    if (!valid) {
+        return false;
+    }
+
+    int32_t k = int_constant(f, step);
+
+    if (k == IRREF_NONE) {
+        return false;
+    }
+
+    if (limit == IRREF_NONE) {
+        limit = ir_temporary(f, "for");
+
+        if (limit == IRREF_NONE || ir_temporary(f, "for") == IRREF_NONE) {
+            return false;
+        }
+    }
+
+    size_t size = f->size;
+    instruction i = { .ux = { .op = OP_PUSHK, .ux = k } };
+    uint32_t pc = jif->pc;
+    lxpos* pos = jif->pos;
+    irref s = ir_node_new(f, i, 0, pc);
+
+    i.ux.op = OP_FORPREP;
+    i.ux.ux = FOR_OPERAND(counter, limit) | (op == OP_LT || op == OP_GT ? FOR_EXCLUSIVE : 0);
+    irref prep = ir_node_new(f, i, 2, pc);
+    f->nodes[prep].args[0] = bound;
+    f->nodes[prep].args[1] = s;
+
+    i.ux.op = OP_FORLOOP;
+    irref loop = ir_node_new(f, i, 0, f->nodes[f->blocks[latch].roots[f->blocks[latch].size - 1]].pc);
+    f->nodes[loop].target = header + 2;
+    f->nodes[loop].pos = f->nodes[f->blocks[latch].roots[f->blocks[latch].size - 1]].pos;
+
+    f->types = realloc(f->types, sizeof(vm_type) * (f->size + 1));
+
+    for (size_t n = size; n < f->size; n++) {
+        f->nodes[n].pos = n == (size_t) loop ? f->nodes[n].pos : pos;
+        f->types[n] = n == (size_t) prep || n == (size_t) loop ? VM_NULL : VM_INT;
+    }
+
+    f->blocks[header].counted = prep;
+    f->blocks[latch].counted = loop;
+    return true;
+}
+
+boolean ir_select_counted_loops(ir_function* f)
+{
+    int32_t* limits = malloc(sizeof(int32_t) * (f->graph.size + 1));
+
+    // passes may have changed the loops, the hidden variables of an earlier selection are reused
+    for (size_t b = 0; b < f->graph.size; b++)
+    {
+        irref counted = f->blocks[b].counted;
+
+        limits[b] = counted != IRREF_NONE && f->nodes[counted].i.stackop.op == OP_FORPREP ? FOR_LIMIT(f->nodes[counted].i.ux.ux) : IRREF_NONE;
+        f->blocks[b].counted = IRREF_NONE;
+    }
+
+    // typed code is lowered only for functions
+    for (size_t h = 0; f->types != NULL && h < f->graph.size; h++)
+    {
+        select_counted_loop(f, h, limits[h]);
+    }
+
+    free(limits);
+    return false;
+}
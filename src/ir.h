@@ -0,0 +1,279 @@
+#ifndef HE_IR_HEADER
+#define HE_IR_HEADER
+
+#include "common.h"
+#include "compiler.h"
+#include "lib.h"
+#include "optimizer.h"
+
+typedef int32_t irref;
+
+#define IRREF_NONE -1
+
+// largest function body, in instructions, which is inlined at its call sites
+#define IR_INLINE_SIZE 24
+
+// ------------------- IR TYPES -----------------
+
+/*
+ * The mid-level IR lifts the bytecode of a finished program into a
+ * control-flow graph of basic blocks. Each block holds a sequence of
+ * statement trees, and each tree node defines exactly one value, computed
+ * by a single bytecode operation from the values of its arguments. Values
+ * are therefore never reassigned, while variables remain explicit loads
+ * and stores so that frames and closures keep their bytecode layout.
+ */
+
+typedef struct ir_node {
+    instruction i;   // operation and operand
+    irref* args;     // arguments in evaluation order
+    uint32_t argc;
+    uint32_t pc;     // originating instruction, for line information
+    int32_t target;  // block a jump transfers control to
+    boolean keep;    // stores which also leave their value on the stack
+    vm_type guard;   // type a store of an unknown value is speculated to have
+    lxpos* pos;      // source position, chained to the call site in inlined code
+} ir_node;
+
+typedef struct ir_block {
+    irref* roots;    // statements in execution order
+    size_t size;
+    size_t capacity;
+    size_t start;    // first instruction in the lifted program
+    boolean preheader; // holds code hoisted out of the loop following it
+    irref counted;   // FORPREP replacing the condition or FORLOOP replacing the increment of a counted loop
+} ir_block;
+
+typedef struct ir_function {
+    program* p;
+    ir_node* nodes;
+    size_t size;
+    size_t capacity;
+    ir_block* blocks;
+    cfg graph;
+    vm_type* types;       // inferred type of each node, VM_NULL if unknown
+    vm_type* speculated;  // type each local is speculated to have, VM_NULL if none
+    lxpos** lines;        // source position of each lifted instruction
+} ir_function;
+
+// ------------------- IR METHODS ---------------
+
+/**
+ * @brief Lifts the bytecode of a program into the mid-level IR. Programs
+ *      whose stack is not empty between statements, or which hold
+ *      instructions the IR cannot represent, are not lifted.
+ *
+ * @param p Reference to program
+ * @param f IR function output
+ * @return True if the program was lifted
+ */
+boolean ir_lift(program* p, ir_function* f);
+
+/**
+ * @brief Lowers an IR function back into the bytecode of its program,
+ *      replacing the original code, jump offsets and line addresses.
+ *      Operations whose operand types were inferred are lowered to their
+ *      type-specialized opcodes. If any local was speculated to have a
+ *      type, the function is lowered twice: the typed copy checks the
+ *      speculated locals with guards, and a failing guard continues at
+ *      the same statement in the generic copy which follows it.
+ *
+ * @param f Reference to IR function
+ */
+void ir_lower(ir_function* f);
+
+/**
+ * @brief Frees the nodes, blocks and control-flow graph of an IR function.
+ *
+ * @param f Reference to IR function
+ */
+void ir_delete(ir_function* f);
+
+/**
+ * @brief Allocates a new IR node with the given operation and room for
+ *      its arguments.
+ *
+ * @param f Reference to IR function
+ * @param i Operation and operand
+ * @param argc Number of arguments
+ * @param pc Originating instruction
+ * @return Node reference
+ */
+irref ir_node_new(ir_function* f, instruction i, uint32_t argc, uint32_t pc);
+
+/**
+ * @brief Returns the number of values an operation pops from and pushes
+ *      onto the stack.
+ *
+ * @param i Instruction
+ * @param pops Number of popped values output
+ * @param pushes Number of pushed values output
+ * @return False if the operation cannot be represented in the IR
+ */
+boolean ir_stack_effect(instruction i, uint32_t* pops, uint32_t* pushes);
+
+/**
+ * @brief Checks whether evaluating a tree has no effect other than
+ *      computing its value: no calls, table access, stores or
+ *      operations which may raise a runtime error.
+ *
+ * @param f Reference to IR function
+ * @param node Root of tree
+ * @return True if tree can be removed when its value is unused
+ */
+boolean ir_effect_free(ir_function* f, irref node);
+
+/**
+ * @brief Counts the instructions a tree lowers to.
+ *
+ * @param f Reference to IR function
+ * @param node Root of tree
+ * @return Instruction count
+ */
+size_t ir_size(ir_function* f, irref node);
+
+/**
+ * @brief Returns the first instruction in the lifted program which a
+ *      tree was built from, used to map source lines.
+ *
+ * @param f Reference to IR function
+ * @param node Root of tree
+ * @return Instruction index
+ */
+uint32_t ir_first_pc(ir_function* f, irref node);
+
+/**
+ * @brief Appends a statement to the end of a block.
+ *
+ * @param b Reference to block
+ * @param node Statement root
+ */
+void ir_block_append(ir_block* b, irref node);
+
+/**
+ * @brief Inserts an empty block before a loop header. Edges entering the
+ *      header from outside the loop are redirected to the new block,
+ *      edges from inside the loop keep entering the header.
+ *
+ * @param f Reference to IR function
+ * @param header Index of loop header block
+ * @param loop Flags of the blocks inside the loop
+ */
+void ir_insert_preheader(ir_function* f, size_t header, boolean* loop);
+
+/**
+ * @brief Adds a temporary variable to the scope of the function.
+ *
+ * @param f Reference to IR function
+ * @param prefix Name prefix of the temporary
+ * @return Address of temporary, IRREF_NONE if the scope is full
+ */
+int32_t ir_temporary(ir_function* f, const char* prefix);
+
+// ------------------- IR PASSES ----------------
+
+/**
+ * @brief Replaces calls to small functions by their bodies. Callees must
+ *      be constant code objects without closures, whose body is a single
+ *      block ending in a return and calling only natives. Arguments are
+ *      stored into fresh locals which take the place of the parameters,
+ *      and inlined code keeps the source positions of the callee, chained
+ *      to the call site, for stack traces.
+ *
+ * @param f Reference to IR function
+ * @return True if any call was inlined
+ */
+boolean ir_inline_calls(ir_function* f);
+
+/**
+ * @brief Forwards constants and variables copied into other variables to
+ *      the loads of the copy, solved as a forward dataflow problem over
+ *      the control-flow graph. Calls invalidate copies of globals.
+ *
+ * @param f Reference to IR function
+ * @return True if any load was rewritten
+ */
+boolean ir_propagate_copies(ir_function* f);
+
+/**
+ * @brief Numbers the values computed in each block and replaces repeated
+ *      arithmetic and comparisons by a load of a temporary variable
+ *      stored where the value is first computed.
+ *
+ * @param f Reference to IR function
+ * @return True if any expression was replaced
+ */
+boolean ir_eliminate_common_subexpressions(ir_function* f);
+
+/**
+ * @brief Infers the types of function locals and of every value with a
+ *      flow-sensitive forward dataflow analysis. Locals which are used
+ *      with a known int or float operand, and whose only other
+ *      definitions are parameters or unknown values, are speculated to
+ *      have that type and guarded where the unknown value is stored.
+ *
+ * @param f Reference to IR function
+ * @return False, types annotate the IR without changing it
+ */
+boolean ir_infer_types(ir_function* f);
+
+/**
+ * @brief Returns the type-specialized opcode for an operation whose two
+ *      operands have the given types.
+ *
+ * @param op Operation
+ * @param a Type of first operand
+ * @param b Type of second operand
+ * @return Specialized opcode, OP_NOP if there is none
+ */
+vm_op typed_operation(vm_op op, vm_type a, vm_type b);
+
+/**
+ * @brief Hoists expressions which compute the same value on every
+ *      iteration of a loop into a preheader block executed once before
+ *      the loop. Only expressions which have no side effects and cannot
+ *      raise a runtime error are hoisted: operations on operands of
+ *      proven types, reads of tables not written in the loop and calls
+ *      to pure natives.
+ *
+ * @param f Reference to IR function
+ * @return True if any expression was hoisted
+ */
+boolean ir_hoist_loop_invariants(ir_function* f);
+
+/**
+ * @brief Strength-reduces linear expressions of basic induction variables
+ *      in loops. A basic induction variable is a local of proven int type
+ *      whose only store in the loop adds a constant to it just before the
+ *      single jump back to the header. Expressions such as i * k + b used
+ *      often enough are replaced by a temporary initialized in the
+ *      preheader and advanced by k times the step next to the increment.
+ *
+ * @param f Reference to IR function
+ * @return True if any expression was reduced
+ */
+boolean ir_reduce_induction_variables(ir_function* f);
+
+/**
+ * @brief Selects the loops of a typed function which count an int local
+ *      up or down to a loop invariant int bound by a constant step. The
+ *      typed copy of a selected loop is lowered to FORPREP, which stores
+ *      the limit and step into hidden locals and checks the range once,
+ *      and FORLOOP, which increments the counter, compares and branches
+ *      in a single instruction.
+ *
+ * @param f Reference to IR function
+ * @return False, selected loops annotate the IR without changing it
+ */
+boolean ir_select_counted_loops(ir_function* f);
+
+/**
+ * @brief Removes stores to function locals which are never loaded. The
+ *      stored value is still evaluated if it may have side effects.
+ *
+ * @param f Reference to IR function
+ * @return True if any store was removed
+ */
+boolean ir_eliminate_dead_stores(ir_function* f);
+
+#endif
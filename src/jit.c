@@ -0,0 +1,1856 @@
+#include <stddef.h>
+#include <sys/mman.h>
+#include "jit.h"
+#include "stencil.h"
+
+boolean jit_enabled = true;
+boolean jit_stencils = false;
+call_info* trace_frame = NULL;
+
+boolean jit_execute(virtual_machine* vm, call_info* call)
+{
+    // the global frame runs once and keeps its variables in the heap
+    while (jit_enabled && call->prev != NULL)
+    {
+        program* p = call->program->p;
+
+        if (p->jit == NULL && p->native == NULL && ++p->calls == tiers.call_threshold && tier_budget_left()) {
+            p->jit = jit_compile(p);
+        }
+
+        if (p->jit == NULL) {
+            return false;
+        }
+
+        jit_function f = (jit_function) p->jit;
+
+        if (f(vm, call, &vm->stack[call->bp], &vm->stack[call->tp], &vm->stack[MAX_STACK_SIZE]) == JIT_RETURN) {
+            return true;
+        }
+
+        // a tail call left the callee at the start of the frame
+        call->pc = 0;
+    }
+
+    return false;
+}
+
+boolean jit_osr(virtual_machine* vm, call_info* call)
+{
+    program* p = call->program->p;
+    trace_anchor* a = p->anchors != NULL && call->pc < p->length ? &p->anchors[call->pc] : NULL;
+
+    boolean traced = tiers.trace_threshold > 0 && a != NULL && a->aborts < TRACE_MAX_ABORTS;
+
+    // loops are left to the tracing JIT until it gives up on them
+    if (a == NULL || a->trace != NULL || traced || trace_frame != NULL) {
+        return false;
+    }
+
+    if (p->jit == NULL && p->native == NULL && ++a->hits == tiers.osr_threshold && tier_budget_left()) {
+        p->jit = jit_compile(p);
+    }
+
+    if (p->jit == NULL) {
+        return false;
+    }
+
+    tier_record(p, TIER_OSR, call->pc, 0, 0);
+
+    jit_function f = (jit_function) p->jit;
+
+    if (f(vm, call, &vm->stack[call->bp], &vm->stack[call->tp], &vm->stack[MAX_STACK_SIZE]) == JIT_RETURN) {
+        return true;
+    }
+
+    call->pc = 0;
+    return jit_execute(vm, call);
+}
+
+size_t jit_loop_header(program* p, size_t k)
+{
+    instruction i = p->code[k];
+
+    if (i.stackop.op == OP_JMP && i.sx.sx < 0) {
+        return k + i.sx.sx + 1;
+    } else if (i.stackop.op == OP_FORLOOP && k + 1 < p->length && p->code[k + 1].sx.sx < -1) {
+        return k + p->code[k + 1].sx.sx + 2;
+    }
+
+    return p->length;
+}
+
+#if defined(__x86_64__)
+
+/*
+ * Register assignment of native code:
+ *  rbx  virtual machine
+ *  r12  call information of the frame
+ *  r13  end of the VM stack, pushes reaching it overflow
+ *  r14  top of the operand stack, one past the last value
+ *  r15  locals of the frame
+ * rax, rcx, rdx and xmm0-1 are scratch, helpers are called with the
+ * operand stack synced into call->tp.
+ */
+
+typedef enum x86_reg {
+    X86_RAX, X86_RCX, X86_RDX, X86_RBX, X86_RSP, X86_RBP, X86_RSI, X86_RDI,
+    X86_R8, X86_R9, X86_R10, X86_R11, X86_R12, X86_R13, X86_R14, X86_R15,
+} x86_reg;
+
+typedef enum x86_cond {
+    X86_O = 0x0, X86_B = 0x2, X86_AE = 0x3, X86_E = 0x4, X86_NE = 0x5,
+    X86_A = 0x7, X86_S = 0x8, X86_P = 0xa,
+    X86_L = 0xc, X86_GE = 0xd, X86_LE = 0xe, X86_G = 0xf,
+} x86_cond;
+
+#define VALUE_SIZE ((int32_t) sizeof(Value))
+#define VALUE_DATA 1 // offset of the payload behind the type tag
+
+typedef struct jit_fixup {
+    size_t position; // rel32 field to patch
+    size_t label;
+} jit_fixup;
+
+typedef struct jit_buffer {
+    uint8_t* code;
+    size_t size;
+    size_t capacity;
+    size_t* labels; // native offset of each instruction, followed by the exits
+    size_t nlabels;
+    jit_fixup* fixups;
+    size_t nfixups;
+    size_t fixup_capacity;
+} jit_buffer;
+
+// ------------------- EMITTER ------------------
+
+static void emit8(jit_buffer* b, uint8_t byte)
+{
+    if (b->size == b->capacity) {
+        b->capacity *= 2;
+        b->code = realloc(b->code, b->capacity);
+    }
+
+    b->code[b->size++] = byte;
+}
+
+static void emit32(jit_buffer* b, uint32_t x)
+{
+    for (int i = 0; i < 4; i++) emit8(b, (x >> (8 * i)) & 0xff);
+}
+
+static void emit64(jit_buffer* b, uint64_t x)
+{
+    for (int i = 0; i < 8; i++) emit8(b, (x >> (8 * i)) & 0xff);
+}
+
+// opcodes above 0xff are two bytes long, prefix is a mandatory SSE prefix or 0
+static void emit_opcode(jit_buffer* b, uint8_t prefix, boolean wide, uint16_t opcode, int reg, int rm)
+{
+    uint8_t rex = 0x40 | (wide << 3) | ((reg >> 3) << 2) | (rm >> 3);
+
+    if (prefix) emit8(b, prefix);
+    if (rex != 0x40) emit8(b, rex);
+    if (opcode > 0xff) emit8(b, opcode >> 8);
+    emit8(b, opcode & 0xff);
+}
+
+// instruction with a [base + disp32] memory operand
+static void emit_mem(jit_buffer* b, uint8_t prefix, boolean wide, uint16_t opcode, int reg, x86_reg base, int32_t disp)
+{
+    emit_opcode(b, prefix, wide, opcode, reg, base);
+    emit8(b, 0x80 | ((reg & 7) << 3) | (base & 7));
+
+    if ((base & 7) == X86_RSP) emit8(b, 0x24);
+    emit32(b, disp);
+}
+
+// instruction with two register operands
+static void emit_reg(jit_buffer* b, uint8_t prefix, boolean wide, uint16_t opcode, int reg, int rm)
+{
+    emit_opcode(b, prefix, wide, opcode, reg, rm);
+    emit8(b, 0xc0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+static void emit_mov(jit_buffer* b, x86_reg dst, x86_reg src)
+{
+    emit_reg(b, 0, true, 0x89, src, dst);
+}
+
+static void emit_mov_imm(jit_buffer* b, x86_reg dst, uint64_t imm)
+{
+    emit8(b, 0x48 | (dst >> 3));
+    emit8(b, 0xb8 | (dst & 7));
+    emit64(b, imm);
+}
+
+static void emit_add_imm(jit_buffer* b, x86_reg dst, int8_t imm)
+{
+    emit_reg(b, 0, true, 0x83, imm < 0 ? 5 : 0, dst);
+    emit8(b, imm < 0 ? -imm : imm);
+}
+
+static void emit_call(jit_buffer* b, void* f)
+{
+    emit_mov_imm(b, X86_RAX, (uint64_t) f);
+    emit8(b, 0xff);
+    emit8(b, 0xd0);
+}
+
+static void emit_jump(jit_buffer* b, int cond, size_t label)
+{
+    if (cond < 0) {
+        emit8(b, 0xe9);
+    } else {
+        emit8(b, 0x0f);
+        emit8(b, 0x80 | cond);
+    }
+
+    if (b->nfixups == b->fixup_capacity) {
+        b->fixup_capacity *= 2;
+        b->fixups = realloc(b->fixups, sizeof(jit_fixup) * b->fixup_capacity);
+    }
+
+    b->fixups[b->nfixups++] = (jit_fixup) { .position = b->size, .label = label };
+    emit32(b, 0);
+}
+
+// short forward jump within a template, patched by emit_patch
+static size_t emit_short_jump(jit_buffer* b, int cond)
+{
+    emit8(b, cond < 0 ? 0xeb : 0x70 | cond);
+    emit8(b, 0);
+    return b->size - 1;
+}
+
+static void emit_patch(jit_buffer* b, size_t position)
+{
+    b->code[position] = b->size - position - 1;
+}
+
+static void emit_setcc(jit_buffer* b, x86_cond cond)
+{
+    emit_reg(b, 0, false, 0x0f90 | cond, 0, X86_RAX);
+    emit_reg(b, 0, false, 0x0fb6, X86_RAX, X86_RAX);
+}
+
+static void emit_copy_value(jit_buffer* b, x86_reg dst, int32_t dst_disp, x86_reg src, int32_t src_disp)
+{
+    emit_mem(b, 0, false, 0x8a, X86_RAX, src, src_disp);
+    emit_mem(b, 0, false, 0x88, X86_RAX, dst, dst_disp);
+    emit_mem(b, 0, true, 0x8b, X86_RAX, src, src_disp + VALUE_DATA);
+    emit_mem(b, 0, true, 0x89, X86_RAX, dst, dst_disp + VALUE_DATA);
+}
+
+// ------------------- HELPERS ------------------
+
+static Value* jit_step(virtual_machine* vm, call_info* call, Value* top, instruction i)
+{
+    call->tp = top - vm->stack;
+    decode_execute(vm, call, i);
+    return &vm->stack[call->tp];
+}
+
+static void jit_error(virtual_machine* vm, call_info* call, Value* top, const char* msg)
+{
+    call->tp = top - vm->stack;
+    runtimeerr(vm, msg);
+}
+
+static long jit_truthy(Value* v)
+{
+    return native_bool_cast(v).value.to_bool;
+}
+
+// ------------------- TEMPLATES ----------------
+
+// stack traces and helpers read the pc of the running instruction
+static void emit_pc(jit_buffer* b, size_t k)
+{
+    emit_mem(b, 0, true, 0xc7, 0, X86_R12, offsetof(call_info, pc));
+    emit32(b, k);
+}
+
+static void emit_helper_args(jit_buffer* b, size_t k, uint64_t last)
+{
+    emit_pc(b, k);
+    emit_mov(b, X86_RDI, X86_RBX);
+    emit_mov(b, X86_RSI, X86_R12);
+    emit_mov(b, X86_RDX, X86_R14);
+    emit_mov_imm(b, X86_RCX, last);
+}
+
+// executes a single instruction in the interpreter
+static void emit_step(jit_buffer* b, size_t k, instruction i)
+{
+    uint64_t bits = 0;
+    memcpy(&bits, &i, sizeof(instruction));
+
+    emit_helper_args(b, k, bits);
+    emit_call(b, jit_step);
+    emit_mov(b, X86_R14, X86_RAX);
+}
+
+static void emit_error(jit_buffer* b, size_t k, const char* msg)
+{
+    emit_helper_args(b, k, (uint64_t) msg);
+    emit_call(b, jit_error);
+}
+
+static void emit_push(jit_buffer* b, size_t k)
+{
+    emit_add_imm(b, X86_R14, VALUE_SIZE);
+    emit_reg(b, 0, true, 0x39, X86_R13, X86_R14);
+
+    size_t ok = emit_short_jump(b, X86_B);
+    emit_error(b, k, "Stack overflow!");
+    emit_patch(b, ok);
+}
+
+static void emit_pop(jit_buffer* b)
+{
+    emit_add_imm(b, X86_R14, -VALUE_SIZE);
+}
+
+// pops the second operand, the first is replaced by the result
+static void emit_int_arithmetic(jit_buffer* b, vm_op op)
+{
+    emit_pop(b);
+    emit_mem(b, 0, true, 0x8b, X86_RAX, X86_R14, VALUE_DATA - VALUE_SIZE);
+
+    switch (op)
+    {
+        case OP_ADD: emit_mem(b, 0, true, 0x03, X86_RAX, X86_R14, VALUE_DATA); break;
+        case OP_SUB: emit_mem(b, 0, true, 0x2b, X86_RAX, X86_R14, VALUE_DATA); break;
+        default: emit_mem(b, 0, true, 0x0faf, X86_RAX, X86_R14, VALUE_DATA); break;
+    }
+
+    emit_mem(b, 0, true, 0x89, X86_RAX, X86_R14, VALUE_DATA - VALUE_SIZE);
+}
+
+static void emit_int_comparison(jit_buffer* b, x86_cond cond)
+{
+    emit_pop(b);
+    emit_mem(b, 0, true, 0x8b, X86_RAX, X86_R14, VALUE_DATA - VALUE_SIZE);
+    emit_mem(b, 0, true, 0x3b, X86_RAX, X86_R14, VALUE_DATA);
+    emit_setcc(b, cond);
+    emit_mem(b, 0, false, 0xc6, 0, X86_R14, -VALUE_SIZE);
+    emit8(b, VM_BOOL);
+    emit_mem(b, 0, true, 0x89, X86_RAX, X86_R14, VALUE_DATA - VALUE_SIZE);
+}
+
+// operands in the wrong order are swapped so that only above conditions are needed
+static void emit_float_comparison(jit_buffer* b, x86_cond cond, boolean swap)
+{
+    emit_pop(b);
+    emit_mem(b, 0xf2, false, 0x0f10, 0, X86_R14, swap ? VALUE_DATA : VALUE_DATA - VALUE_SIZE);
+    emit_mem(b, 0x66, false, 0x0f2e, 0, X86_R14, swap ? VALUE_DATA - VALUE_SIZE : VALUE_DATA);
+    emit_setcc(b, cond);
+    emit_mem(b, 0, false, 0xc6, 0, X86_R14, -VALUE_SIZE);
+    emit8(b, VM_BOOL);
+    emit_mem(b, 0, true, 0x89, X86_RAX, X86_R14, VALUE_DATA - VALUE_SIZE);
+}
+
+static void emit_float_arithmetic(jit_buffer* b, uint16_t opcode)
+{
+    emit_pop(b);
+    emit_mem(b, 0xf2, false, 0x0f10, 0, X86_R14, VALUE_DATA - VALUE_SIZE);
+    emit_mem(b, 0xf2, false, opcode, 0, X86_R14, VALUE_DATA);
+    emit_mem(b, 0xf2, false, 0x0f11, 0, X86_R14, VALUE_DATA - VALUE_SIZE);
+}
+
+// generic operations take the int path when both operands are ints
+static void emit_generic(jit_buffer* b, size_t k, instruction i, int cond)
+{
+    emit_mem(b, 0, false, 0x80, 7, X86_R14, -2 * VALUE_SIZE);
+    emit8(b, VM_INT);
+    size_t slow0 = emit_short_jump(b, X86_NE);
+
+    emit_mem(b, 0, false, 0x80, 7, X86_R14, -VALUE_SIZE);
+    emit8(b, VM_INT);
+    size_t slow1 = emit_short_jump(b, X86_NE);
+
+    if (cond < 0) {
+        emit_int_arithmetic(b, i.stackop.op);
+    } else {
+        emit_int_comparison(b, cond);
+    }
+
+    size_t done = emit_short_jump(b, -1);
+    emit_patch(b, slow0);
+    emit_patch(b, slow1);
+    emit_step(b, k, i);
+    emit_patch(b, done);
+}
+
+static boolean emit_instruction(jit_buffer* b, program* p, size_t k)
+{
+    instruction i = p->code[k];
+    size_t exit_return = p->length, exit = p->length + 1;
+    size_t skip = k + 2 <= p->length ? k + 2 : exit_return;
+    size_t target;
+    int32_t local = VALUE_SIZE * i.sx.sx;
+    int32_t counter, limit, step;
+    x86_reg vars = X86_R15;
+    size_t pos, pos1;
+
+    switch (i.stackop.op)
+    {
+        case OP_NOP: break;
+
+        case OP_PUSHK:
+        {
+            uint64_t bits = 0;
+            memcpy(&bits, &p->constants[i.ux.ux].value, sizeof(bits));
+
+            emit_mem(b, 0, false, 0xc6, 0, X86_R14, 0);
+            emit8(b, p->constants[i.ux.ux].type);
+            emit_mov_imm(b, X86_RAX, bits);
+            emit_mem(b, 0, true, 0x89, X86_RAX, X86_R14, VALUE_DATA);
+            emit_push(b, k);
+            break;
+        }
+
+        case OP_LOADL:
+            emit_copy_value(b, X86_R14, 0, X86_R15, local);
+            emit_push(b, k);
+            break;
+
+        // frames are checked to fit the stack when they are entered
+        case OP_STORL:
+            emit_pop(b);
+            emit_copy_value(b, X86_R15, local, X86_R14, 0);
+            break;
+
+        case OP_LOADG:
+        case OP_STORG:
+            if (i.sx.sx < 0 || i.sx.sx >= MAX_HEAP_SIZE) {
+                emit_step(b, k, i);
+                break;
+            }
+
+            emit_mem(b, 0, true, 0x8b, X86_RCX, X86_RBX, offsetof(virtual_machine, heap));
+
+            if (i.stackop.op == OP_LOADG) {
+                emit_copy_value(b, X86_R14, 0, X86_RCX, local);
+                emit_push(b, k);
+            } else {
+                emit_pop(b);
+                emit_copy_value(b, X86_RCX, local, X86_R14, 0);
+            }
+            break;
+
+        case OP_POP:
+            emit_pop(b);
+            break;
+
+        case OP_DUP:
+            emit_copy_value(b, X86_R14, 0, X86_R14, -VALUE_SIZE);
+            emit_push(b, k);
+            break;
+
+        case OP_JMP:
+            target = k + i.sx.sx + 1;
+            emit_jump(b, -1, target < p->length ? target : exit_return);
+            break;
+
+        // bools are tested inline, other values are cast by the VM
+        case OP_JIF:
+            emit_pop(b);
+            emit_mem(b, 0, false, 0x80, 7, X86_R14, 0);
+            emit8(b, VM_BOOL);
+            pos = emit_short_jump(b, X86_NE);
+            emit_mem(b, 0, false, 0x8a, X86_RAX, X86_R14, VALUE_DATA);
+            pos1 = emit_short_jump(b, -1);
+            emit_patch(b, pos);
+            emit_mov(b, X86_RDI, X86_R14);
+            emit_call(b, jit_truthy);
+            emit_patch(b, pos1);
+            emit_reg(b, 0, false, 0x84, X86_RAX, X86_RAX);
+            emit_jump(b, X86_NE, skip);
+            break;
+
+        case OP_ADD:
+        case OP_SUB:
+        case OP_MUL: emit_generic(b, k, i, -1); break;
+        case OP_EQ: emit_generic(b, k, i, X86_E); break;
+        case OP_NE: emit_generic(b, k, i, X86_NE); break;
+        case OP_LT: emit_generic(b, k, i, X86_L); break;
+        case OP_LE: emit_generic(b, k, i, X86_LE); break;
+        case OP_GT: emit_generic(b, k, i, X86_G); break;
+        case OP_GE: emit_generic(b, k, i, X86_GE); break;
+
+        case OP_ADDI: emit_int_arithmetic(b, OP_ADD); break;
+        case OP_SUBI: emit_int_arithmetic(b, OP_SUB); break;
+        case OP_MULI: emit_int_arithmetic(b, OP_MUL); break;
+        case OP_EQI: emit_int_comparison(b, X86_E); break;
+        case OP_NEI: emit_int_comparison(b, X86_NE); break;
+        case OP_LTI: emit_int_comparison(b, X86_L); break;
+        case OP_LEI: emit_int_comparison(b, X86_LE); break;
+        case OP_GTI: emit_int_comparison(b, X86_G); break;
+        case OP_GEI: emit_int_comparison(b, X86_GE); break;
+
+        // the interpreter also rejects the divisor whose bits read as a float zero
+        case OP_DIVI:
+        case OP_MODI:
+            emit_pop(b);
+            emit_mem(b, 0, true, 0x8b, X86_RCX, X86_R14, VALUE_DATA);
+
+            if (i.stackop.op == OP_DIVI) {
+                emit_mov(b, X86_RAX, X86_RCX);
+                emit_reg(b, 0, true, 0x01, X86_RAX, X86_RAX);
+            } else {
+                emit_reg(b, 0, true, 0x85, X86_RCX, X86_RCX);
+            }
+
+            pos = emit_short_jump(b, X86_NE);
+            emit_error(b, k, i.stackop.op == OP_DIVI ? "Zero division error!" : "Zero modulus error!");
+            emit_patch(b, pos);
+
+            emit_mem(b, 0, true, 0x8b, X86_RAX, X86_R14, VALUE_DATA - VALUE_SIZE);
+            emit8(b, 0x48);
+            emit8(b, 0x99);
+            emit_reg(b, 0, true, 0xf7, 7, X86_RCX);
+            emit_mem(b, 0, true, 0x89, i.stackop.op == OP_DIVI ? X86_RAX : X86_RDX, X86_R14, VALUE_DATA - VALUE_SIZE);
+            break;
+
+        case OP_ADDF: emit_float_arithmetic(b, 0x0f58); break;
+        case OP_SUBF: emit_float_arithmetic(b, 0x0f5c); break;
+        case OP_MULF: emit_float_arithmetic(b, 0x0f59); break;
+
+        case OP_DIVF:
+            emit_reg(b, 0x66, false, 0x0f57, 1, 1);
+            emit_mem(b, 0x66, false, 0x0f2e, 1, X86_R14, VALUE_DATA - VALUE_SIZE);
+            pos = emit_short_jump(b, X86_P);
+            pos1 = emit_short_jump(b, X86_NE);
+            emit_add_imm(b, X86_R14, -VALUE_SIZE);
+            emit_error(b, k, "Zero division error!");
+            emit_patch(b, pos);
+            emit_patch(b, pos1);
+            emit_float_arithmetic(b, 0x0f5e);
+            break;
+
+        case OP_LTF: emit_float_comparison(b, X86_A, true); break;
+        case OP_LEF: emit_float_comparison(b, X86_AE, true); break;
+        case OP_GTF: emit_float_comparison(b, X86_A, false); break;
+        case OP_GEF: emit_float_comparison(b, X86_AE, false); break;
+
+        case OP_GUARDI:
+        case OP_GUARDF:
+            emit_mem(b, 0, false, 0x80, 7, X86_R15, local);
+            emit8(b, i.stackop.op == OP_GUARDI ? VM_INT : VM_FLOAT);
+            emit_jump(b, X86_E, skip);
+            break;
+
+        // the range check runs once per loop, a range to iterate skips the jump past the loop
+        case OP_FORPREP:
+            emit_step(b, k, i);
+            emit_mem(b, 0, true, 0x81, 7, X86_R12, offsetof(call_info, pc));
+            emit32(b, k);
+            emit_jump(b, X86_NE, skip);
+            break;
+
+        case OP_FORLOOP:
+            if (k + 1 >= p->length || p->code[k + 1].stackop.op != OP_JMP) {
+                return false;
+            }
+
+            target = k + p->code[k + 1].sx.sx + 2;
+            counter = VALUE_SIZE * FOR_COUNTER(i.ux.ux);
+            limit = VALUE_SIZE * FOR_LIMIT(i.ux.ux);
+            step = limit + VALUE_SIZE;
+
+            // loop variables of the global frame live in the heap
+            if (p->prev == NULL) {
+                emit_mem(b, 0, true, 0x8b, X86_RDX, X86_RBX, offsetof(virtual_machine, heap));
+                vars = X86_RDX;
+            }
+
+            emit_mem(b, 0, false, 0x80, 7, vars, counter);
+            emit8(b, VM_INT);
+            pos = emit_short_jump(b, X86_E);
+            emit_error(b, k, "Loop counter must be an integer!");
+            emit_patch(b, pos);
+
+            emit_mem(b, 0, true, 0x8b, X86_RAX, vars, step + VALUE_DATA);
+            emit_mem(b, 0, true, 0x8b, X86_RCX, vars, counter + VALUE_DATA);
+            emit_reg(b, 0, true, 0x01, X86_RAX, X86_RCX);
+            emit_mem(b, 0, true, 0x89, X86_RCX, vars, counter + VALUE_DATA);
+
+            // a counter stepping past the largest or smallest integer leaves the loop
+            emit_jump(b, X86_O, skip);
+            emit_reg(b, 0, true, 0x85, X86_RAX, X86_RAX);
+            pos = emit_short_jump(b, X86_S);
+            emit_mem(b, 0, true, 0x3b, X86_RCX, vars, limit + VALUE_DATA);
+            emit_jump(b, i.ux.ux & FOR_EXCLUSIVE ? X86_L : X86_LE, target < p->length ? target : exit_return);
+            emit_jump(b, -1, skip);
+            emit_patch(b, pos);
+            emit_mem(b, 0, true, 0x3b, X86_RCX, vars, limit + VALUE_DATA);
+            emit_jump(b, i.ux.ux & FOR_EXCLUSIVE ? X86_G : X86_GE, target < p->length ? target : exit_return);
+            emit_jump(b, -1, skip);
+            break;
+
+        // a tail call leaves native code, the VM enters the callee
+        case OP_TAILCALL:
+            emit_step(b, k, i);
+            emit_mem(b, 0, true, 0x81, 7, X86_R12, offsetof(call_info, pc));
+            emit32(b, -1);
+            pos = emit_short_jump(b, X86_NE);
+            emit8(b, 0xb8);
+            emit32(b, JIT_TAILCALL);
+            emit_jump(b, -1, exit);
+            emit_patch(b, pos);
+            break;
+
+        // pushes the result onto the frame of the caller
+        case OP_RET:
+            emit_pop(b);
+            emit_mem(b, 0, true, 0x8b, X86_RAX, X86_R12, offsetof(call_info, prev));
+            emit_mem(b, 0, true, 0x8b, X86_RCX, X86_RAX, offsetof(call_info, tp));
+            emit_mov(b, X86_RDX, X86_RCX);
+            emit_add_imm(b, X86_RDX, 1);
+            emit_mem(b, 0, true, 0x89, X86_RDX, X86_RAX, offsetof(call_info, tp));
+            emit8(b, 0x48);
+            emit8(b, 0x8d);
+            emit8(b, 0x0c);
+            emit8(b, 0xc9);
+            emit_mem(b, 0, true, 0x03, X86_RCX, X86_RBX, offsetof(virtual_machine, stack));
+            emit_copy_value(b, X86_RCX, 0, X86_R14, 0);
+            emit_jump(b, -1, exit_return);
+            break;
+
+        default:
+            emit_step(b, k, i);
+            break;
+    }
+
+    return true;
+}
+
+static jit_buffer buffer_new(size_t nlabels)
+{
+    jit_buffer b = {
+        .code = malloc(256),
+        .size = 0,
+        .capacity = 256,
+        .labels = malloc(sizeof(size_t) * nlabels),
+        .nlabels = nlabels,
+        .fixups = malloc(sizeof(jit_fixup) * 16),
+        .nfixups = 0,
+        .fixup_capacity = 16,
+    };
+
+    return b;
+}
+
+// resolves the jumps and copies the code into executable memory, freeing the buffer
+static void* buffer_finish(jit_buffer* b, boolean complete)
+{
+    void* mem = MAP_FAILED;
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t size = (b->size + page - 1) / page * page;
+
+    if (complete) {
+        for (size_t i = 0; i < b->nfixups; i++) {
+            int32_t rel = b->labels[b->fixups[i].label] - (b->fixups[i].position + 4);
+            memcpy(&b->code[b->fixups[i].position], &rel, sizeof(rel));
+        }
+
+        mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    // code is never writable and executable at the same time
+    if (mem != MAP_FAILED) {
+        memcpy(mem, b->code, b->size);
+
+        if (mprotect(mem, size, PROT_READ | PROT_EXEC) != 0) {
+            munmap(mem, size);
+            mem = MAP_FAILED;
+        }
+    }
+
+    free(b->code);
+    free(b->labels);
+    free(b->fixups);
+
+    return mem == MAP_FAILED ? NULL : mem;
+}
+
+static const uint8_t prologue[] = {
+    0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57, // push rbx, r12-r15
+};
+
+static const uint8_t epilogue[] = {
+    0x41, 0x5f, 0x41, 0x5e, 0x41, 0x5d, 0x41, 0x5c, 0x5b, 0xc3, // pop r15-r12, rbx; ret
+};
+
+jit_function jit_compile(program* p)
+{
+    if (jit_stencils) {
+        return stencil_compile(p);
+    }
+
+    double start = tier_clock();
+    jit_buffer b = buffer_new(p->length + 2);
+
+    for (size_t i = 0; i < sizeof(prologue); i++) emit8(&b, prologue[i]);
+
+    emit_mov(&b, X86_RBX, X86_RDI);
+    emit_mov(&b, X86_R12, X86_RSI);
+    emit_mov(&b, X86_R15, X86_RDX);
+    emit_mov(&b, X86_R14, X86_RCX);
+    emit_mov(&b, X86_R13, X86_R8);
+
+    // frames entered mid-loop by on-stack replacement resume at the loop header
+    for (size_t k = 0; k < p->length; k++)
+    {
+        size_t target = jit_loop_header(p, k);
+
+        if (target <= k) {
+            emit_mem(&b, 0, true, 0x81, 7, X86_R12, offsetof(call_info, pc));
+            emit32(&b, target);
+            emit_jump(&b, X86_E, target);
+        }
+    }
+
+    boolean compiled = true;
+
+    for (size_t k = 0; compiled && k < p->length; k++) {
+        b.labels[k] = b.size;
+        compiled = emit_instruction(&b, p, k);
+    }
+
+    // running past the last instruction ends the frame like a return
+    b.labels[p->length] = b.size;
+    emit8(&b, 0xb8);
+    emit32(&b, JIT_RETURN);
+
+    b.labels[p->length + 1] = b.size;
+    for (size_t i = 0; i < sizeof(epilogue); i++) emit8(&b, epilogue[i]);
+
+#ifdef HE_DEBUG_MODE
+    if (compiled) {
+        Value v = vCode(p, NULL);
+        printf("%s Compiled %s into %zu bytes of native code\n", MESSAGE, value_to_str(&v), b.size);
+    }
+#endif
+
+    jit_function f = (jit_function) buffer_finish(&b, compiled);
+    tier_record(p, f != NULL ? TIER_NATIVE : TIER_FAILED, 0, f != NULL ? b.size : 0, start);
+    return f;
+}
+
+// ------------------- TRACES -------------------
+
+// type of a variable not known at a point of the trace
+#define TRACE_UNKNOWN ((vm_type) 0xff)
+
+// native stack slot of a value: payload, then type tag
+#define TRACE_SLOT(ref) (16 * (ref))
+
+typedef enum trace_kind {
+    TRACE_NOP,
+    TRACE_CONST,   // constant, used as an immediate
+    TRACE_LOAD,    // payload of a variable of known type
+    TRACE_STORE,   // stores a value into a variable
+    TRACE_GUARD,   // exits unless a variable holds a type
+    TRACE_BRANCH,  // exits unless a bool has the recorded outcome
+    TRACE_NONZERO, // exits before a division by zero
+    TRACE_ARITH,   // operation on values of known types
+    TRACE_TGET,    // table read, exits unless the value has the recorded type
+    TRACE_TPUT,    // table write
+} trace_kind;
+
+typedef struct trace_node {
+    trace_kind kind;
+    vm_op op;        // generic operation of arithmetic and zero checks
+    vm_type type;    // type of the value defined, or guarded
+    int32_t args[3];
+    boolean global;  // variable lives in the heap
+    int32_t var;
+    uint64_t bits;   // payload of a constant
+    boolean expect;  // outcome a branch expects
+    int32_t exit;    // side exit taken when a guard fails
+    boolean hoisted; // guard checked once when the trace is entered
+    boolean tag;     // store also writes the type tag
+    boolean fused;   // comparison evaluated by the branch using it
+} trace_node;
+
+typedef struct trace_exit {
+    size_t pc;      // instruction the interpreter resumes at
+    int32_t* stack; // values pushed onto the operand stack since the trace was entered
+    size_t depth;
+} trace_exit;
+
+typedef struct trace_recorder {
+    program* p;
+    size_t anchor;
+    size_t depth; // operand stack depth the trace is entered with
+    boolean root; // counted loop variables of the global frame live in the heap
+    trace_node* nodes;
+    size_t size;
+    size_t capacity;
+    trace_exit* exits;
+    size_t nexits;
+    size_t exit_capacity;
+    int32_t stack[MAX_STACK_SIZE];
+    size_t sp;
+} trace_recorder;
+
+static trace_recorder recorder;
+
+static int32_t trace_node_new(trace_kind kind, vm_op op, vm_type type)
+{
+    if (recorder.size == recorder.capacity) {
+        recorder.capacity *= 2;
+        recorder.nodes = realloc(recorder.nodes, sizeof(trace_node) * recorder.capacity);
+    }
+
+    recorder.nodes[recorder.size] = (trace_node) {
+        .kind = kind,
+        .op = op,
+        .type = type,
+        .args = { -1, -1, -1 },
+        .exit = -1,
+    };
+
+    return recorder.size++;
+}
+
+// side exit resuming at pc with the operand stack as it is now
+static int32_t trace_exit_new(size_t pc)
+{
+    if (recorder.nexits == recorder.exit_capacity) {
+        recorder.exit_capacity *= 2;
+        recorder.exits = realloc(recorder.exits, sizeof(trace_exit) * recorder.exit_capacity);
+    }
+
+    trace_exit* e = &recorder.exits[recorder.nexits];
+    e->pc = pc;
+    e->depth = recorder.sp;
+    e->stack = malloc(sizeof(int32_t) * (recorder.sp + 1));
+    memcpy(e->stack, recorder.stack, sizeof(int32_t) * recorder.sp);
+
+    return recorder.nexits++;
+}
+
+static int32_t trace_guard(trace_kind kind, vm_type type, int32_t arg, size_t pc)
+{
+    int32_t ref = trace_node_new(kind, OP_NOP, type);
+    recorder.nodes[ref].args[0] = arg;
+    recorder.nodes[ref].exit = trace_exit_new(pc);
+    return ref;
+}
+
+static void trace_push(int32_t ref)
+{
+    recorder.stack[recorder.sp++] = ref;
+}
+
+// values pushed before the trace was entered are not part of it
+static int32_t trace_pop()
+{
+    return recorder.sp == 0 ? -1 : recorder.stack[--recorder.sp];
+}
+
+static int32_t trace_constant(Value v)
+{
+    int32_t ref = trace_node_new(TRACE_CONST, OP_NOP, v.type);
+    memcpy(&recorder.nodes[ref].bits, &v.value, sizeof(uint64_t));
+
+    if (v.type == VM_BOOL) {
+        recorder.nodes[ref].bits = v.value.to_bool;
+    }
+
+    return ref;
+}
+
+// loads are specialized on the observed type of the variable
+static int32_t trace_load(boolean global, int32_t var, vm_type type, size_t pc)
+{
+    int32_t guard = trace_guard(TRACE_GUARD, type, -1, pc);
+    recorder.nodes[guard].global = global;
+    recorder.nodes[guard].var = var;
+
+    int32_t load = trace_node_new(TRACE_LOAD, OP_NOP, type);
+    recorder.nodes[load].global = global;
+    recorder.nodes[load].var = var;
+
+    return load;
+}
+
+static void trace_store(boolean global, int32_t var, int32_t value)
+{
+    int32_t ref = trace_node_new(TRACE_STORE, OP_NOP, recorder.nodes[value].type);
+    recorder.nodes[ref].global = global;
+    recorder.nodes[ref].var = var;
+    recorder.nodes[ref].args[0] = value;
+}
+
+static int32_t trace_arith(vm_op op, vm_type type, int32_t a, int32_t b)
+{
+    int32_t ref = trace_node_new(TRACE_ARITH, op, type);
+    recorder.nodes[ref].args[0] = a;
+    recorder.nodes[ref].args[1] = b;
+    return ref;
+}
+
+static vm_op trace_generic_op(vm_op op)
+{
+    switch (op)
+    {
+        case OP_ADDI: case OP_ADDF: return OP_ADD;
+        case OP_SUBI: case OP_SUBF: return OP_SUB;
+        case OP_MULI: case OP_MULF: return OP_MUL;
+        case OP_DIVI: case OP_DIVF: return OP_DIV;
+        case OP_MODI: return OP_MOD;
+        case OP_EQI: return OP_EQ;
+        case OP_NEI: return OP_NE;
+        case OP_LTI: case OP_LTF: return OP_LT;
+        case OP_LEI: case OP_LEF: return OP_LE;
+        case OP_GTI: case OP_GTF: return OP_GT;
+        case OP_GEI: case OP_GEF: return OP_GE;
+        default: return op;
+    }
+}
+
+// result type of an operation the trace specializes, TRACE_UNKNOWN if it is not supported
+static vm_type trace_result_type(vm_op op, vm_type a, vm_type b)
+{
+    boolean numbers = (a == VM_INT || a == VM_FLOAT) && (b == VM_INT || b == VM_FLOAT);
+
+    switch (op)
+    {
+        case OP_ADD:
+        case OP_SUB:
+        case OP_MUL:
+        case OP_DIV:
+            return !numbers ? TRACE_UNKNOWN : a == VM_INT && b == VM_INT ? VM_INT : VM_FLOAT;
+
+        case OP_MOD: return a == VM_INT && b == VM_INT ? VM_INT : TRACE_UNKNOWN;
+
+        case OP_LT:
+        case OP_LE:
+        case OP_GT:
+        case OP_GE:
+            return numbers ? VM_BOOL : TRACE_UNKNOWN;
+
+        case OP_EQ:
+        case OP_NE:
+            return numbers || (a == VM_BOOL && b == VM_BOOL) ? VM_BOOL : TRACE_UNKNOWN;
+
+        case OP_AND:
+        case OP_OR:
+            return a == VM_BOOL && b == VM_BOOL ? VM_BOOL : TRACE_UNKNOWN;
+
+        case OP_NEG: return a == VM_INT || a == VM_FLOAT ? a : TRACE_UNKNOWN;
+        case OP_NOT: return a == VM_BOOL ? VM_BOOL : TRACE_UNKNOWN;
+        default: return TRACE_UNKNOWN;
+    }
+}
+
+// the counter is incremented and compared as in the interpreter, the step keeps its recorded sign
+static boolean trace_for_loop(virtual_machine* vm, call_info* call, instruction i, size_t pc)
+{
+    program* p = call->program->p;
+    Value* vars = recorder.root ? vm->heap : &vm->stack[call->bp];
+    int32_t counter = FOR_COUNTER(i.ux.ux), limit = FOR_LIMIT(i.ux.ux);
+    boolean up = vars[limit + 1].value.to_int > 0;
+    boolean taken = call->pc <= pc;
+
+    if (pc + 1 >= p->length) {
+        return false;
+    }
+
+    int32_t c = trace_load(recorder.root, counter, VM_INT, pc);
+    int32_t step = trace_load(recorder.root, limit + 1, VM_INT, pc);
+    int32_t end = trace_load(recorder.root, limit, VM_INT, pc);
+
+    int32_t sign = trace_arith(OP_GT, VM_BOOL, step, trace_constant(vInt(0)));
+    recorder.nodes[trace_guard(TRACE_BRANCH, VM_BOOL, sign, pc)].expect = up;
+
+    int32_t next = trace_arith(OP_ADD, VM_INT, c, step);
+    trace_store(recorder.root, counter, next);
+
+    // a counter wrapping around past the largest or smallest integer leaves the loop
+    boolean exclusive = (i.ux.ux & FOR_EXCLUSIVE) != 0;
+    int32_t cond = trace_arith(up ? exclusive ? OP_LT : OP_LE : exclusive ? OP_GT : OP_GE, VM_BOOL, next, end);
+    int32_t ahead = trace_arith(up ? OP_GT : OP_LT, VM_BOOL, next, c);
+    cond = trace_arith(OP_AND, VM_BOOL, cond, ahead);
+    size_t exit = taken ? pc + 2 : pc + p->code[pc + 1].sx.sx + 2;
+    recorder.nodes[trace_guard(TRACE_BRANCH, VM_BOOL, cond, exit)].expect = taken;
+
+    return true;
+}
+
+// appends the nodes of an executed instruction, false if it cannot be traced
+static boolean trace_step(virtual_machine* vm, call_info* call, instruction i, size_t pc)
+{
+    Value* top = &vm->stack[call->tp - 1];
+    vm_op op = trace_generic_op(i.stackop.op);
+    int32_t a, b, c, ref;
+    vm_type type;
+
+    switch (op)
+    {
+        case OP_NOP:
+        case OP_JMP:
+            return true;
+
+        case OP_PUSHK:
+            trace_push(trace_constant(call->program->p->constants[i.ux.ux]));
+            return true;
+
+        case OP_LOADL:
+        case OP_LOADG:
+            if (op == OP_LOADG && (i.sx.sx < 0 || i.sx.sx >= MAX_HEAP_SIZE)) {
+                return false;
+            }
+
+            trace_push(trace_load(op == OP_LOADG, i.sx.sx, top->type, pc));
+            return true;
+
+        case OP_STORL:
+        case OP_STORG:
+            if ((a = trace_pop()) < 0 || (op == OP_STORG && (i.sx.sx < 0 || i.sx.sx >= MAX_HEAP_SIZE))) {
+                return false;
+            }
+
+            trace_store(op == OP_STORG, i.sx.sx, a);
+            return true;
+
+        case OP_POP:
+            return trace_pop() >= 0;
+
+        case OP_DUP:
+            if ((a = trace_pop()) < 0) {
+                return false;
+            }
+
+            trace_push(a);
+            trace_push(a);
+            return true;
+
+        // the interpreter continues with the jump following the branch if it fails
+        case OP_JIF:
+            if ((a = trace_pop()) < 0 || recorder.nodes[a].type != VM_BOOL) {
+                return false;
+            }
+
+            ref = trace_guard(TRACE_BRANCH, VM_BOOL, a, call->pc == pc + 2 ? pc + 1 : pc + 2);
+            recorder.nodes[ref].expect = call->pc == pc + 2;
+            return true;
+
+        // only passing guards are traced, the generic code behind them is not
+        case OP_GUARDI:
+        case OP_GUARDF:
+            if (call->pc != pc + 2) {
+                return false;
+            }
+
+            ref = trace_guard(TRACE_GUARD, op == OP_GUARDI ? VM_INT : VM_FLOAT, -1, pc);
+            recorder.nodes[ref].var = i.sx.sx;
+            return true;
+
+        case OP_FORLOOP:
+            return trace_for_loop(vm, call, i, pc);
+
+        case OP_ADD:
+        case OP_SUB:
+        case OP_MUL:
+        case OP_DIV:
+        case OP_MOD:
+        case OP_LT:
+        case OP_LE:
+        case OP_GT:
+        case OP_GE:
+        case OP_EQ:
+        case OP_NE:
+        case OP_AND:
+        case OP_OR:
+            if ((b = trace_pop()) < 0 || (a = trace_pop()) < 0) {
+                return false;
+            }
+
+            type = trace_result_type(op, recorder.nodes[a].type, recorder.nodes[b].type);
+
+            if (type == TRACE_UNKNOWN || type != top->type) {
+                return false;
+            }
+
+            // a zero divisor exits with the operands still on the stack, the interpreter raises the error
+            if (op == OP_DIV || op == OP_MOD) {
+                recorder.sp += 2;
+                ref = trace_guard(TRACE_NONZERO, recorder.nodes[b].type, b, pc);
+                recorder.nodes[ref].op = op;
+                recorder.sp -= 2;
+            }
+
+            trace_push(trace_arith(op, type, a, b));
+            return true;
+
+        case OP_NEG:
+        case OP_NOT:
+            if ((a = trace_pop()) < 0) {
+                return false;
+            }
+
+            type = trace_result_type(op, recorder.nodes[a].type, VM_NULL);
+
+            if (type == TRACE_UNKNOWN || type != top->type) {
+                return false;
+            }
+
+            trace_push(trace_arith(op, type, a, -1));
+            return true;
+
+        // the value read is specialized on its observed type
+        case OP_TGET:
+            if ((b = trace_pop()) < 0 || (a = trace_pop()) < 0 || recorder.nodes[a].type != VM_TABLE) {
+                return false;
+            }
+
+            ref = trace_node_new(TRACE_TGET, OP_NOP, top->type);
+            recorder.nodes[ref].args[0] = a;
+            recorder.nodes[ref].args[1] = b;
+            trace_push(ref);
+            recorder.nodes[ref].exit = trace_exit_new(pc + 1);
+            return true;
+
+        case OP_TPUT:
+            if ((c = trace_pop()) < 0 || (b = trace_pop()) < 0 || (a = trace_pop()) < 0 || recorder.nodes[a].type != VM_TABLE) {
+                return false;
+            }
+
+            ref = trace_node_new(TRACE_TPUT, OP_NOP, VM_NULL);
+            recorder.nodes[ref].args[0] = a;
+            recorder.nodes[ref].args[1] = b;
+            recorder.nodes[ref].args[2] = c;
+            trace_push(a);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+// ------------------- TRACE OPTIMIZATION -------
+
+#define TRACE_VAR(n) ((n)->global * MAX_HEAP_SIZE + (n)->var)
+
+static boolean trace_fold(trace_node* nodes, trace_node* n)
+{
+    trace_node* a = &nodes[n->args[0]];
+    trace_node* b = n->args[1] >= 0 ? &nodes[n->args[1]] : NULL;
+    Value v0 = { .type = a->type }, v1 = { .type = VM_NULL }, r;
+
+    if (a->kind != TRACE_CONST || (b != NULL && b->kind != TRACE_CONST) || n->op == OP_DIV || n->op == OP_MOD) {
+        return false;
+    }
+
+    memcpy(&v0.value, &a->bits, sizeof(uint64_t));
+
+    if (b != NULL) {
+        v1.type = b->type;
+        memcpy(&v1.value, &b->bits, sizeof(uint64_t));
+    }
+
+    // operand types were checked, the VM's own operators cannot fail
+    switch (n->op)
+    {
+        case OP_NEG: r = vNegate(v0); break;
+        case OP_NOT: r = vBool(!v0.value.to_bool); break;
+        default: r = apply_vm_op(n->op, v0, v1); break;
+    }
+
+    n->kind = TRACE_CONST;
+    memcpy(&n->bits, &r.value, sizeof(uint64_t));
+
+    if (r.type == VM_BOOL) {
+        n->bits = r.value.to_bool;
+    }
+
+    return true;
+}
+
+static boolean trace_compare_op(vm_op op)
+{
+    return op == OP_LT || op == OP_LE || op == OP_GT || op == OP_GE || op == OP_EQ || op == OP_NE;
+}
+
+/*
+ * Guards of variables whose type is the same at the end of an iteration
+ * are hoisted out of the loop, repeated guards are removed and stores
+ * write the type tag only when it changes. Loads are forwarded from the
+ * last load or store of the variable in the iteration, constants are
+ * folded, and values no guard or store uses are removed.
+ */
+static void trace_optimize(trace_recorder* r)
+{
+    size_t nvars = 2 * MAX_HEAP_SIZE;
+    vm_type* known = malloc(sizeof(vm_type) * nvars);
+    int32_t* first = malloc(sizeof(int32_t) * nvars);
+    int32_t* value = malloc(sizeof(int32_t) * nvars);
+    boolean* stored = calloc(nvars, sizeof(boolean));
+    int32_t* alias = malloc(sizeof(int32_t) * r->size);
+    boolean* live = calloc(r->size, sizeof(boolean));
+    uint32_t* uses = calloc(r->size, sizeof(uint32_t));
+    trace_node* nodes = r->nodes;
+
+    memset(known, TRACE_UNKNOWN, sizeof(vm_type) * nvars);
+    memset(first, 0xff, sizeof(int32_t) * nvars);
+
+    for (size_t i = 0; i < r->size; i++)
+    {
+        trace_node* n = &nodes[i];
+        size_t v = TRACE_VAR(n);
+
+        if (n->kind == TRACE_GUARD) {
+            if (known[v] == n->type) {
+                n->kind = TRACE_NOP;
+                continue;
+            }
+
+            if (!stored[v] && first[v] < 0) {
+                first[v] = i;
+            }
+
+            known[v] = n->type;
+        } else if (n->kind == TRACE_STORE) {
+            known[v] = n->type;
+            stored[v] = true;
+        }
+    }
+
+    memset(value, 0xff, sizeof(int32_t) * nvars);
+
+    for (size_t v = 0; v < nvars; v++) {
+        boolean invariant = first[v] >= 0 && known[v] == nodes[first[v]].type;
+        nodes[first[v] >= 0 ? first[v] : 0].hoisted |= invariant;
+        known[v] = invariant ? nodes[first[v]].type : TRACE_UNKNOWN;
+    }
+
+    for (size_t i = 0; i < r->size; i++)
+    {
+        trace_node* n = &nodes[i];
+        size_t v = TRACE_VAR(n);
+        alias[i] = i;
+
+        for (int j = 0; j < 3; j++) {
+            if (n->args[j] >= 0) n->args[j] = alias[n->args[j]];
+        }
+
+        switch (n->kind)
+        {
+            case TRACE_GUARD:
+                if (n->hoisted) {
+                    break;
+                } else if (known[v] == n->type) {
+                    n->kind = TRACE_NOP;
+                }
+
+                known[v] = n->type;
+                break;
+
+            case TRACE_LOAD:
+                if (value[v] >= 0) {
+                    alias[i] = value[v];
+                    n->kind = TRACE_NOP;
+                } else {
+                    value[v] = i;
+                }
+                break;
+
+            case TRACE_STORE:
+                n->tag = known[v] != n->type;
+                known[v] = n->type;
+                value[v] = n->args[0];
+                break;
+
+            case TRACE_ARITH:
+                trace_fold(nodes, n);
+                break;
+
+            case TRACE_BRANCH:
+            case TRACE_NONZERO:
+                if (nodes[n->args[0]].kind == TRACE_CONST) {
+                    n->kind = TRACE_NOP;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    for (size_t e = 0; e < r->nexits; e++) {
+        for (size_t j = 0; j < r->exits[e].depth; j++) {
+            r->exits[e].stack[j] = alias[r->exits[e].stack[j]];
+        }
+    }
+
+    // nodes are only used by later nodes, one backward pass finds the live ones
+    for (size_t i = r->size; i-- > 0;)
+    {
+        trace_node* n = &nodes[i];
+
+        if (n->kind == TRACE_NOP) {
+            continue;
+        } else if (n->kind == TRACE_CONST || n->kind == TRACE_LOAD || n->kind == TRACE_ARITH) {
+            if (!live[i]) {
+                n->kind = TRACE_NOP;
+                continue;
+            }
+        }
+
+        for (int j = 0; j < 3; j++) {
+            if (n->args[j] >= 0) {
+                live[n->args[j]] = true;
+                uses[n->args[j]]++;
+            }
+        }
+
+        if (n->exit >= 0 && !n->hoisted) {
+            for (size_t j = 0; j < r->exits[n->exit].depth; j++) {
+                live[r->exits[n->exit].stack[j]] = true;
+                uses[r->exits[n->exit].stack[j]]++;
+            }
+        }
+    }
+
+    // a comparison computed right before the branch using it only sets the flags
+    for (size_t i = 0; i < r->size; i++)
+    {
+        trace_node* n = &nodes[i];
+
+        if (n->kind != TRACE_BRANCH) {
+            continue;
+        }
+
+        size_t prev = i;
+        while (prev-- > 0 && (nodes[prev].kind == TRACE_NOP || nodes[prev].kind == TRACE_CONST || nodes[prev].hoisted));
+
+        trace_node* c = &nodes[n->args[0]];
+        boolean floats = c->kind == TRACE_ARITH && (nodes[c->args[0]].type == VM_FLOAT || nodes[c->args[1]].type == VM_FLOAT);
+
+        if (prev == (size_t) n->args[0] && c->kind == TRACE_ARITH && trace_compare_op(c->op) && uses[prev] == 1 &&
+            !(floats && (c->op == OP_EQ || c->op == OP_NE))) {
+            c->fused = true;
+        }
+    }
+
+    free(known);
+    free(first);
+    free(value);
+    free(stored);
+    free(alias);
+    free(live);
+    free(uses);
+}
+
+// ------------------- TRACE COMPILATION --------
+
+/*
+ * Register assignment of traces:
+ *  rbx  virtual machine
+ *  r12  call information of the frame
+ *  r13  locals of the frame
+ *  r14  heap
+ *  r15  top of the operand stack when the trace was entered
+ * Values are kept untagged in native stack slots.
+ */
+
+static void jit_trace_get(Table* t, uint64_t type, uint64_t bits, uint64_t* out)
+{
+    Value k = { .type = type };
+    memcpy(&k.value, &bits, sizeof(uint64_t));
+
+    Value v = vTableGet(t, k);
+    memcpy(&out[0], &v.value, sizeof(uint64_t));
+
+    if (v.type == VM_BOOL) {
+        out[0] = v.value.to_bool;
+    }
+
+    out[1] = v.type;
+}
+
+static void jit_trace_put(Table* t, uint64_t key_type, uint64_t key, uint64_t value_type, uint64_t value)
+{
+    Value k = { .type = key_type }, v = { .type = value_type };
+    memcpy(&k.value, &key, sizeof(uint64_t));
+    memcpy(&v.value, &value, sizeof(uint64_t));
+    vTablePut(t, k, v);
+}
+
+static x86_reg trace_base(trace_node* n)
+{
+    return n->global ? X86_R14 : X86_R13;
+}
+
+// loads the payload of a value into a general purpose register
+static void trace_fetch(jit_buffer* b, trace_node* nodes, int32_t ref, x86_reg reg)
+{
+    if (nodes[ref].kind == TRACE_CONST) {
+        emit_mov_imm(b, reg, nodes[ref].bits);
+    } else {
+        emit_mem(b, 0, true, 0x8b, reg, X86_RSP, TRACE_SLOT(ref));
+    }
+}
+
+// loads a number into an SSE register, converting ints
+static void trace_fetch_float(jit_buffer* b, trace_node* nodes, int32_t ref, int xmm)
+{
+    trace_fetch(b, nodes, ref, X86_RAX);
+    emit_reg(b, nodes[ref].type == VM_INT ? 0xf2 : 0x66, true, nodes[ref].type == VM_INT ? 0x0f2a : 0x0f6e, xmm, X86_RAX);
+}
+
+// compares two values, returns the condition under which the comparison holds
+static x86_cond trace_compare(jit_buffer* b, trace_node* nodes, trace_node* n)
+{
+    int32_t a = n->args[0], c = n->args[1];
+
+    if (nodes[a].type != VM_FLOAT && nodes[c].type != VM_FLOAT) {
+        trace_fetch(b, nodes, a, X86_RAX);
+        trace_fetch(b, nodes, c, X86_RCX);
+        emit_reg(b, 0, true, 0x39, X86_RCX, X86_RAX);
+
+        switch (n->op)
+        {
+            case OP_LT: return X86_L;
+            case OP_LE: return X86_LE;
+            case OP_GT: return X86_G;
+            case OP_GE: return X86_GE;
+            case OP_EQ: return X86_E;
+            default: return X86_NE;
+        }
+    }
+
+    trace_fetch_float(b, nodes, a, 0);
+    trace_fetch_float(b, nodes, c, 1);
+
+    // unordered operands compare false under the above conditions
+    switch (n->op)
+    {
+        case OP_LT: emit_reg(b, 0x66, false, 0x0f2e, 1, 0); return X86_A;
+        case OP_LE: emit_reg(b, 0x66, false, 0x0f2e, 1, 0); return X86_AE;
+        case OP_GT: emit_reg(b, 0x66, false, 0x0f2e, 0, 1); return X86_A;
+        case OP_GE: emit_reg(b, 0x66, false, 0x0f2e, 0, 1); return X86_AE;
+        case OP_EQ: emit_reg(b, 0x66, false, 0x0f2e, 0, 1); return X86_E;
+        default: emit_reg(b, 0x66, false, 0x0f2e, 0, 1); return X86_NE;
+    }
+}
+
+static void trace_emit_arith(jit_buffer* b, trace_node* nodes, int32_t ref)
+{
+    trace_node* n = &nodes[ref];
+    x86_cond cond;
+
+    if (trace_compare_op(n->op))
+    {
+        cond = trace_compare(b, nodes, n);
+
+        // equality of floats also checks the operands are ordered
+        if (cond == X86_E && (nodes[n->args[0]].type == VM_FLOAT || nodes[n->args[1]].type == VM_FLOAT)) {
+            emit_reg(b, 0, false, 0x0f90 | X86_E, 0, X86_RAX);
+            emit_reg(b, 0, false, 0x0f90 | (X86_P ^ 1), 0, X86_RCX);
+            emit_reg(b, 0, false, 0x20, X86_RCX, X86_RAX);
+            emit_reg(b, 0, false, 0x0fb6, X86_RAX, X86_RAX);
+        } else if (cond == X86_NE && (nodes[n->args[0]].type == VM_FLOAT || nodes[n->args[1]].type == VM_FLOAT)) {
+            emit_reg(b, 0, false, 0x0f90 | X86_NE, 0, X86_RAX);
+            emit_reg(b, 0, false, 0x0f90 | X86_P, 0, X86_RCX);
+            emit_reg(b, 0, false, 0x08, X86_RCX, X86_RAX);
+            emit_reg(b, 0, false, 0x0fb6, X86_RAX, X86_RAX);
+        } else {
+            emit_setcc(b, cond);
+        }
+
+        emit_mem(b, 0, true, 0x89, X86_RAX, X86_RSP, TRACE_SLOT(ref));
+        return;
+    }
+
+    if (n->type == VM_FLOAT && n->op != OP_NEG)
+    {
+        trace_fetch_float(b, nodes, n->args[0], 0);
+        trace_fetch_float(b, nodes, n->args[1], 1);
+
+        switch (n->op)
+        {
+            case OP_ADD: emit_reg(b, 0xf2, false, 0x0f58, 0, 1); break;
+            case OP_SUB: emit_reg(b, 0xf2, false, 0x0f5c, 0, 1); break;
+            case OP_MUL: emit_reg(b, 0xf2, false, 0x0f59, 0, 1); break;
+            default: emit_reg(b, 0xf2, false, 0x0f5e, 0, 1); break;
+        }
+
+        emit_mem(b, 0xf2, false, 0x0f11, 0, X86_RSP, TRACE_SLOT(ref));
+        return;
+    }
+
+    trace_fetch(b, nodes, n->args[0], X86_RAX);
+
+    if (n->args[1] >= 0) {
+        trace_fetch(b, nodes, n->args[1], X86_RCX);
+    }
+
+    switch (n->op)
+    {
+        case OP_ADD: emit_reg(b, 0, true, 0x01, X86_RCX, X86_RAX); break;
+        case OP_SUB: emit_reg(b, 0, true, 0x29, X86_RCX, X86_RAX); break;
+        case OP_MUL: emit_reg(b, 0, true, 0x0faf, X86_RAX, X86_RCX); break;
+        case OP_AND: emit_reg(b, 0, true, 0x21, X86_RCX, X86_RAX); break;
+        case OP_OR: emit_reg(b, 0, true, 0x09, X86_RCX, X86_RAX); break;
+
+        case OP_DIV:
+        case OP_MOD:
+            emit8(b, 0x48);
+            emit8(b, 0x99);
+            emit_reg(b, 0, true, 0xf7, 7, X86_RCX);
+
+            if (n->op == OP_MOD) {
+                emit_mov(b, X86_RAX, X86_RDX);
+            }
+            break;
+
+        case OP_NOT:
+            emit_reg(b, 0, true, 0x83, 6, X86_RAX);
+            emit8(b, 1);
+            break;
+
+        // floats are negated by flipping the sign bit
+        case OP_NEG:
+            if (n->type == VM_INT) {
+                emit_reg(b, 0, true, 0xf7, 3, X86_RAX);
+            } else {
+                emit_reg(b, 0, true, 0x0fba, 7, X86_RAX);
+                emit8(b, 63);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    emit_mem(b, 0, true, 0x89, X86_RAX, X86_RSP, TRACE_SLOT(ref));
+}
+
+static void trace_emit_node(jit_buffer* b, trace_node* nodes, int32_t ref)
+{
+    trace_node* n = &nodes[ref];
+    size_t exit = 2 + n->exit;
+    x86_cond cond;
+    size_t pos;
+
+    switch (n->kind)
+    {
+        case TRACE_LOAD:
+            if (n->type == VM_BOOL) {
+                emit_mem(b, 0, false, 0x0fb6, X86_RAX, trace_base(n), VALUE_SIZE * n->var + VALUE_DATA);
+            } else {
+                emit_mem(b, 0, true, 0x8b, X86_RAX, trace_base(n), VALUE_SIZE * n->var + VALUE_DATA);
+            }
+
+            emit_mem(b, 0, true, 0x89, X86_RAX, X86_RSP, TRACE_SLOT(ref));
+            break;
+
+        case TRACE_STORE:
+            trace_fetch(b, nodes, n->args[0], X86_RAX);
+            emit_mem(b, 0, true, 0x89, X86_RAX, trace_base(n), VALUE_SIZE * n->var + VALUE_DATA);
+
+            if (n->tag) {
+                emit_mem(b, 0, false, 0xc6, 0, trace_base(n), VALUE_SIZE * n->var);
+                emit8(b, n->type);
+            }
+            break;
+
+        case TRACE_GUARD:
+            if (n->hoisted) {
+                break;
+            }
+
+            emit_mem(b, 0, false, 0x80, 7, trace_base(n), VALUE_SIZE * n->var);
+            emit8(b, n->type);
+            emit_jump(b, X86_NE, exit);
+            break;
+
+        case TRACE_BRANCH:
+            if (nodes[n->args[0]].fused) {
+                cond = trace_compare(b, nodes, &nodes[n->args[0]]);
+                emit_jump(b, n->expect ? cond ^ 1 : cond, exit);
+            } else {
+                emit_mem(b, 0, false, 0x80, 7, X86_RSP, TRACE_SLOT(n->args[0]));
+                emit8(b, 0);
+                emit_jump(b, n->expect ? X86_E : X86_NE, exit);
+            }
+            break;
+
+        // the interpreter rejects int divisors whose bits read as a float zero
+        case TRACE_NONZERO:
+            if (nodes[n->args[0]].type == VM_FLOAT) {
+                trace_fetch_float(b, nodes, n->args[0], 0);
+                emit_reg(b, 0x66, false, 0x0f57, 1, 1);
+                emit_reg(b, 0x66, false, 0x0f2e, 0, 1);
+                pos = emit_short_jump(b, X86_P);
+                emit_jump(b, X86_E, exit);
+                emit_patch(b, pos);
+            } else {
+                trace_fetch(b, nodes, n->args[0], X86_RAX);
+                emit_reg(b, 0, true, n->op == OP_DIV ? 0x01 : 0x85, X86_RAX, X86_RAX);
+                emit_jump(b, X86_E, exit);
+            }
+            break;
+
+        case TRACE_ARITH:
+            if (!n->fused) {
+                trace_emit_arith(b, nodes, ref);
+            }
+            break;
+
+        case TRACE_TGET:
+            trace_fetch(b, nodes, n->args[0], X86_RDI);
+            emit_mov_imm(b, X86_RSI, nodes[n->args[1]].type);
+            trace_fetch(b, nodes, n->args[1], X86_RDX);
+            emit_mem(b, 0, true, 0x8d, X86_RCX, X86_RSP, TRACE_SLOT(ref));
+            emit_call(b, jit_trace_get);
+            emit_mem(b, 0, false, 0x80, 7, X86_RSP, TRACE_SLOT(ref) + 8);
+            emit8(b, n->type);
+            emit_jump(b, X86_NE, exit);
+            break;
+
+        case TRACE_TPUT:
+            trace_fetch(b, nodes, n->args[0], X86_RDI);
+            emit_mov_imm(b, X86_RSI, nodes[n->args[1]].type);
+            trace_fetch(b, nodes, n->args[1], X86_RDX);
+            emit_mov_imm(b, X86_RCX, nodes[n->args[2]].type);
+            trace_fetch(b, nodes, n->args[2], X86_R8);
+            emit_call(b, jit_trace_put);
+            break;
+
+        default:
+            break;
+    }
+}
+
+// writes the values of the exit onto the operand stack and leaves the trace
+static void trace_emit_exit(jit_buffer* b, trace_node* nodes, trace_exit* e, int status)
+{
+    for (size_t j = 0; j < e->depth; j++)
+    {
+        int32_t ref = e->stack[j];
+
+        // table reads are the only values whose type is checked after they are computed
+        if (nodes[ref].kind == TRACE_TGET) {
+            emit_mem(b, 0, false, 0x8a, X86_RAX, X86_RSP, TRACE_SLOT(ref) + 8);
+            emit_mem(b, 0, false, 0x88, X86_RAX, X86_R15, VALUE_SIZE * j);
+        } else {
+            emit_mem(b, 0, false, 0xc6, 0, X86_R15, VALUE_SIZE * j);
+            emit8(b, nodes[ref].type);
+        }
+
+        trace_fetch(b, nodes, ref, X86_RAX);
+        emit_mem(b, 0, true, 0x89, X86_RAX, X86_R15, VALUE_SIZE * j + VALUE_DATA);
+    }
+
+    if (e->depth > 0) {
+        emit_mem(b, 0, true, 0x81, 0, X86_R12, offsetof(call_info, tp));
+        emit32(b, e->depth);
+    }
+
+    emit_mem(b, 0, true, 0xc7, 0, X86_R12, offsetof(call_info, pc));
+    emit32(b, e->pc);
+    emit8(b, 0xb8);
+    emit32(b, status);
+    emit_jump(b, -1, 1);
+}
+
+static trace_function trace_compile(trace_recorder* r, size_t* size)
+{
+    double start = tier_clock();
+
+    static const uint8_t trace_prologue[] = {
+        0x53, 0x55, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57, // push rbx, rbp, r12-r15
+    };
+
+    static const uint8_t trace_epilogue[] = {
+        0x41, 0x5f, 0x41, 0x5e, 0x41, 0x5d, 0x41, 0x5c, 0x5d, 0x5b, 0xc3, // pop r15-r12, rbp, rbx; ret
+    };
+
+    trace_optimize(r);
+
+    // labels: loop header, epilogue, side exits and the exit taken when entry guards fail
+    jit_buffer b = buffer_new(r->nexits + 3);
+    size_t entry_exit = r->nexits + 2;
+    uint32_t frame = 16 * r->size + 8;
+    trace_node* nodes = r->nodes;
+
+    for (size_t i = 0; i < sizeof(trace_prologue); i++) emit8(&b, trace_prologue[i]);
+
+    emit_mov(&b, X86_RBX, X86_RDI);
+    emit_mov(&b, X86_R12, X86_RSI);
+    emit_mov(&b, X86_R13, X86_RDX);
+    emit_mov(&b, X86_R14, X86_RCX);
+    emit_mov(&b, X86_R15, X86_R8);
+    emit_reg(&b, 0, true, 0x81, 5, X86_RSP);
+    emit32(&b, frame);
+
+    for (size_t i = 0; i < r->size; i++) {
+        if (nodes[i].kind == TRACE_GUARD && nodes[i].hoisted) {
+            emit_mem(&b, 0, false, 0x80, 7, trace_base(&nodes[i]), VALUE_SIZE * nodes[i].var);
+            emit8(&b, nodes[i].type);
+            emit_jump(&b, X86_NE, entry_exit);
+        }
+    }
+
+    b.labels[0] = b.size;
+
+    for (size_t i = 0; i < r->size; i++) {
+        trace_emit_node(&b, nodes, i);
+    }
+
+    emit_jump(&b, -1, 0);
+
+    for (size_t i = 0; i < r->size; i++) {
+        if (nodes[i].exit >= 0 && !nodes[i].hoisted && nodes[i].kind != TRACE_NOP) {
+            b.labels[2 + nodes[i].exit] = b.size;
+            boolean branch = nodes[i].kind == TRACE_BRANCH || nodes[i].kind == TRACE_NONZERO;
+            trace_emit_exit(&b, nodes, &r->exits[nodes[i].exit], branch ? TRACE_EXIT_BRANCH : TRACE_EXIT_GUARD);
+        }
+    }
+
+    b.labels[entry_exit] = b.size;
+    emit_mem(&b, 0, true, 0xc7, 0, X86_R12, offsetof(call_info, pc));
+    emit32(&b, r->anchor);
+    emit8(&b, 0xb8);
+    emit32(&b, TRACE_EXIT_GUARD);
+
+    b.labels[1] = b.size;
+    emit_reg(&b, 0, true, 0x81, 0, X86_RSP);
+    emit32(&b, frame);
+    for (size_t i = 0; i < sizeof(trace_epilogue); i++) emit8(&b, trace_epilogue[i]);
+
+#ifdef HE_DEBUG_MODE
+    Value v = vCode(r->p, NULL);
+    printf("%s Compiled trace of %s at %zu into %zu bytes of native code\n", MESSAGE, value_to_str(&v), r->anchor, b.size);
+#endif
+
+    *size = b.size;
+    trace_function f = (trace_function) buffer_finish(&b, true);
+    tier_record(r->p, f != NULL ? TIER_TRACE : TIER_FAILED, r->anchor, f != NULL ? b.size : 0, start);
+    return f;
+}
+
+// ------------------- TRACE RECORDING ----------
+
+static void trace_stop(boolean complete)
+{
+    trace_anchor* a = &recorder.p->anchors[recorder.anchor];
+
+    if (complete && tier_budget_left()) {
+        a->trace = trace_compile(&recorder, &a->size);
+        a->depth = recorder.depth;
+    } else if (!complete) {
+        tier_record(recorder.p, TIER_ABORT, recorder.anchor, 0, 0);
+    }
+
+    if (a->trace == NULL) {
+        a->aborts++;
+        a->hits = 0;
+    }
+
+    for (size_t e = 0; e < recorder.nexits; e++) {
+        free(recorder.exits[e].stack);
+    }
+
+    recorder.size = 0;
+    recorder.nexits = 0;
+    trace_frame = NULL;
+}
+
+// the loop is recorded again, and counts as an abort so that a loop whose types keep changing is given up
+static void trace_discard(program* p, trace_anchor* a)
+{
+#ifdef HE_DEBUG_MODE
+    Value v = vCode(p, NULL);
+    printf("%s Discarded trace of %s at %zu after %u failed type guards\n", MESSAGE, value_to_str(&v), (size_t) (a - p->anchors), a->deopts);
+#endif
+
+    tier_record(p, TIER_DISCARD, a - p->anchors, 0, 0);
+    munmap(a->trace, a->size);
+    a->trace = NULL;
+    a->hits = 0;
+    a->deopts = 0;
+    a->aborts++;
+}
+
+void trace_enter(virtual_machine* vm, call_info* call)
+{
+    program* p = call->program->p;
+
+    if (call->pc >= p->length) {
+        return;
+    }
+
+    if (p->anchors == NULL) {
+        p->anchors = calloc(p->length, sizeof(trace_anchor));
+    }
+
+    trace_anchor* a = &p->anchors[call->pc];
+
+    if (a->trace != NULL) {
+        if (call->tp - call->sp != a->depth) {
+            return;
+        }
+
+        if (a->trace(vm, call, &vm->stack[call->bp], vm->heap, &vm->stack[call->tp]) == TRACE_EXIT_BRANCH) {
+            a->deopts = 0;
+        } else if (++a->deopts == TRACE_MAX_DEOPTS) {
+            trace_discard(p, a);
+        }
+    } else if (tiers.trace_threshold > 0 && a->aborts < TRACE_MAX_ABORTS && ++a->hits == tiers.trace_threshold) {
+        if (recorder.nodes == NULL) {
+            recorder.capacity = 64;
+            recorder.nodes = malloc(sizeof(trace_node) * recorder.capacity);
+            recorder.exit_capacity = 16;
+            recorder.exits = malloc(sizeof(trace_exit) * recorder.exit_capacity);
+        }
+
+        recorder.p = p;
+        recorder.anchor = call->pc;
+        recorder.depth = call->tp - call->sp;
+        recorder.root = call->prev == NULL;
+        recorder.sp = 0;
+        trace_frame = call;
+    }
+}
+
+void trace_record(virtual_machine* vm, call_info* call, instruction i, size_t pc)
+{
+    // calls and returns leave the recorded frame
+    if (call != trace_frame || !trace_step(vm, call, i, pc) || recorder.size > TRACE_MAX_LENGTH) {
+        trace_stop(false);
+        return;
+    }
+
+    // only a backward jump to the recorded header closes the loop
+    if (call->pc <= pc && (i.stackop.op == OP_JMP || i.stackop.op == OP_FORLOOP)) {
+        trace_stop(call->pc == recorder.anchor && recorder.sp == 0);
+    }
+}
+
+#else
+
+jit_function jit_compile(program* p)
+{
+    return NULL;
+}
+
+void trace_enter(virtual_machine* vm, call_info* call)
+{
+}
+
+void trace_record(virtual_machine* vm, call_info* call, instruction i, size_t pc)
+{
+    trace_frame = NULL;
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef HE_JIT_HEADER
+#define HE_JIT_HEADER
+
+#include "common.h"
+#include "compiler.h"
+#include "vm.h"
+#include "tier.h"
+
+// status native code returns to the VM once it stops running a frame
+#define JIT_RETURN 0
+#define JIT_TAILCALL 1
+
+/*
+ * The baseline JIT translates the bytecode of hot functions into x86-64
+ * machine code, one template per instruction. Templates keep the VM's
+ * stack layout: the operand stack and locals are still tagged values on
+ * vm->stack, so native code and the interpreter can call each other
+ * freely. Jumps, typed arithmetic and stack traffic are compiled inline,
+ * generic operations take an inline int fast path, and everything else
+ * calls decode_execute for the single instruction.
+ */
+
+typedef int (*jit_function)(virtual_machine* vm, call_info* call, Value* vars, Value* top, Value* limit);
+
+// recordings of a loop abandoned before the loop is no longer traced
+#define TRACE_MAX_ABORTS 3
+
+// longest trace in nodes, recording is abandoned past it
+#define TRACE_MAX_LENGTH 1024
+
+// status a trace returns through its side exit
+#define TRACE_EXIT_BRANCH 0 // control flow left the recorded path
+#define TRACE_EXIT_GUARD 1  // a value no longer has the type the trace was specialized on
+
+// consecutive type guard failures after which a trace is discarded
+#define TRACE_MAX_DEOPTS 8
+
+/*
+ * The tracing JIT records the path the interpreter takes through one
+ * iteration of a hot loop, starting at the target of a backward jump.
+ * Each value on the recorded path is specialized on the type observed
+ * while recording, checked by guards. The trace is optimized and
+ * compiled into a native loop which keeps values untagged and exits back
+ * into the interpreter when a guard fails, with the operand stack and pc
+ * of the instruction the guard stands for.
+ *
+ * Each guard keeps a snapshot of the operand stack it would leave, as
+ * references to the values computed by the trace. Its exit writes them
+ * back tagged, so the interpreter resumes a frame identical to the one it
+ * would have reached itself. Variables are always stored tagged. A trace
+ * whose type guards keep failing is discarded and the loop is recorded
+ * again with the types it now sees.
+ */
+
+typedef int (*trace_function)(virtual_machine* vm, call_info* call, Value* locals, Value* heap, Value* top);
+
+typedef struct trace_anchor {
+    uint32_t hits;   // backward jumps taken to the header
+    uint32_t aborts; // recordings of the loop which were abandoned or discarded
+    uint32_t deopts; // type guard failures since the trace last left through a branch
+    size_t depth;    // operand stack depth the trace is entered with
+    size_t size;     // bytes of native code
+    trace_function trace;
+} trace_anchor;
+
+// frame whose instructions are being recorded into a trace, NULL if none
+extern call_info* trace_frame;
+
+/*
+ * Native code is compiled unless disabled on the command line with
+ * --no-jit, or the host is not x86-64.
+ */
+extern boolean jit_enabled;
+
+/*
+ * Functions are compiled by stitching together the stencils of the
+ * copy-and-patch JIT instead of the handwritten templates when selected
+ * on the command line with --jit-stencils.
+ */
+extern boolean jit_stencils;
+
+/**
+ * @brief Counts the entry into a function frame and runs it as native
+ *      code once the function is hot. Tail calls made by native code
+ *      enter the callee the same way, until a callee is not compiled.
+ *
+ * @param vm Reference to virtual machine
+ * @param call Frame entered at its first instruction
+ * @return True if the frame has returned, false if the interpreter
+ *      should run it from its first instruction
+ */
+boolean jit_execute(virtual_machine* vm, call_info* call);
+
+/**
+ * @brief Called at the header of a hot loop which cannot be traced.
+ *      Compiles the function of the frame once the loop keeps running,
+ *      and replaces the interpreted frame with native code entered at the
+ *      loop header. Native code keeps the VM's stack layout, so locals
+ *      and the operand stack are taken over in place.
+ *
+ * @param vm Reference to virtual machine
+ * @param call Frame at the loop header
+ * @return True if the frame has returned, false if the interpreter
+ *      should keep running it
+ */
+boolean jit_osr(virtual_machine* vm, call_info* call);
+
+/**
+ * @brief Finds the loop header a backward jump returns to. Native code
+ *      entered by on-stack replacement dispatches on these headers.
+ *
+ * @param p Reference to program
+ * @param k Address of an instruction
+ * @return Target of the backward jump at k, or the end of the program if
+ *      k does not jump back
+ */
+size_t jit_loop_header(program* p, size_t k);
+
+/**
+ * @brief Compiles the bytecode of a program into native code placed in
+ *      executable memory. Frames with a pc at a loop header enter the
+ *      code at that header.
+ *
+ * @param p Reference to program
+ * @return Native function, NULL if the program cannot be compiled
+ */
+jit_function jit_compile(program* p);
+
+/**
+ * @brief Called when the interpreter takes a backward jump. Runs the
+ *      trace of the loop header reached, which returns with the frame at
+ *      the instruction a side exit resumes at, or counts the jump and
+ *      starts recording once the loop is hot.
+ *
+ * @param vm Reference to virtual machine
+ * @param call Frame at the loop header
+ */
+void trace_enter(virtual_machine* vm, call_info* call);
+
+/**
+ * @brief Records an instruction the interpreter has executed into the
+ *      trace being recorded. The trace is compiled when the recorded
+ *      frame jumps back to the loop header, recording is abandoned on
+ *      instructions the tracing JIT does not support.
+ *
+ * @param vm Reference to virtual machine
+ * @param call Frame the instruction was executed in
+ * @param i Executed instruction
+ * @param pc Address of the executed instruction
+ */
+void trace_record(virtual_machine* vm, call_info* call, instruction i, size_t pc);
+
+#endif
@@ -3,6 +3,7 @@
 // forward declarations
 char* reduce_string_buffer(char* buffer);
 lxtype determine_nature(char* s);
+lxop determine_operator(const char* s);
 boolean check_pattern(lexer* lx, const char* pattern, char* buf);
 char escapechar(char c);
 
@@ -11,6 +12,7 @@ lxtoken* lxtoken_new(const char* value, lxtype type, lxpos pos)
     lxtoken* tk = (lxtoken*)malloc(sizeof(lxtoken));
     tk->pos = pos;
     tk->type = type;
+    tk->op = LXOP_NONE;
     tk->value = value;
     return tk;
 }
@@ -82,6 +84,9 @@ lxtoken* lex(lexer* lx)
     {
         char c = lexadvance(lx);
         while ((c = lexadvance(lx)) != '"') {
+            if (c == '\0') {
+                lexerror(lx, "Syntax error! Unterminated string");
+            }
             buf[len++] = c == '\\' ? escapechar(lexadvance(lx)) : c;
         }
         
@@ -152,11 +157,11 @@ lxtoken* lex(lexer* lx)
                 break;
             case '#':
                 type = LX_COMMENT;
-                while (lx->lookahead != '\n') lexadvance(lx);
+                while (lx->lookahead != '\n' && lx->lookahead != '\0') lexadvance(lx);
                 break;
             case '?':
                 type = LX_COMMENT;
-                while (lexadvance(lx) != '?');
+                while (lx->lookahead != '\0' && lexadvance(lx) != '?');
                 break;
             case '@':
                 type = LX_CALL;
@@ -179,7 +184,15 @@ lxtoken* lex(lexer* lx)
     buf[len] = '\0';
     buf = reduce_string_buffer(buf);
 
-    return lxtoken_new(buf, type, pos);
+    lxtoken* tk = lxtoken_new(buf, type, pos);
+
+    // operators are classified once here so later stages never
+    // compare operator strings
+    if (type == LX_OPERATOR) {
+        tk->op = determine_operator(buf);
+    }
+
+    return tk;
 }
 
 char lexadvance(lexer* lx)
@@ -213,6 +226,8 @@ lxtype determine_nature(char* s)
         return LX_RETURN;
     else if (streq(s, "loop"))
         return LX_LOOP;
+    else if (streq(s, "for"))
+        return LX_FOR;
     else if (streq(s, "if"))
         return LX_IF;
     else if (streq(s, "else"))
@@ -223,6 +238,28 @@ lxtype determine_nature(char* s)
         return LX_SYMBOL;
 }
 
+// Determines the operator kind of an operator token string
+lxop determine_operator(const char* s)
+{
+    switch (s[0])
+    {
+        case '+': return LXOP_ADD;
+        case '-': return LXOP_SUB;
+        case '*': return LXOP_MUL;
+        case '/': return LXOP_DIV;
+        case '%': return LXOP_MOD;
+        case '<': return s[1] == '=' ? LXOP_LE : LXOP_LT;
+        case '>': return s[1] == '=' ? LXOP_GE : LXOP_GT;
+        case '=': return LXOP_EQ;
+        case '!': return s[1] == '=' ? LXOP_NE : LXOP_NOT;
+        case '&': return s[1] == '&' ? LXOP_AND : LXOP_BAND;
+        case '|': return s[1] == '|' ? LXOP_OR : LXOP_BOR;
+        case '^': return LXOP_BXOR;
+        case '~': return LXOP_BNOT;
+        default: return LXOP_NONE;
+    }
+}
+
 // Checks for patterns against current lexer position - should
 // only be used for non-whitespace dependent patterns.
 boolean check_pattern(lexer* lx, const char* pattern, char* buf)
@@ -328,6 +365,7 @@ const char* lxtype_strings[] = {
     "LX_LEFT_SQUARE      ",
     "LX_RIGHT_SQUARE     ",
     "LX_DOT              ",
+    "LX_FOR              ",
 };
 
 void lxtoken_display(lxtoken* tk)
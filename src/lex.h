@@ -38,8 +38,31 @@ typedef enum lxtype {
     LX_LEFT_SQUARE,
     LX_RIGHT_SQUARE,
     LX_DOT,             // 28
+    LX_FOR,
 } lxtype;
 
+typedef enum lxop {
+    LXOP_NONE,          // 0
+    LXOP_ADD,
+    LXOP_SUB,
+    LXOP_MUL,
+    LXOP_DIV,           // 4
+    LXOP_MOD,
+    LXOP_LT,
+    LXOP_LE,
+    LXOP_GT,            // 8
+    LXOP_GE,
+    LXOP_EQ,
+    LXOP_NE,
+    LXOP_AND,           // 12
+    LXOP_OR,
+    LXOP_NOT,
+    LXOP_BAND,
+    LXOP_BOR,           // 16
+    LXOP_BXOR,
+    LXOP_BNOT,
+} lxop;
+
 typedef struct lxpos {
     int col_pos;
     int line_pos;
@@ -47,10 +70,12 @@ typedef struct lxpos {
     int line_offset;
     const char* origin;
     const char* src;
+    const struct lxpos* caller; // call site of code inlined from another function
 } lxpos;
 
 typedef struct lxtoken {
     lxtype type;
+    lxop op;
     const char* value;
     lxpos pos;
 } lxtoken;
@@ -141,18 +141,28 @@ Value native_table_remove(Value v[])
     return vTableRm(v[0].value.to_table, v[1]);
 }
 
-void register_all_natives(program* p)
+const native_method native_methods[] = {
+    { "popkey", native_table_remove, 2, false },
+    { "print", native_print, 1, false },
+    { "input", native_input, 1, false },
+    { "int", native_int_cast, 1, true },
+    { "str", native_str_cast, 1, true },
+    { "float", native_float_cast, 1, true },
+    { "bool", native_bool_cast, 1, true },
+    { "len", native_length, 1, true },
+    { "sqrt", native_sqrt, 1, true },
+    { "pow", native_pow, 2, true },
+    { "time", native_time, 0, false },
+    { "delay", native_delay, 1, false },
+    { NULL, NULL, 0, false },
+};
+
+const native_method* find_native(const char* name, Value (*f)(Value[]))
 {
-    create_native(p, "popkey", native_table_remove, 2);
-    create_native(p, "print", native_print, 1);
-    create_native(p, "input", native_input, 1);
-    create_native(p, "int", native_int_cast, 1);
-    create_native(p, "str", native_str_cast, 1);
-    create_native(p, "float", native_float_cast, 1);
-    create_native(p, "bool", native_bool_cast, 1);
-    create_native(p, "len", native_length, 1);
-    create_native(p, "sqrt", native_sqrt, 1);
-    create_native(p, "pow", native_pow, 2);
-    create_native(p, "time", native_time, 0);
-    create_native(p, "delay", native_delay, 1);
-}
\ No newline at end of file
+    for (const native_method* m = native_methods; m->name != NULL; m++) {
+        if ((name != NULL && streq(m->name, name)) || (f != NULL && m->f == f)) {
+            return m;
+        }
+    }
+    return NULL;
+}
@@ -8,14 +8,25 @@
 #include <math.h>
 #include <time.h>
 
+typedef struct native_method {
+    const char* name;
+    Value (*f)(Value[]);
+    int argc;
+    boolean pure; // no side effects and no runtime errors for any argument
+} native_method;
+
+// Table of in-built methods terminated by an entry with a NULL name
+extern const native_method native_methods[];
+
 /**
- * @brief Registers all native, in-built methods to the specified
- *      program's local scope. These methods will be available in
- *      the local symbol table and can be called by child methods
+ * @brief Looks up an in-built method either by name or by the address of
+ *      its C-wrapper, returns NULL if no method matches.
  * 
- * @param p Program scope
+ * @param name Name of method, can be NULL
+ * @param f Pointer to wrapper function, can be NULL
+ * @return Native method entry
  */
-void register_all_natives(program* p);
+const native_method* find_native(const char* name, Value (*f)(Value[]));
 
 /**
  * @brief Casts generic tagged value to int-tagged value.
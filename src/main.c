@@ -7,62 +7,120 @@ virtual_machine* current_vm;
 int main(int argc, const char* argv[])
 {
     const char* src;
+    const char* script = NULL;
+    boolean use_cache = true;
+    boolean emit_c = false;
+    boolean vm_stats = false;
     char fpath[256];
 
-    if (argc < 2) {
+    for (int i = 1; i < argc; i++)
+    {
+        if (streq(argv[i], "--no-cache")) {
+            use_cache = false;
+        } else if (streq(argv[i], "--emit-c")) {
+            emit_c = true;
+        } else if (streq(argv[i], "--no-jit")) {
+            jit_enabled = false;
+        } else if (streq(argv[i], "--jit-stencils")) {
+            jit_stencils = true;
+        } else if (streq(argv[i], "--register-vm")) {
+            reg_enabled = true;
+        } else if (streq(argv[i], "--vm-stats")) {
+            vm_stats = true;
+        } else if (streq(argv[i], "-O0") || streq(argv[i], "-O1") || streq(argv[i], "-O2")) {
+            optimization_level = argv[i][2] - '0';
+        } else if (tier_option(argv[i])) {
+            continue;
+        } else if (script == NULL) {
+            script = argv[i];
+        }
+    }
+
+    if (script == NULL) {
         failure("File not specified!");
     } else {
-        sprintf(fpath, "%s/%s", getcwd(fpath, sizeof(fpath)), argv[1]);
-        src = read_file(fpath);
+        if (script[0] == '/') {
+            snprintf(fpath, sizeof(fpath), "%s", script);
+        } else {
+            sprintf(fpath, "%s/%s", getcwd(fpath, sizeof(fpath)), script);
+        }
+
+        // a single dash reads the script from standard input
+        if (streq(script, "-")) {
+            src = read_stream(STDIN_FILENO, "stdin");
+            use_cache = false;
+        } else {
+            src = read_file(fpath);
+        }
     }
 
+    program pp = {
+        .code = NULL,
+        .length = 0,
+        .capacity = 0,
+        .argc = 0,
+        .constants = NULL,
+        .prev = NULL,
+
+        .constant_table = {},
+        .symbol_table = map_new(37),
+        .closure_table = map_new(37),
+        .line_address_table = map_new(37),
+        .source_table = map_new(4),
+    };
+
+    map_put(&pp.source_table, fpath, (void*) src);
+
+    // compiles the script unless an up to date bytecode cache exists
+    if (!use_cache || !cache_load(&pp, fpath)) {
 #ifdef HE_DEBUG_MODE
-    printf("\n%s Reading code:\n\n%s\n", MESSAGE, src);
+        printf("\n%s Reading code:\n\n%s\n", MESSAGE, src);
 
-    printf("%s Beginning lexical anaylsis:\n\n", MESSAGE);
+        printf("%s Beginning lexical anaylsis:\n\n", MESSAGE);
 #endif
 
-    vector tokens = vector_new(64);
-    lexer lx = lexer_new(src, fpath);
-    lexify(&lx, &tokens);
-    
+        vector tokens = vector_new(64);
+        lexer lx = lexer_new(src, fpath);
+        lexify(&lx, &tokens);
+        
 #ifdef HE_DEBUG_MODE
-    for (size_t i = 0; i < tokens.size; i++) {
-        lxtoken_display(tokens.items[i]);
-    }
+        for (size_t i = 0; i < tokens.size; i++) {
+            lxtoken_display(tokens.items[i]);
+        }
 
-    printf("\n%s Beginning syntax parsing:\n\n", MESSAGE);
+        printf("\n%s Beginning syntax parsing:\n\n", MESSAGE);
 #endif
 
-    parser p = {
-        .position = 0,
-        .source = src,
-        .tokens = tokens
-    };
+        parser p = {
+            .position = 0,
+            .source = src,
+            .tokens = tokens,
+            .tree = ast_new(fpath, src)
+        };
 
-    astnode* tree = parse(&p);
+        astref tree = parse(&p);
 
 #ifdef HE_DEBUG_MODE
-    printf("%s\n", astnode_tostr(tree));
+        printf("%s\n", astnode_tostr(&p.tree, tree));
 
-    printf("\n%s Beginning compilation:\n\n", MESSAGE);
+        printf("\n%s Beginning compilation:\n\n", MESSAGE);
 #endif
 
-    program pp = {
-        .code = malloc(sizeof(instruction) * MAX_LOCAL_VARIABLES),
-        .length = 0,
-        .argc = 0,
-        .constants = malloc(sizeof(Value) * MAX_LOCAL_CONSTANTS),
-        .prev = NULL,
+        register_all_natives(&pp);
+        compile(&pp, &p.tree, tree);
+        optimize_program(&pp);
+        ast_delete(&p.tree);
 
-        .constant_table = map_new(37),
-        .symbol_table = map_new(37),
-        .closure_table = map_new(37),
-        .line_address_table = map_new(37),
-    };
-    
-    register_all_natives(&pp);
-    compile(&pp, tree);
+        if (use_cache) {
+            cache_store(&pp, fpath);
+        }
+    }
+
+    // the script is translated to C instead of being run
+    if (emit_c) {
+        aot_emit(&pp, fpath, stdout);
+        return 0;
+    }
 
 #ifdef HE_DEBUG_MODE
     printf(disassemble_program(&pp));
@@ -80,8 +138,15 @@ int main(int argc, const char* argv[])
     };
 
     current_vm = &vm;
+    double start = tier_clock();
 
     run_program(&vm, NULL, vCode(&pp, NULL).value.to_code);
+    tier_report();
+
+    if (vm_stats) {
+        fprintf(stderr, "%s VM: %zu instructions dispatched in %.3f ms\n",
+            reg_enabled ? "Register" : "Stack", vm_dispatched, tier_clock() - start);
+    }
 
 #ifdef HE_DEBUG_MODE
     clock_t end = clock();
@@ -0,0 +1,276 @@
+#ifndef HE_OPS_HEADER
+#define HE_OPS_HEADER
+
+#include "common.h"
+#include "compiler.h"
+#include "lib.h"
+#include "vm.h"
+
+/*
+ * Opcode handlers executed by decode_execute. Each handler carries the
+ * semantics of one instruction with its operand decoded, and leaves the
+ * pc alone: handlers of jumps report whether the jump is taken, the
+ * caller moves the pc. The copy-and-patch JIT compiles the same handlers
+ * into its native code stencils, so both run identical C.
+ */
+
+#define HE_OP static inline __attribute__((always_inline))
+
+// ------------------ STACK ------------------
+
+HE_OP void op_push(virtual_machine* vm, call_info* call, Value v)
+{
+    vm->stack[call->tp++] = v;
+
+    if (call->tp >= MAX_STACK_SIZE) runtimeerr(vm, "Stack overflow!");
+}
+
+HE_OP void op_pop(virtual_machine* vm, call_info* call)
+{
+    call->tp--;
+}
+
+HE_OP void op_storg(virtual_machine* vm, call_info* call, int32_t sx)
+{
+    vm->heap[sx] = vm->stack[--call->tp];
+
+    if (sx >= MAX_HEAP_SIZE) runtimeerr(vm, "Stack overflow!");
+}
+
+HE_OP void op_storl(virtual_machine* vm, call_info* call, int32_t sx)
+{
+    vm->stack[call->bp + sx] = vm->stack[--call->tp];
+
+    if (call->bp + sx >= MAX_STACK_SIZE) runtimeerr(vm, "Stack overflow!");
+}
+
+HE_OP void op_storc(virtual_machine* vm, call_info* call, uint32_t ux)
+{
+    call->program->closure[ux] = vm->stack[--call->tp];
+}
+
+// ----------------- OPERATORS -----------------
+
+HE_OP void op_binary(virtual_machine* vm, call_info* call, vm_op op)
+{
+    Value v1 = vm->stack[--call->tp];
+    Value v0 = vm->stack[--call->tp];
+    vm->stack[call->tp++] = apply_vm_op(op, v0, v1);
+}
+
+HE_OP void op_neg(virtual_machine* vm, call_info* call)
+{
+    vm->stack[call->tp - 1] = vNegate(vm->stack[call->tp - 1]);
+}
+
+HE_OP void op_not(virtual_machine* vm, call_info* call)
+{
+    vm->stack[call->tp - 1] = vBool(!native_bool_cast(&vm->stack[call->tp - 1]).value.to_bool);
+}
+
+// operand types were proven by the optimizer, tags are left untouched
+#define HE_TYPED_OP(name, field, operator) \
+    HE_OP void name(virtual_machine* vm, call_info* call) \
+    { \
+        call->tp--; \
+        vm->stack[call->tp - 1].value.field = vm->stack[call->tp - 1].value.field operator vm->stack[call->tp].value.field; \
+    }
+
+#define HE_TYPED_COMPARE(name, field, operator) \
+    HE_OP void name(virtual_machine* vm, call_info* call) \
+    { \
+        call->tp--; \
+        vm->stack[call->tp - 1] = vBool(vm->stack[call->tp - 1].value.field operator vm->stack[call->tp].value.field); \
+    }
+
+HE_TYPED_OP(op_addi, to_int, +)
+HE_TYPED_OP(op_subi, to_int, -)
+HE_TYPED_OP(op_muli, to_int, *)
+HE_TYPED_OP(op_addf, to_float, +)
+HE_TYPED_OP(op_subf, to_float, -)
+HE_TYPED_OP(op_mulf, to_float, *)
+
+HE_TYPED_COMPARE(op_eqi, to_int, ==)
+HE_TYPED_COMPARE(op_nei, to_int, !=)
+HE_TYPED_COMPARE(op_lti, to_int, <)
+HE_TYPED_COMPARE(op_lei, to_int, <=)
+HE_TYPED_COMPARE(op_gti, to_int, >)
+HE_TYPED_COMPARE(op_gei, to_int, >=)
+HE_TYPED_COMPARE(op_ltf, to_float, <)
+HE_TYPED_COMPARE(op_lef, to_float, <=)
+HE_TYPED_COMPARE(op_gtf, to_float, >)
+HE_TYPED_COMPARE(op_gef, to_float, >=)
+
+HE_OP void op_divi(virtual_machine* vm, call_info* call)
+{
+    Value v1 = vm->stack[--call->tp];
+    if (v1.value.to_int == 0 || v1.value.to_float == 0.0) runtimeerr(vm, "Zero division error!");
+    vm->stack[call->tp - 1].value.to_int /= v1.value.to_int;
+}
+
+HE_OP void op_modi(virtual_machine* vm, call_info* call)
+{
+    Value v1 = vm->stack[--call->tp];
+    if (v1.value.to_int == 0) runtimeerr(vm, "Zero modulus error!");
+    vm->stack[call->tp - 1].value.to_int %= v1.value.to_int;
+}
+
+HE_OP void op_divf(virtual_machine* vm, call_info* call)
+{
+    Value v1 = vm->stack[--call->tp];
+    if (v1.value.to_float == 0.0) runtimeerr(vm, "Zero division error!");
+    vm->stack[call->tp - 1].value.to_float /= v1.value.to_float;
+}
+
+// ------------------- CALLS -------------------
+
+HE_OP void op_call(virtual_machine* vm, call_info* call, uint32_t argc)
+{
+    if (vm->stack[--call->tp].type != VM_PROGRAM) {
+        char msg[1000];
+        msg[0] = '\0';
+        sprintf(msg, "Cannot call value %s, expected function type!", value_to_str(&vm->stack[call->tp]));
+        runtimeerr(vm, msg);
+    }
+
+    code_object* code = vm->stack[call->tp].value.to_code;
+
+    call->tp -= code->p->argc;
+
+    if (argc == code->p->argc)
+        run_program(vm, call, code);
+    else {
+        runtimeerr(vm, "Invalid number of arguments passed to function!");
+    }
+}
+
+// the arguments move to the base of the frame, which restarts with the callee
+HE_OP boolean op_tailcall(virtual_machine* vm, call_info* call, uint32_t argc)
+{
+    Value v0 = vm->stack[call->tp - 1];
+
+    if (v0.type == VM_PROGRAM && v0.value.to_code->p->native == NULL && argc == v0.value.to_code->p->argc)
+    {
+        call->tp -= argc + 1;
+        memmove(&vm->stack[call->bp], &vm->stack[call->tp], sizeof(Value) * argc);
+
+        call->program = v0.value.to_code;
+        call->sp = call->tp = call->bp + call->program->p->symbol_table.size;
+
+        if (call->tp >= MAX_STACK_SIZE) runtimeerr(vm, "Stack overflow!");
+        return true;
+    }
+
+    // natives and invalid calls are made as usual, the return following them ends the frame
+    op_call(vm, call, argc);
+    return false;
+}
+
+HE_OP void op_ret(virtual_machine* vm, call_info* call)
+{
+    vm->stack[call->prev->tp++] = vm->stack[--call->tp];
+}
+
+HE_OP void op_close(virtual_machine* vm, call_info* call, uint32_t n)
+{
+    Value* closure = malloc(sizeof(Value) * n);
+    call->tp -= n;
+
+    for (size_t i = 0; i < n; i++) {
+        closure[i] = vm->stack[call->tp + i];
+    }
+
+    vm->stack[call->tp - 1] = vCode(vm->stack[call->tp - 1].value.to_code->p, closure);
+}
+
+// ------------------- TABLES ------------------
+
+HE_OP void op_tnew(virtual_machine* vm, call_info* call)
+{
+    vm->stack[call->tp++] = vTable(10);
+}
+
+HE_OP void op_tput(virtual_machine* vm, call_info* call)
+{
+    Value v1 = vm->stack[--call->tp];
+    Value v0 = vm->stack[--call->tp];
+    call->tp--;
+
+    if (vm->stack[call->tp].type == VM_TABLE)
+        vTablePut(vm->stack[call->tp++].value.to_table, v0, v1);
+    else
+        runtimeerr(vm, "Cannot add element to non-table object");
+}
+
+HE_OP void op_tget(virtual_machine* vm, call_info* call)
+{
+    Value v0 = vm->stack[--call->tp];
+    call->tp--;
+    if (vm->stack[call->tp].type == VM_TABLE)
+        vm->stack[call->tp] = vTableGet(vm->stack[call->tp].value.to_table, v0);
+    else
+        runtimeerr(vm, "Cannot retrieve element from non-table object");
+    call->tp++;
+}
+
+// ------------------- JUMPS -------------------
+
+// a truthy condition skips the jump which follows it
+HE_OP boolean op_jif(virtual_machine* vm, call_info* call)
+{
+    return native_bool_cast(&vm->stack[--call->tp]).value.to_bool;
+}
+
+// a passing guard skips the jump to the generic code
+HE_OP boolean op_guard(virtual_machine* vm, call_info* call, int32_t sx, vm_type type)
+{
+    return vm->stack[call->bp + sx].type == type;
+}
+
+// whether a counter is still within the range of its loop
+HE_OP boolean for_in_range(long counter, long limit, long step, uint32_t ux)
+{
+    if (ux & FOR_EXCLUSIVE) {
+        return step > 0 ? counter < limit : counter > limit;
+    }
+
+    return step > 0 ? counter <= limit : counter >= limit;
+}
+
+// the limit and step are stored next to each other, an empty range takes the jump past the loop
+HE_OP boolean op_forprep(virtual_machine* vm, call_info* call, uint32_t ux)
+{
+    Value* vars = call->prev == NULL ? vm->heap : &vm->stack[call->bp];
+    Value v1 = vars[FOR_LIMIT(ux) + 1] = vm->stack[--call->tp];
+    Value v0 = vars[FOR_LIMIT(ux)] = vm->stack[--call->tp];
+
+    if (v0.type != VM_INT || v1.type != VM_INT || vars[FOR_COUNTER(ux)].type != VM_INT) {
+        runtimeerr(vm, "Loop range must be integers!");
+    } else if (v1.value.to_int == 0) {
+        runtimeerr(vm, "Loop step cannot be zero!");
+    }
+
+    return for_in_range(vars[FOR_COUNTER(ux)].value.to_int, v0.value.to_int, v1.value.to_int, ux);
+}
+
+// increments the counter in place, the jump back into the body is taken while it is in range
+HE_OP boolean op_forloop(virtual_machine* vm, call_info* call, uint32_t ux)
+{
+    Value* vars = call->prev == NULL ? vm->heap : &vm->stack[call->bp];
+    Value v0 = vars[FOR_LIMIT(ux)];
+    Value v1 = vars[FOR_LIMIT(ux) + 1];
+
+    // the body may have assigned the counter
+    if (vars[FOR_COUNTER(ux)].type != VM_INT) {
+        runtimeerr(vm, "Loop counter must be an integer!");
+    }
+
+    // a counter stepping past the largest or smallest integer has left any range
+    if (__builtin_add_overflow(vars[FOR_COUNTER(ux)].value.to_int, v1.value.to_int, &vars[FOR_COUNTER(ux)].value.to_int)) {
+        return false;
+    }
+
+    return for_in_range(vars[FOR_COUNTER(ux)].value.to_int, v0.value.to_int, v1.value.to_int, ux);
+}
+
+#endif
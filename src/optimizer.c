@@ -0,0 +1,473 @@
+#include "optimizer.h"
+#include "ir.h"
+
+int optimization_level = 2;
+
+// passes in the order they run, IR passes run before the program is lowered
+optimizer_pass optimizer_passes[] = {
+    { "copy-propagation", 2, ir_propagate_copies, NULL },
+    { "common-subexpressions", 2, ir_eliminate_common_subexpressions, NULL },
+    { "loop-invariants", 2, ir_hoist_loop_invariants, NULL },
+    { "induction-variables", 2, ir_reduce_induction_variables, NULL },
+    { "dead-stores", 2, ir_eliminate_dead_stores, NULL },
+    { "type-inference", 2, ir_infer_types, NULL },
+    { "counted-loops", 2, ir_select_counted_loops, NULL },
+    { "constant-branches", 1, NULL, fold_constant_branches },
+    { "dead-code", 1, NULL, eliminate_dead_code },
+    { "peephole", 1, NULL, peephole },
+    { "tail-calls", 1, NULL, mark_tail_calls },
+    { "remove-nops", 1, NULL, remove_nops },
+    { NULL, 0, NULL, NULL },
+};
+
+// runs once over every function before any of them is optimized
+optimizer_pass inline_pass = { "inline", 2, ir_inline_calls, NULL };
+
+// load operations indexed by the store operation of the same scope
+vm_op store_load_op_map[] = {
+    [OP_STORL] = OP_LOADL,
+    [OP_STORG] = OP_LOADG,
+    [OP_STORC] = OP_LOADC,
+};
+
+void optimize_program(program* p)
+{
+    ir_function f;
+    boolean changed;
+
+    if (p->native != NULL || optimization_level < 1) {
+        return;
+    }
+
+    // callees are inlined while their bytecode can still be lifted
+    if (p->prev == NULL && optimization_level >= inline_pass.level) {
+        inline_functions(p);
+    }
+
+    // nested functions are optimized once the whole program is compiled
+    for (size_t i = 0; i < p->constant_table.size; i++)
+    {
+        Value* k = &p->constants[i];
+
+        if (k->type == VM_PROGRAM) {
+            optimize_program(k->value.to_code->p);
+        }
+    }
+
+    if (optimization_level >= 2 && ir_lift(p, &f))
+    {
+        changed = true;
+
+        // iterations are bounded, every pass only shrinks the program
+        for (size_t n = 0; n < 8 && changed; n++)
+        {
+            changed = false;
+
+            for (optimizer_pass* pass = optimizer_passes; pass->name != NULL; pass++) {
+                if (pass->on_ir != NULL && pass->level <= optimization_level) {
+                    changed = run_pass(pass, pass->on_ir(&f)) || changed;
+                }
+            }
+        }
+
+        ir_lower(&f);
+        ir_delete(&f);
+    }
+
+    // removing instructions can expose new rewrites
+    do {
+        changed = false;
+
+        for (optimizer_pass* pass = optimizer_passes; pass->name != NULL; pass++) {
+            if (pass->on_bytecode != NULL && pass->level <= optimization_level) {
+                changed = run_pass(pass, pass->on_bytecode(p)) || changed;
+            }
+        }
+    } while (changed);
+}
+
+void inline_functions(program* p)
+{
+    ir_function f;
+
+    for (size_t i = 0; i < p->constant_table.size; i++)
+    {
+        Value* k = &p->constants[i];
+
+        if (k->type == VM_PROGRAM && k->value.to_code->p->native == NULL) {
+            inline_functions(k->value.to_code->p);
+        }
+    }
+
+    if (ir_lift(p, &f))
+    {
+        if (run_pass(&inline_pass, inline_pass.on_ir(&f))) {
+            ir_lower(&f);
+        }
+
+        ir_delete(&f);
+    }
+}
+
+boolean run_pass(optimizer_pass* pass, boolean changed)
+{
+#ifdef HE_DEBUG_MODE
+    if (changed) {
+        printf("%s Optimizer pass %s rewrote program\n", MESSAGE, pass->name);
+    }
+#endif
+
+    return changed;
+}
+
+boolean peephole(program* p)
+{
+    instruction* code = p->code;
+    boolean* targets = find_jump_targets(p);
+    boolean changed = false;
+
+    for (size_t i = 0; i < p->length; i++)
+    {
+        vm_op op = code[i].stackop.op;
+        size_t target;
+
+        switch (op)
+        {
+            case OP_JIF:
+                // a branch with an empty body only needs its condition popped
+                if (i + 1 < p->length && code[i + 1].stackop.op == OP_JMP && code[i + 1].sx.sx == 0) {
+                    code[i].stackop.op = OP_POP;
+                    code[i + 1].stackop.op = OP_NOP;
+                    changed = true;
+                }
+                break;
+
+            case OP_GUARDI:
+            case OP_GUARDF:
+                // a guard whose failure continues with the next instruction checks nothing
+                if (i + 1 < p->length && code[i + 1].stackop.op == OP_JMP && code[i + 1].sx.sx == 0) {
+                    code[i].stackop.op = OP_NOP;
+                    code[i + 1].stackop.op = OP_NOP;
+                    changed = true;
+                }
+                break;
+
+            case OP_JMP:
+                target = jump_target(p, i);
+
+                // threads jump chains to their final destination
+                for (size_t n = 0; n < p->length && target < p->length && code[target].stackop.op == OP_JMP; n++) {
+                    target = jump_target(p, target);
+                }
+
+                if (target != jump_target(p, i)) {
+                    code[i].sx.sx = target - i - 1;
+                    changed = true;
+                }
+
+                // the instruction after a conditional jump must remain in place
+                if (code[i].sx.sx == 0 && (i == 0 || !conditional_skip(code[i - 1].stackop.op))) {
+                    code[i].stackop.op = OP_NOP;
+                    changed = true;
+                }
+                break;
+
+            case OP_STORL:
+            case OP_STORG:
+            case OP_STORC:
+                // keeps a copy of a stored value instead of loading it back
+                if (i + 1 < p->length && !targets[i + 1] && code[i + 1].stackop.op == store_load_op_map[op] &&
+                    code[i + 1].ux.ux == code[i].ux.ux) {
+                    code[i + 1] = code[i];
+                    code[i].ux.op = OP_DUP;
+                    code[i].ux.ux = 0;
+                    changed = true;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    free(targets);
+    return changed;
+}
+
+boolean mark_tail_calls(program* p)
+{
+    boolean changed = false;
+
+    for (size_t i = 0; i + 1 < p->length; i++)
+    {
+        if (p->code[i].stackop.op == OP_CALL && p->code[i + 1].stackop.op == OP_RET) {
+            p->code[i].stackop.op = OP_TAILCALL;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+boolean fold_constant_branches(program* p)
+{
+    instruction* code = p->code;
+    boolean* targets = find_jump_targets(p);
+    boolean changed = false;
+
+    for (size_t i = 0; i + 2 < p->length; i++)
+    {
+        if (code[i].stackop.op != OP_PUSHK || code[i + 1].stackop.op != OP_JIF || code[i + 2].stackop.op != OP_JMP || targets[i + 1]) {
+            continue;
+        }
+
+        Value k = p->constants[code[i].ux.ux];
+
+        // a true condition skips the jump over the body, a false one always takes it
+        if (native_bool_cast(&k).value.to_bool) {
+            code[i + 2].stackop.op = OP_NOP;
+        }
+
+        code[i].stackop.op = OP_NOP;
+        code[i + 1].stackop.op = OP_NOP;
+        changed = true;
+    }
+
+    free(targets);
+    return changed;
+}
+
+boolean eliminate_dead_code(program* p)
+{
+    cfg g = cfg_new(p);
+    boolean changed = false;
+
+    cfg_reachability(&g);
+
+    for (size_t b = 0; b < g.size; b++)
+    {
+        if (g.blocks[b].reachable) {
+            continue;
+        }
+
+        for (size_t i = g.blocks[b].start; i < g.blocks[b].end; i++)
+        {
+            if (p->code[i].stackop.op != OP_NOP) {
+                p->code[i].stackop.op = OP_NOP;
+                changed = true;
+            }
+        }
+    }
+
+    cfg_delete(&g);
+    return changed;
+}
+
+cfg cfg_new(program* p)
+{
+    boolean* leaders = find_jump_targets(p);
+    cfg g = {
+        .blocks = NULL,
+        .size = 0,
+        .block_of = malloc(sizeof(size_t) * (p->length + 1)),
+    };
+
+    // blocks start at jump targets and after every transfer of control
+    leaders[0] = true;
+
+    for (size_t i = 0; i < p->length; i++)
+    {
+        vm_op op = p->code[i].stackop.op;
+
+        if (op == OP_JMP || op == OP_RET || conditional_skip(op)) {
+            leaders[i + 1] = true;
+        }
+    }
+
+    for (size_t i = 0; i < p->length; i++) {
+        if (leaders[i]) g.size++;
+    }
+
+    g.blocks = calloc(g.size + 1, sizeof(basic_block));
+
+    for (size_t i = 0, b = 0; i < p->length; i++)
+    {
+        if (leaders[i] && i > 0) {
+            g.blocks[b++].end = i;
+        }
+        if (leaders[i]) {
+            g.blocks[b].start = i;
+        }
+        g.block_of[i] = b;
+    }
+
+    if (g.size > 0) {
+        g.blocks[g.size - 1].end = p->length;
+    }
+
+    // links blocks through the last instruction of each block
+    for (size_t b = 0; b < g.size; b++)
+    {
+        basic_block* block = &g.blocks[b];
+        size_t last = block->end - 1;
+        size_t next = block->end < p->length ? g.block_of[block->end] : CFG_EXIT;
+
+        switch (p->code[last].stackop.op)
+        {
+            case OP_RET:
+                break;
+
+            case OP_JMP:
+                block->successors[block->nsuccessors++] = jump_target(p, last) < p->length ? g.block_of[jump_target(p, last)] : CFG_EXIT;
+                break;
+
+            case OP_JIF:
+            case OP_GUARDI:
+            case OP_GUARDF:
+            case OP_FORPREP:
+            case OP_FORLOOP:
+                block->successors[block->nsuccessors++] = next;
+                block->successors[block->nsuccessors++] = last + 2 < p->length ? g.block_of[last + 2] : CFG_EXIT;
+                break;
+
+            default:
+                block->successors[block->nsuccessors++] = next;
+        }
+    }
+
+    free(leaders);
+    return g;
+}
+
+void cfg_reachability(cfg* g)
+{
+    if (g->size == 0) {
+        return;
+    }
+
+    size_t* stack = malloc(sizeof(size_t) * g->size);
+    size_t top = 0;
+
+    g->blocks[0].reachable = true;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        basic_block* block = &g->blocks[stack[--top]];
+
+        for (size_t s = 0; s < block->nsuccessors; s++)
+        {
+            size_t succ = block->successors[s];
+
+            if (succ != CFG_EXIT && !g->blocks[succ].reachable) {
+                g->blocks[succ].reachable = true;
+                stack[top++] = succ;
+            }
+        }
+    }
+
+    free(stack);
+}
+
+void cfg_delete(cfg* g)
+{
+    free(g->blocks);
+    free(g->block_of);
+    g->blocks = NULL;
+    g->size = 0;
+}
+
+boolean remove_nops(program* p)
+{
+    size_t* index = malloc(sizeof(size_t) * (p->length + 1));
+    size_t length = 0;
+
+    // maps every instruction to its position once NOPs are removed
+    for (size_t i = 0; i < p->length; i++)
+    {
+        index[i] = length;
+
+        if (p->code[i].stackop.op != OP_NOP) {
+            length++;
+        }
+    }
+
+    index[p->length] = length;
+
+    if (length == p->length) {
+        free(index);
+        return false;
+    }
+
+    // jumps to a removed instruction land on the one following it
+    for (size_t i = 0; i < p->length; i++)
+    {
+        if (p->code[i].stackop.op == OP_JMP) {
+            p->code[i].sx.sx = index[jump_target(p, i)] - index[i] - 1;
+        }
+    }
+
+    for (size_t i = 0; i < p->length; i++)
+    {
+        if (p->code[i].stackop.op != OP_NOP) {
+            p->code[index[i]] = p->code[i];
+        }
+    }
+
+    remap_line_addresses(p, index, NULL);
+    p->length = length;
+
+    free(index);
+    return true;
+}
+
+void remap_line_addresses(program* p, size_t* index, size_t* copy)
+{
+    // addresses of lines whose first instructions were removed move forward
+    map lines = map_new(2 * p->line_address_table.size + 1);
+
+    for (size_t c = 0; c < 2; c++)
+    {
+        size_t* positions = c == 0 ? index : copy;
+
+        for (size_t i = 0; positions != NULL && i < p->line_address_table.size; i++)
+        {
+            char* buf = malloc(sizeof(char) * 12);
+            sprintf(buf, "%li", positions[atoi(p->line_address_table.keys[i])]);
+            map_put(&lines, buf, p->line_address_table.values[i]);
+        }
+    }
+
+    free(p->line_address_table.keys);
+    free(p->line_address_table.values);
+    p->line_address_table = lines;
+}
+
+boolean* find_jump_targets(program* p)
+{
+    boolean* targets = calloc(p->length + 1, sizeof(boolean));
+
+    for (size_t i = 0; i < p->length; i++)
+    {
+        if (p->code[i].stackop.op == OP_JMP) {
+            targets[jump_target(p, i)] = true;
+        }
+
+        // conditional jumps skip over the instruction following them
+        if (conditional_skip(p->code[i].stackop.op) && i + 2 <= p->length) {
+            targets[i + 2] = true;
+        }
+    }
+
+    return targets;
+}
+
+boolean conditional_skip(vm_op op)
+{
+    return op == OP_JIF || op == OP_GUARDI || op == OP_GUARDF || op == OP_FORPREP || op == OP_FORLOOP;
+}
+
+size_t jump_target(program* p, size_t i)
+{
+    return i + p->code[i].sx.sx + 1;
+}
@@ -0,0 +1,195 @@
+#ifndef HE_OPTIMIZER_HEADER
+#define HE_OPTIMIZER_HEADER
+
+#include "common.h"
+#include "compiler.h"
+#include "lib.h"
+
+#define CFG_EXIT ((size_t) -1)
+
+// Straight-line run of instructions entered only at its first instruction
+typedef struct basic_block {
+    size_t start;
+    size_t end; // one past the last instruction
+    size_t successors[2];
+    size_t nsuccessors;
+    boolean reachable;
+} basic_block;
+
+// Control-flow graph of a program, block 0 is the entry
+typedef struct cfg {
+    basic_block* blocks;
+    size_t size;
+    size_t* block_of; // block index of each instruction
+} cfg;
+
+struct ir_function;
+
+// Optimization run over either the IR or the bytecode of a program
+typedef struct optimizer_pass {
+    const char* name;
+    int level; // lowest optimization level the pass runs at
+    boolean (*on_ir)(struct ir_function* f);
+    boolean (*on_bytecode)(program* p);
+} optimizer_pass;
+
+/*
+ * Optimization level selected on the command line: 0 disables all
+ * optimization, 1 runs the bytecode passes and 2 also runs the IR passes.
+ */
+extern int optimization_level;
+
+/**
+ * @brief Runs the passes enabled at the current optimization level over
+ *      a finished program and every function nested in it, functions are
+ *      optimized first once the whole program is known. Small functions
+ *      are inlined into their callers before anything else. The program is
+ *      lifted into the IR where copies are propagated, common
+ *      subexpressions are eliminated, loop invariants are hoisted,
+ *      induction variables are strength-reduced, dead stores are removed,
+ *      types are inferred and counting loops are selected. The lowered
+ *      bytecode is then rewritten until no
+ *      peephole optimization applies: constant branches are folded,
+ *      unreachable code is eliminated, jump chains are threaded,
+ *      store-load pairs of a variable are replaced by a duplicate and a
+ *      store, returned calls become tail calls and NOP instructions are
+ *      removed.
+ * 
+ * @param p Reference to program
+ */
+void optimize_program(program* p);
+
+/**
+ * @brief Inlines calls to small functions in a program and every function
+ *      nested in it. Nested functions are processed before the program
+ *      containing them.
+ *
+ * @param p Reference to program
+ */
+void inline_functions(program* p);
+
+/**
+ * @brief Reports the result of an optimizer pass, passes which rewrote
+ *      the program are logged in debug mode.
+ *
+ * @param pass Pass which ran
+ * @param changed Result of the pass
+ * @return Result of the pass
+ */
+boolean run_pass(optimizer_pass* pass, boolean changed);
+
+/**
+ * @brief Applies a single round of peephole rewrites to the bytecode
+ *      of a program. Instructions are rewritten in place and removed
+ *      instructions are replaced with OP_NOP.
+ * 
+ * @param p Reference to program
+ * @return True if any instruction was rewritten
+ */
+boolean peephole(program* p);
+
+/**
+ * @brief Turns calls whose result is returned right away into tail
+ *      calls, which reuse the frame of the caller for bytecode callees.
+ *      The return is kept for native callees, which are called as usual.
+ *      Returned calls are marked by the compiler, this catches the calls
+ *      that other rewrites leave in front of a return.
+ * 
+ * @param p Reference to program
+ * @return True if any call was turned into a tail call
+ */
+boolean mark_tail_calls(program* p);
+
+/**
+ * @brief Replaces conditional jumps on a constant with the branch that
+ *      is always taken, the other branch becomes unreachable.
+ * 
+ * @param p Reference to program
+ * @return True if any branch was folded
+ */
+boolean fold_constant_branches(program* p);
+
+/**
+ * @brief Replaces every instruction which cannot be reached from the
+ *      start of a program with OP_NOP, including code after a return
+ *      and redundant function epilogues.
+ * 
+ * @param p Reference to program
+ * @return True if any instruction was eliminated
+ */
+boolean eliminate_dead_code(program* p);
+
+/**
+ * @brief Splits the bytecode of a program into basic blocks and links
+ *      them by their control-flow successors. Jumps to the end of the
+ *      program have CFG_EXIT as successor.
+ * 
+ * @param p Reference to program
+ * @return Control-flow graph
+ */
+cfg cfg_new(program* p);
+
+/**
+ * @brief Marks every basic block reachable from the entry block.
+ * 
+ * @param g Reference to control-flow graph
+ */
+void cfg_reachability(cfg* g);
+
+/**
+ * @brief Frees the blocks of a control-flow graph.
+ * 
+ * @param g Reference to control-flow graph
+ */
+void cfg_delete(cfg* g);
+
+/**
+ * @brief Removes all OP_NOP instructions from a program and fixes up
+ *      jump offsets and the line address table.
+ * 
+ * @param p Reference to program
+ * @return True if any instruction was removed
+ */
+boolean remove_nops(program* p);
+
+/**
+ * @brief Moves the addresses in the line address table of a program to
+ *      the new positions of their instructions. Programs laid out twice
+ *      get a second set of addresses for the copy.
+ *
+ * @param p Reference to program
+ * @param index New position of each instruction and the end of the program
+ * @param copy Position of each instruction in the copy, NULL if none
+ */
+void remap_line_addresses(program* p, size_t* index, size_t* copy);
+
+/**
+ * @brief Marks every instruction which control flow can enter from
+ *      an instruction other than the one preceding it.
+ * 
+ * @param p Reference to program
+ * @return Array of flags with an entry for each instruction and the end
+ *      of the program
+ */
+boolean* find_jump_targets(program* p);
+
+/**
+ * @brief Checks whether an operation conditionally skips the instruction
+ *      following it, which is always a jump: OP_JIF, the guards and
+ *      the counted loop operations.
+ *
+ * @param op Operation
+ * @return True if operation skips the next instruction
+ */
+boolean conditional_skip(vm_op op);
+
+/**
+ * @brief Returns the index of the instruction a jump transfers control to.
+ * 
+ * @param p Reference to program
+ * @param i Index of OP_JMP instruction
+ * @return Target instruction index
+ */
+size_t jump_target(program* p, size_t i);
+
+#endif
@@ -1,9 +1,34 @@
 #include "parser.h"
 
 int precedence(parser* p, lxtoken* op);
-astnode* apply_op(vector* primaries, vector* operators);
+astref apply_op(parser* p, lxtoken* op, astref lhs, astref rhs);
 void strip_newlines(parser* p);
-astnode* astnode_new(const char* value, asttype type, lxpos pos);
+astref parse_body(parser* p, astref parent, astref last);
+
+// Binding power of binary operators, indexed by the operator kind.
+// Operators with no precedence cannot be binary. Every binary operator
+// is left associative, ^ is a bitwise xor and not a power.
+static const int operator_precedence[] = {
+    [LXOP_NONE] = 0,
+    [LXOP_ADD]  = 9,
+    [LXOP_SUB]  = 9,
+    [LXOP_MUL]  = 10,
+    [LXOP_DIV]  = 10,
+    [LXOP_MOD]  = 10,
+    [LXOP_LT]   = 8,
+    [LXOP_LE]   = 8,
+    [LXOP_GT]   = 8,
+    [LXOP_GE]   = 8,
+    [LXOP_EQ]   = 7,
+    [LXOP_NE]   = 7,
+    [LXOP_AND]  = 3,
+    [LXOP_OR]   = 2,
+    [LXOP_NOT]  = 0,
+    [LXOP_BAND] = 6,
+    [LXOP_BOR]  = 4,
+    [LXOP_BXOR] = 5,
+    [LXOP_BNOT] = 0,
+};
 
 
 // ------------------ TOKEN TRAVERSAL ------------------
@@ -57,79 +82,79 @@ boolean is_empty(parser* p)
 
 // ------------------ PARSING METHODS ------------------
 
-astnode* parse(parser* p)
+astref parse(parser* p)
 {
-    astnode* tree = parse_block(p, LX_EOF);
+    astref tree = parse_block(p, LX_EOF);
     return tree;
 }
 
-astnode* parse_block(parser* p, lxtype terminal)
+astref parse_block(parser* p, lxtype terminal)
 {
-    astnode* block = astnode_new("block", LX_BLOCK, clone_pos(&peek(p)->pos));
+    ast* t = &p->tree;
+    astref block = ast_node(t, AST_BLOCK, NULL, &peek(p)->pos);
+    astref last = ASTREF_NONE;
 
     strip_newlines(p);
     
     while (!is_empty(p) && peek(p)->type != terminal) 
     {
-        astnode* st = parse_statement(p);
-        vector_push(&block->children, st);
+        last = ast_append(t, block, last, parse_statement(p));
         strip_newlines(p);
     }
 
     return block;
 }
 
-astnode* parse_statement(parser* p)
+astref parse_statement(parser* p)
 {
-    astnode* st = astnode_new(NULL, AST_ASSIGN, clone_pos(&peek(p)->pos));
+    ast* t = &p->tree;
+    astref st = ASTREF_NONE;
+    lxtoken* tk = peek(p);
 
-    switch (peek(p)->type)
+    switch (tk->type)
     {
         case LX_SYMBOL:
             if (lookahead(p)->type == LX_LEFT_SQUARE || lookahead(p)->type == LX_DOT) {
-                free(st);
                 st = parse_table_put(p);
             } else {
-                st->type = AST_ASSIGN;
-                st->value = eat(p)->value;
+                st = ast_node(t, AST_ASSIGN, eat(p)->value, &tk->pos);
                 consume(p, LX_ASSIGN);
-                vector_push(&st->children, parse_expression(p));
+                ast_append(t, st, ASTREF_NONE, parse_expression(p));
             }
             break;
 
         case LX_CALL:
-            free(st);
             st = parse_function_call(p);
             break;
         
         case LX_LOOP:
-            free(st);
             st = parse_loop(p);
             break;
+
+        case LX_FOR:
+            st = parse_for(p);
+            break;
         
         case LX_IF:
-            free(st);
             st = parse_branching(p);
             break;
         
         case LX_INCLUDE:
             eat(p);
-            st->type = AST_INCLUDE;
-            st->value = "include";
+            st = ast_node(t, AST_INCLUDE, NULL, &tk->pos);
             
-            astnode* fp = parse_primary(p);
-            if (fp->type != AST_STRING) {
+            astref fp = parse_primary(p);
+            if (t->kinds[fp] != AST_STRING) {
                 parsererror(p, "Expected string in include statement!");
             }
 
-            vector_push(&st->children, fp);
+            ast_append(t, st, ASTREF_NONE, fp);
             break;
 
         case LX_RETURN:
             eat(p);
-            st->type = AST_RETURN;
-            st->value = "ret";
-            vector_push(&st->children, parse_expression(p));
+            st = ast_node(t, AST_RETURN, NULL, &tk->pos);
+            ast_append(t, st, ASTREF_NONE, parse_expression(p));
             break;
 
         default:
@@ -140,101 +165,88 @@ astnode* parse_statement(parser* p)
     return st;
 }
 
-astnode* parse_expression(parser* p)
+astref parse_expression(parser* p)
 {
-    vector primaries = vector_new(8);
-    vector operators = vector_new(8);
+    return parse_binary_expression(p, 1);
+}
 
-    vector_push(&primaries, parse_primary(p));
+astref parse_binary_expression(parser* p, int min_precedence)
+{
+    astref lhs = parse_primary(p);
 
     // Non-primary expression
     while (!is_empty(p) && peek(p)->type == LX_OPERATOR) 
     {
-        lxtoken* op = eat(p);
+        lxtoken* op = peek(p);
+        int prec = precedence(p, op);
 
-        // Applies shunting yard algorithm
-        while (operators.size > 0 && precedence(p, op) <= precedence(p, vector_top(&operators))) 
-        {
-            vector_push(&primaries, apply_op(&primaries, &operators));
+        if (prec < min_precedence) {
+            break;
         }
 
-        vector_push(&operators, op);
-        vector_push(&primaries, parse_primary(p));
-    }
+        eat(p);
 
-    // Applies remaining operations
-    while (operators.size > 0) 
-    {
-        vector_push(&primaries, apply_op(&primaries, &operators));
+        // operators are left associative, so only tighter ones bind on the right
+        astref rhs = parse_binary_expression(p, prec + 1);
+        lhs = apply_op(p, op, lhs, rhs);
     }
 
-    return vector_pop(&primaries);
+    return lhs;
 }
 
-astnode* parse_primary(parser* p)
+astref parse_primary(parser* p)
 {
     if (is_empty(p)) {
         parsererror(p, "Program has ended prematurely!");
     }
 
-    astnode* node = (astnode*)malloc(sizeof(astnode));
-    node->pos = clone_pos(&peek(p)->pos);
-    node->children = vector_new(1);
+    ast* t = &p->tree;
+    astref node = ASTREF_NONE;
+    lxtoken* tk = peek(p);
 
-    switch (peek(p)->type)
+    switch (tk->type)
     {
         case LX_INTEGER:
-            node->type = AST_INTEGER;
-            node->value = eat(p)->value;
+            node = ast_node(t, AST_INTEGER, eat(p)->value, &tk->pos);
             break;
 
         case LX_FLOAT:
-            node->type = AST_FLOAT;
-            node->value = eat(p)->value;
+            node = ast_node(t, AST_FLOAT, eat(p)->value, &tk->pos);
             break;
         
         case LX_BOOL:
-            node->type = AST_BOOL;
-            node->value = eat(p)->value;
+            node = ast_node(t, AST_BOOL, eat(p)->value, &tk->pos);
             break;
         
         case LX_STRING:
-            node->type = AST_STRING;
-            node->value = eat(p)->value;
+            node = ast_node(t, AST_STRING, eat(p)->value, &tk->pos);
             break;
 
         case LX_NULL:
-            node->type = AST_NULL;
-            node->value = eat(p)->value;
+            node = ast_node(t, AST_NULL, eat(p)->value, &tk->pos);
             break;
 
         case LX_LEFT_BRACE:
-            free(node);
             node = parse_table_instance(p);
             break;
         
         case LX_SYMBOL:
             if (lookahead(p)->type == LX_LEFT_SQUARE || lookahead(p)->type == LX_DOT) {
-                free(node);
                 node = parse_table_get(p);
             } else {
-                node->type = AST_REFERENCE;
-                node->value = eat(p)->value;
+                node = ast_node(t, AST_REFERENCE, eat(p)->value, &tk->pos);
             }
             break;
             
         case LX_FUNCTION:
-            free(node);
             node = parse_function_definition(p);
             break;
         
         case LX_CALL:
-            free(node);
             node = parse_function_call(p);
             break;
 
         case LX_LEFT_PAREN:
-            free(node);
             consume(p, LX_LEFT_PAREN);
             node = parse_expression(p);
             consume(p, LX_RIGHT_PAREN);
@@ -242,14 +254,20 @@ astnode* parse_primary(parser* p)
 
         case LX_OPERATOR:
             // validates operator as unary
-            if (strcmp(peek(p)->value, "-") && strcmp(peek(p)->value, "+") 
-                    && strcmp(peek(p)->value, "!") && strcmp(peek(p)->value, "~")) {
-                parsererror(p, "Invalid unary operator");
+            switch (tk->op)
+            {
+                case LXOP_SUB:
+                case LXOP_ADD:
+                case LXOP_NOT:
+                case LXOP_BNOT:
+                    break;
+                default:
+                    parsererror(p, "Invalid unary operator");
             }
 
-            node->type = AST_UNARY_EXPRESSION;
-            node->value = eat(p)->value;
-            vector_push(&node->children, parse_primary(p));
+            node = ast_node(t, AST_UNARY_EXPRESSION, NULL, &tk->pos);
+            t->ops[node] = eat(p)->op;
+            ast_append(t, node, ASTREF_NONE, parse_primary(p));
             break;
 
         default:
@@ -259,16 +277,13 @@ astnode* parse_primary(parser* p)
     return node;
 }
 
-astnode* parse_function_call(parser* p)
+astref parse_function_call(parser* p)
 {
+    ast* t = &p->tree;
     consume(p, LX_CALL);
 
-    astnode* fcall = (astnode*) malloc(sizeof(astnode));
-    fcall->type = AST_CALL;
-    fcall->pos = clone_pos(&peek(p)->pos);
-    fcall->value = peek(p)->value;
-    fcall->children = vector_new(4);
-    vector_push(&fcall->children, parse_expression(p));
+    astref fcall = ast_node(t, AST_CALL, NULL, &peek(p)->pos);
+    astref last = ast_append(t, fcall, ASTREF_NONE, parse_expression(p));
 
     consume(p, LX_LEFT_PAREN);
 
@@ -276,7 +291,7 @@ astnode* parse_function_call(parser* p)
     {
         do 
         {
-            vector_push(&fcall->children, parse_expression(p));
+            last = ast_append(t, fcall, last, parse_expression(p));
         } 
         while (consume_optional(p, LX_SEPARATOR));
     }
@@ -286,93 +301,108 @@ astnode* parse_function_call(parser* p)
     return fcall;
 }
 
-astnode* parse_function_definition(parser* p)
+astref parse_function_definition(parser* p)
 {
-    astnode* func = astnode_new("code", AST_FUNCTION, clone_pos(&consume(p, LX_FUNCTION)->pos));;
-    astnode* params = astnode_new("args", AST_PARAMS, clone_pos(&consume(p, LX_LEFT_PAREN)->pos));
-    vector_push(&func->children, params);
+    ast* t = &p->tree;
+    astref func = ast_node(t, AST_FUNCTION, NULL, &consume(p, LX_FUNCTION)->pos);
+    astref params = ast_node(t, AST_PARAMS, NULL, &consume(p, LX_LEFT_PAREN)->pos);
+    astref last = ASTREF_NONE;
 
     // code header
     if (peek(p)->type != LX_RIGHT_PAREN) 
     {
         do {
             lxtoken* param = consume(p, LX_SYMBOL);
-            vector_push(&params->children, astnode_new(param->value, AST_PARAM, clone_pos(&param->pos)));
+            last = ast_append(t, params, last, ast_node(t, AST_PARAM, param->value, &param->pos));
         } 
         while (consume_optional(p, LX_SEPARATOR));
     }
     consume(p, LX_RIGHT_PAREN);
 
     // code body
-    strip_newlines(p);
-    consume(p, LX_LEFT_BRACE);
-    vector_push(&func->children, parse_block(p, LX_RIGHT_BRACE));
-    consume(p, LX_RIGHT_BRACE);
+    parse_body(p, func, ast_append(t, func, ASTREF_NONE, params));
 
     return func;
 }
 
-astnode* parse_loop(parser* p)
+astref parse_loop(parser* p)
 {
-    astnode* loop = astnode_new("loop", AST_LOOP, clone_pos(&consume(p, LX_LOOP)->pos));
+    ast* t = &p->tree;
+    astref loop = ast_node(t, AST_LOOP, NULL, &consume(p, LX_LOOP)->pos);
     
     // loop condition
-    vector_push(&loop->children, parse_expression(p));
+    astref cond = ast_append(t, loop, ASTREF_NONE, parse_expression(p));
 
     // loop body
-    strip_newlines(p);
-    consume(p, LX_LEFT_BRACE);
-    vector_push(&loop->children, parse_block(p, LX_RIGHT_BRACE));
-    consume(p, LX_RIGHT_BRACE);
+    parse_body(p, loop, cond);
+
+    return loop;
+}
+
+astref parse_for(parser* p)
+{
+    ast* t = &p->tree;
+    lxpos pos = consume(p, LX_FOR)->pos;
+    astref loop = ast_node(t, AST_FOR, consume(p, LX_SYMBOL)->value, &pos);
+    consume(p, LX_ASSIGN);
+
+    // start and limit of range, followed by the optional step
+    astref last = ast_append(t, loop, ASTREF_NONE, parse_expression(p));
+    consume(p, LX_SEPARATOR);
+    last = ast_append(t, loop, last, parse_expression(p));
+
+    if (consume_optional(p, LX_SEPARATOR)) {
+        last = ast_append(t, loop, last, parse_expression(p));
+    }
+
+    // loop body
+    parse_body(p, loop, last);
 
     return loop;
 }
 
-astnode* parse_branching(parser* p)
+astref parse_branching(parser* p)
 {
-    astnode* branch0 = astnode_new("conditional", AST_BRANCHES, clone_pos(&consume(p, LX_IF)->pos));
+    ast* t = &p->tree;
+    astref branch0 = ast_node(t, AST_BRANCHES, NULL, &consume(p, LX_IF)->pos);
 
     // if condition { ... } branch
-    vector_push(&branch0->children, parse_expression(p));
-    
-    strip_newlines(p);
-    consume(p, LX_LEFT_BRACE);
-    vector_push(&branch0->children, parse_block(p, LX_RIGHT_BRACE));
-    consume(p, LX_RIGHT_BRACE);
+    astref last = ast_append(t, branch0, ASTREF_NONE, parse_expression(p));
+    last = parse_body(p, branch0, last);
     strip_newlines(p);
 
-    // else and else if { ... } branches
-    astnode* branchx = branch0;
+    // else and else if { ... } branches, an else branch only has a
+    // body whereas else if branches also have a condition
+    astref branchx = branch0;
     while (peek(p)->type == LX_ELSE)
     {
-        astnode* branch = astnode_new(NULL, AST_BRANCHES, clone_pos(&eat(p)->pos));
+        astref branch = ast_node(t, AST_BRANCHES, NULL, &eat(p)->pos);
+        boolean alt = !consume_optional(p, LX_IF);
+        astref last0 = ASTREF_NONE;
 
-        if (consume_optional(p, LX_IF)) {
-            branch->value = "conditional";
-            vector_push(&branch->children, parse_expression(p));
-        } else {
-            branch->value = "alt";
+        if (!alt) {
+            last0 = ast_append(t, branch, last0, parse_expression(p));
         }
         
-        strip_newlines(p);
-        consume(p, LX_LEFT_BRACE);
-        vector_push(&branch->children, parse_block(p, LX_RIGHT_BRACE));
-        consume(p, LX_RIGHT_BRACE);
+        parse_body(p, branch, last0);
         strip_newlines(p);
         
         // recursive if statement
-        vector_push(&branchx->children, branch);
+        last = ast_append(t, branchx, last, branch);
         branchx = branch;
+        last = ast_child(t, branch, alt ? 0 : 1);
 
-        if (streq(branch->value, "alt")) break;
+        if (alt) break;
     }
 
     return branch0;   
 }
 
-astnode* parse_table_instance(parser* p)
+astref parse_table_instance(parser* p)
 {
-    astnode* table = astnode_new("table", AST_TABLE, clone_pos(&consume(p, LX_LEFT_BRACE)->pos));
+    ast* t = &p->tree;
+    astref table = ast_node(t, AST_TABLE, NULL, &consume(p, LX_LEFT_BRACE)->pos);
+    astref last = ASTREF_NONE;
     strip_newlines(p);
 
     // parses table entries
@@ -380,12 +410,12 @@ astnode* parse_table_instance(parser* p)
     {
         do {
             strip_newlines(p);
-            astnode* element = astnode_new("pair", AST_KV_PAIR, clone_pos(&peek(p)->pos));
-            vector_push(&element->children, parse_expression(p));
+            astref element = ast_node(t, AST_KV_PAIR, NULL, &peek(p)->pos);
+            astref key = ast_append(t, element, ASTREF_NONE, parse_expression(p));
             consume(p, LX_COLON);
-            vector_push(&element->children, parse_expression(p));
+            ast_append(t, element, key, parse_expression(p));
             strip_newlines(p);
-            vector_push(&table->children, element);
+            last = ast_append(t, table, last, element);
         } 
         while (consume_optional(p, LX_SEPARATOR));
     }
@@ -394,41 +424,43 @@ astnode* parse_table_instance(parser* p)
     return table;
 }
 
-astnode* parse_table_put(parser* p)
+astref parse_table_put(parser* p)
 {
+    ast* t = &p->tree;
     lxtoken* var = consume(p, LX_SYMBOL);
-    astnode* put = astnode_new(var->value, AST_PUT, clone_pos(&var->pos));
-
+    astref put = ast_node(t, AST_PUT, var->value, &var->pos);
+    astref key = ASTREF_NONE;
 
     if (consume_optional(p, LX_LEFT_SQUARE)) {
-        vector_push(&put->children, parse_expression(p));
+        key = ast_append(t, put, key, parse_expression(p));
         consume(p, LX_RIGHT_SQUARE);
     }
     else if (consume_optional(p, LX_DOT))
     {
         lxtoken* tk = consume(p, LX_SYMBOL);
-        vector_push(&put->children, astnode_new(tk->value, AST_STRING, clone_pos(&tk->pos)));
+        key = ast_append(t, put, key, ast_node(t, AST_STRING, tk->value, &tk->pos));
     }
 
     consume(p, LX_ASSIGN);
-    vector_push(&put->children, parse_expression(p));
+    ast_append(t, put, key, parse_expression(p));
     return put;
 }
 
-astnode* parse_table_get(parser* p)
+astref parse_table_get(parser* p)
 {
+    ast* t = &p->tree;
     lxtoken* var = consume(p, LX_SYMBOL);
-    astnode* get = astnode_new(var->value, AST_GET, clone_pos(&var->pos));
+    astref get = ast_node(t, AST_GET, var->value, &var->pos);
 
     if (consume_optional(p, LX_LEFT_SQUARE))
     {
-        vector_push(&get->children, parse_expression(p));
+        ast_append(t, get, ASTREF_NONE, parse_expression(p));
         consume(p, LX_RIGHT_SQUARE);
     }
     else if (consume_optional(p, LX_DOT))
     {
         lxtoken* tk = consume(p, LX_SYMBOL);
-        vector_push(&get->children, astnode_new(tk->value, AST_STRING, clone_pos(&tk->pos)));
+        ast_append(t, get, ASTREF_NONE, ast_node(t, AST_STRING, tk->value, &tk->pos));
     }
 
     return get;
@@ -436,14 +468,17 @@ astnode* parse_table_get(parser* p)
 
 // ------------------ UTILITY METHODS ------------------
 
-astnode* astnode_new(const char* value, asttype type, lxpos pos) 
+/**
+ * Parses a brace enclosed statement block and appends it as a child of
+ * the parent node after the last child provided. 
+ */
+astref parse_body(parser* p, astref parent, astref last)
 {
-    astnode* node = (astnode*)malloc(sizeof(astnode));
-    node->value = value;
-    node->type = type;
-    node->children = vector_new(4);
-    node->pos = pos;
-    return node;
+    strip_newlines(p);
+    consume(p, LX_LEFT_BRACE);
+    astref block = ast_append(&p->tree, parent, last, parse_block(p, LX_RIGHT_BRACE));
+    consume(p, LX_RIGHT_BRACE);
+    return block;
 }
 
 /**
@@ -452,53 +487,24 @@ astnode* astnode_new(const char* value, asttype type, lxpos pos)
  */
 int precedence(parser* p, lxtoken* op)
 {
-    if (streq(op->value, "<=") || streq(op->value, ">="))
-        return 8;
-    else if (streq(op->value, "==") || streq(op->value, "!="))
-        return 7;
-    else if (streq(op->value, "&&"))
-        return 3;
-    else if (streq(op->value, "||"))
-        return 2;
-    
-    switch (op->value[0])
-    {
-        case '|':
-            return 4;
-        case '^':
-            return 5;
-        case '&':
-            return 6;
-        case '<':
-        case '>':
-            return 8;
-        case '+':
-        case '-':
-            return 9;
-        case '*':    
-        case '/':    
-        case '%':
-            return 10;    
-        default:
-            parsererror(p, "Unknown operator recieved");
+    int prec = operator_precedence[op->op];
+
+    if (prec == 0) {
+        parsererror(p, "Unknown operator recieved");
     }
-    return 0;
+    return prec;
 }
 
 /**
  * Applies binary operation by forming a binary Abstract syntax tree
  * with the operator as the root and the operands as the children. 
  */
-astnode* apply_op(vector* operands, vector* operators)
+astref apply_op(parser* p, lxtoken* op, astref lhs, astref rhs)
 {
-    lxtoken *op, *v0, *v1;
-    op = (lxtoken*) vector_pop(operators);
-    v1 = (lxtoken*) vector_pop(operands);
-    v0 = (lxtoken*) vector_pop(operands);
-
-    astnode* expression = astnode_new(op->value, AST_BINARY_EXPRESSION, clone_pos(&op->pos));
-    vector_push(&expression->children, v0);
-    vector_push(&expression->children, v1);
+    ast* t = &p->tree;
+    astref expression = ast_node(t, AST_BINARY_EXPRESSION, NULL, &op->pos);
+    t->ops[expression] = op->op;
+    ast_append(t, expression, ast_append(t, expression, ASTREF_NONE, lhs), rhs);
     return expression;
 }
 
@@ -507,25 +513,241 @@ void strip_newlines(parser* p)
     while (consume_optional(p, LX_NEWLINE));
 }
 
+// ----------------- SYNTAX TREE -----------------
+
+ast ast_new(const char* origin, const char* src)
+{
+    size_t capacity = 64;
+    ast t = {
+        .kinds = malloc(sizeof(uint8_t) * capacity),
+        .ops = malloc(sizeof(uint8_t) * capacity),
+        .children = malloc(sizeof(astref) * capacity),
+        .siblings = malloc(sizeof(astref) * capacity),
+        .spans = malloc(sizeof(astspan) * capacity),
+        .literals = malloc(sizeof(int32_t) * capacity),
+        .folds = NULL,
+        .folded = NULL,
+        .types = NULL,
+        .size = 0,
+        .capacity = capacity,
+        .strings = malloc(sizeof(char) * 256),
+        .strings_size = 0,
+        .strings_capacity = 256,
+        .interned = calloc(64, sizeof(int32_t)),
+        .interned_mask = 63,
+        .interned_count = 0,
+        .origin = origin,
+        .src = src
+    };
+    return t;
+}
+
+// Slot of a literal in the intern hash, or the empty slot it belongs in
+static int32_t* ast_intern_slot(ast* t, const char* value)
+{
+    for (size_t s = strhash(value) & t->interned_mask; ; s = (s + 1) & t->interned_mask)
+    {
+        int32_t* slot = &t->interned[s];
+
+        if (*slot == 0 || streq(&t->strings[*slot - 1], value)) {
+            return slot;
+        }
+    }
+}
+
+// Offset of a literal in the string buffer, appending it the first time it is seen
+static int32_t ast_intern(ast* t, const char* value)
+{
+    int32_t* slot = ast_intern_slot(t, value);
+
+    if (*slot != 0) {
+        return *slot - 1;
+    }
+
+    size_t length = strlen(value) + 1;
+
+    while (t->strings_size + length > t->strings_capacity) {
+        t->strings_capacity *= 2;
+        t->strings = realloc(t->strings, sizeof(char) * t->strings_capacity);
+    }
+
+    memcpy(&t->strings[t->strings_size], value, length);
+    *slot = t->strings_size + 1;
+    t->strings_size += length;
+
+    // the hash is kept at most half full
+    if (2 * ++t->interned_count > t->interned_mask)
+    {
+        int32_t* old = t->interned;
+        size_t slots = t->interned_mask + 1;
+
+        t->interned_mask = slots * 2 - 1;
+        t->interned = calloc(slots * 2, sizeof(int32_t));
+
+        for (size_t s = 0; s < slots; s++) {
+            if (old[s] != 0) *ast_intern_slot(t, &t->strings[old[s] - 1]) = old[s];
+        }
+        free(old);
+    }
+
+    return t->strings_size - length;
+}
+
+astref ast_node(ast* t, asttype type, const char* value, lxpos* pos)
+{
+    // grows every node array together
+    if (t->size == t->capacity) {
+        t->capacity *= 2;
+        t->kinds = realloc(t->kinds, sizeof(uint8_t) * t->capacity);
+        t->ops = realloc(t->ops, sizeof(uint8_t) * t->capacity);
+        t->children = realloc(t->children, sizeof(astref) * t->capacity);
+        t->siblings = realloc(t->siblings, sizeof(astref) * t->capacity);
+        t->spans = realloc(t->spans, sizeof(astspan) * t->capacity);
+        t->literals = realloc(t->literals, sizeof(int32_t) * t->capacity);
+    }
+
+    astref node = t->size++;
+    t->kinds[node] = type;
+    t->ops[node] = LXOP_NONE;
+    t->children[node] = ASTREF_NONE;
+    t->siblings[node] = ASTREF_NONE;
+    t->spans[node].offset = pos->char_offset;
+    t->spans[node].line = pos->line_pos;
+    t->literals[node] = -1;
+
+    if (value != NULL) {
+        t->literals[node] = ast_intern(t, value);
+    }
+
+    return node;
+}
+
+astref ast_append(ast* t, astref parent, astref last, astref child)
+{
+    if (last == ASTREF_NONE) {
+        t->children[parent] = child;
+    } else {
+        t->siblings[last] = child;
+    }
+    return child;
+}
+
+astref ast_child(ast* t, astref node, size_t index)
+{
+    astref child = t->children[node];
+
+    while (index-- > 0 && child != ASTREF_NONE) {
+        child = t->siblings[child];
+    }
+    return child;
+}
+
+size_t ast_count(ast* t, astref node)
+{
+    size_t count = 0;
+
+    for (astref child = t->children[node]; child != ASTREF_NONE; child = t->siblings[child]) {
+        count++;
+    }
+    return count;
+}
+
+const char* ast_value(ast* t, astref node)
+{
+    if (t->literals[node] < 0) {
+        return NULL;
+    }
+    return &t->strings[t->literals[node]];
+}
+
+lxpos ast_pos(ast* t, astref node)
+{
+    int offset = t->spans[node].offset;
+    int line_offset = offset;
+
+    // walks back to the beginning of the line
+    while (line_offset > 0 && t->src[line_offset - 1] != '\n') {
+        line_offset--;
+    }
+
+    lxpos pos = {
+        .col_pos = offset - line_offset,
+        .line_pos = t->spans[node].line,
+        .char_offset = offset,
+        .line_offset = line_offset,
+        .origin = t->origin,
+        .src = t->src
+    };
+    return pos;
+}
+
+void ast_delete(ast* t)
+{
+    free(t->kinds);
+    free(t->ops);
+    free(t->children);
+    free(t->siblings);
+    free(t->spans);
+    free(t->literals);
+    free(t->folds);
+    free(t->folded);
+    free(t->types);
+    free(t->interned);
+    t->size = t->capacity = 0;
+}
+
 #ifdef HE_DEBUG_MODE
-const char* astnode_tostr(astnode* node)
+const char* asttype_strings[] = {
+    "root",
+    "int",
+    "float",
+    "bool",
+    "string",
+    "null",
+    "ref",
+    "call",
+    "unary",
+    "binary",
+    "block",
+    "assign",
+    "code",
+    "args",
+    "param",
+    "ret",
+    "loop",
+    "conditional",
+    "include",
+    "table",
+    "pair",
+    "put",
+    "get",
+    "for",
+};
+
+const char* astnode_tostr(ast* t, astref node)
 {
-    if (node->children.size == 0) {
-        return node->value;
+    const char* value = ast_value(t, node);
+
+    if (value == NULL) {
+        value = asttype_strings[t->kinds[node]];
+    }
+
+    if (t->children[node] == ASTREF_NONE) {
+        return value;
     }
 
     char buf[10000];
-    sprintf(buf, node->type == AST_BLOCK ? "[" : "(%s", node->value);
+    sprintf(buf, t->kinds[node] == AST_BLOCK ? "[" : "(%s", value);
     
-    for (size_t i = 0; i < node->children.size; i++) 
+    size_t i = 0;
+    for (astref child = t->children[node]; child != ASTREF_NONE; child = t->siblings[child]) 
     {
-        astnode* child = vector_get(&node->children, i);
-        sprintf(buf + strlen(buf), " %li:%s", i, astnode_tostr(child));
+        sprintf(buf + strlen(buf), " %li:%s", i++, astnode_tostr(t, child));
     }
 
-    sprintf(buf + strlen(buf), node->type == AST_BLOCK ? "]" : ")");
+    sprintf(buf + strlen(buf), t->kinds[node] == AST_BLOCK ? "]" : ")");
 
-    char* out = (char*)malloc(sizeof(char) * strlen(buf));
+    char* out = (char*)malloc(sizeof(char) * (strlen(buf) + 1));
     strcpy(out, buf);
     return out;
 }
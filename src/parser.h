@@ -7,12 +7,6 @@
 
 #define PV2S(x) printf("%s\n", value_to_str(x));
 
-typedef struct parser {
-    int position;
-    vector tokens;
-    const char* source;
-} parser;
-
 typedef enum asttype {
     AST_ROOT,
     AST_INTEGER,
@@ -36,15 +30,59 @@ typedef enum asttype {
     AST_TABLE,
     AST_KV_PAIR,
     AST_PUT,
-    AST_GET
+    AST_GET,
+    AST_FOR
 } asttype;
 
-typedef struct astnode {
-    const char* value;
-    asttype type;
-    vector children;
-    lxpos pos;
-} astnode;
+// Index of a node within an abstract syntax tree
+typedef int32_t astref;
+
+#define ASTREF_NONE -1
+
+// Compact source location of a node, the column and line offset are
+// recovered from the source when a full lexer position is needed
+typedef struct astspan {
+    uint32_t offset;
+    uint32_t line;
+} astspan;
+
+/**
+ * Abstract syntax tree stored as parallel arrays indexed by astref.
+ * Children of a node form a linked list through the sibling array.
+ * Literal text (values, symbols) is interned into one contiguous buffer
+ * of NUL terminated strings and nodes refer to it by offset, so equal
+ * literals are stored once.
+ */
+typedef struct ast {
+    uint8_t* kinds;
+    uint8_t* ops;
+    astref* children;
+    astref* siblings;
+    astspan* spans;
+    int32_t* literals;
+    uint8_t* folds;         // fold state of each node, filled in by the compiler
+    struct Value* folded;   // constant each folded node evaluates to
+    uint8_t* types;         // static type of each node plus one, 0 until inferred
+    size_t size;
+    size_t capacity;
+
+    char* strings;         // interned literals packed back to back
+    size_t strings_size;
+    size_t strings_capacity;
+    int32_t* interned;     // hash of literal offsets plus one, 0 for an empty slot
+    size_t interned_mask;  // number of slots minus one
+    size_t interned_count;
+
+    const char* origin;
+    const char* src;
+} ast;
+
+typedef struct parser {
+    int position;
+    vector tokens;
+    const char* source;
+    ast tree;
+} parser;
 
 /**
  * @brief Returns the token at the current parser position without
@@ -110,7 +148,7 @@ void parsererror(parser* p, const char* msg);
  * @param p Reference to parser
  * @return Root AST node
  */
-astnode* parse(parser* p);
+astref parse(parser* p);
 
 /**
  * @brief Parses multiple statements until a terminal token is hit
@@ -120,7 +158,7 @@ astnode* parse(parser* p);
  * @param terminal Terminal token
  * @return AST node
  */
-astnode* parse_block(parser* p, lxtype terminal);
+astref parse_block(parser* p, lxtype terminal);
 
 /**
  * @brief Parses single-line statements i.e variable assignments,
@@ -129,7 +167,7 @@ astnode* parse_block(parser* p, lxtype terminal);
  * @param p Reference to parser
  * @return AST node
  */
-astnode* parse_statement(parser* p);
+astref parse_statement(parser* p);
 
 /**
  * @brief Parses funcion definition into a syntax node with argument
@@ -138,7 +176,7 @@ astnode* parse_statement(parser* p);
  * @param p Reference to parser
  * @return AST node
  */
-astnode* parse_function_definition(parser* p);
+astref parse_function_definition(parser* p);
 
 /**
  * @brief Parses expression tokens into an abstract syntax tree.
@@ -146,7 +184,18 @@ astnode* parse_function_definition(parser* p);
  * @param p Reference to parser
  * @return AST node
  */
-astnode* parse_expression(parser* p);
+astref parse_expression(parser* p);
+
+/**
+ * @brief Parses a binary expression using precedence climbing, only
+ *      consuming operators that bind at least as tightly as the
+ *      minimum precedence provided.
+ * 
+ * @param p Reference to parser
+ * @param min_precedence Lowest operator precedence to consume
+ * @return AST node
+ */
+astref parse_binary_expression(parser* p, int min_precedence);
 
 /**
  * @brief Parses an expression primary i.e integers, variable refs,
@@ -156,7 +205,7 @@ astnode* parse_expression(parser* p);
  * @param p Reference to parser
  * @return AST node
  */
-astnode* parse_primary(parser* p);
+astref parse_primary(parser* p);
 
 /**
  * @brief Parses a function call expression primary including
@@ -165,7 +214,7 @@ astnode* parse_primary(parser* p);
  * @param p Reference to parser
  * @return AST node
  */
-astnode* parse_function_call(parser* p);
+astref parse_function_call(parser* p);
 
 /**
  * @brief Parses while loop control structure.
@@ -173,7 +222,16 @@ astnode* parse_function_call(parser* p);
  * @param p Reference to parser
  * @return AST node
  */
-astnode* parse_loop(parser* p);
+astref parse_loop(parser* p);
+
+/**
+ * @brief Parses numeric for loop over an int range e.g.
+ *      for i <- start, limit, step { ... } where the step is optional.
+ * 
+ * @param p Reference to parser
+ * @return AST node
+ */
+astref parse_for(parser* p);
 
 /**
  * @brief Parses if-else_if-else block, branching control structure.
@@ -181,7 +239,7 @@ astnode* parse_loop(parser* p);
  * @param p Reference to parser
  * @return AST node
  */
-astnode* parse_branching(parser* p);
+astref parse_branching(parser* p);
 
 /**
  * @brief Parses table definition with key value pairs.
@@ -189,7 +247,7 @@ astnode* parse_branching(parser* p);
  * @param p Reference to parser
  * @return AST node
  */
-astnode* parse_table_instance(parser* p);
+astref parse_table_instance(parser* p);
 
 /**
  * @brief Parses table key-value insertion statement e.g t[k] <- v
@@ -197,7 +255,7 @@ astnode* parse_table_instance(parser* p);
  * @param p Reference to parser
  * @return AST node
  */
-astnode* parse_table_put(parser* p);
+astref parse_table_put(parser* p);
 
 /**
  * @brief Parses table key-fetch primary into syntax node e.g t[k]
@@ -205,15 +263,100 @@ astnode* parse_table_put(parser* p);
  * @param p Reference to parser
  * @return AST node
  */
-astnode* parse_table_get(parser* p);
+astref parse_table_get(parser* p);
 
 /**
  * @brief Represents abstract syntax tree into a string representation
  *      to be printed out.
  * 
+ * @param t Reference to syntax tree
  * @param node Abstract syntax node
  * @return String
  */
-const char* astnode_tostr(astnode* node);
+const char* astnode_tostr(ast* t, astref node);
+
+// ----------------- SYNTAX TREE -----------------
+
+/**
+ * @brief Syntax tree constructor allocates empty node arrays for
+ *      a single source file.
+ * 
+ * @param origin Path of source file
+ * @param src Source code string
+ * @return Syntax tree
+ */
+ast ast_new(const char* origin, const char* src);
+
+/**
+ * @brief Appends a new childless node to the syntax tree and returns
+ *      its index.
+ * 
+ * @param t Reference to syntax tree
+ * @param type Node type
+ * @param value Literal text of node, can be NULL
+ * @param pos Position of node in source
+ * @return AST node
+ */
+astref ast_node(ast* t, asttype type, const char* value, lxpos* pos);
+
+/**
+ * @brief Links a node as the last child of a parent node. The previous
+ *      last child is passed in so lists are built in constant time.
+ * 
+ * @param t Reference to syntax tree
+ * @param parent Parent node
+ * @param last Current last child of parent or ASTREF_NONE
+ * @param child Node to append
+ * @return Appended node, the new last child
+ */
+astref ast_append(ast* t, astref parent, astref last, astref child);
+
+/**
+ * @brief Returns the child of a node by index, ASTREF_NONE is returned
+ *      if the node has too few children.
+ * 
+ * @param t Reference to syntax tree
+ * @param node Parent node
+ * @param index Index of child
+ * @return AST node
+ */
+astref ast_child(ast* t, astref node, size_t index);
+
+/**
+ * @brief Returns the number of children of a node.
+ * 
+ * @param t Reference to syntax tree
+ * @param node Parent node
+ * @return Number of children
+ */
+size_t ast_count(ast* t, astref node);
+
+/**
+ * @brief Returns the literal text of a node or NULL if the node
+ *      has none.
+ * 
+ * @param t Reference to syntax tree
+ * @param node AST node
+ * @return String
+ */
+const char* ast_value(ast* t, astref node);
+
+/**
+ * @brief Rebuilds the full lexer position of a node from its compact
+ *      source span.
+ * 
+ * @param t Reference to syntax tree
+ * @param node AST node
+ * @return Lexer position
+ */
+lxpos ast_pos(ast* t, astref node);
+
+/**
+ * @brief Frees the node arrays of a syntax tree. The literal buffer is
+ *      kept alive as compiled programs reference its strings.
+ * 
+ * @param t Reference to syntax tree
+ */
+void ast_delete(ast* t);
 
 #endif
\ No newline at end of file
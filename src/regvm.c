@@ -0,0 +1,663 @@
+#include "regvm.h"
+#include "ops.h"
+#include "jit.h"
+
+boolean reg_enabled = false;
+
+// ------------------ TRANSLATION ------------------
+
+typedef struct reg_writer {
+    program* p;
+    reg_code* rc;
+    size_t capacity;
+    uint16_t base;   // register of the bottom of the operand stack
+    uint16_t* stack; // operand standing for each stack slot, pending until moved into the register of the slot
+    uint32_t depth;
+    size_t result;   // instruction which just wrote its result to the top of the stack, -1 if none
+} reg_writer;
+
+static const reg_op reg_binary_ops[] = {
+    [OP_ADD] = REG_ADD, [OP_SUB] = REG_SUB, [OP_MUL] = REG_MUL, [OP_DIV] = REG_DIV, [OP_MOD] = REG_MOD,
+    [OP_AND] = REG_AND, [OP_OR] = REG_OR, [OP_EQ] = REG_EQ, [OP_NE] = REG_NE,
+    [OP_LT] = REG_LT, [OP_LE] = REG_LE, [OP_GT] = REG_GT, [OP_GE] = REG_GE,
+    [OP_ADDI] = REG_ADDI, [OP_SUBI] = REG_SUBI, [OP_MULI] = REG_MULI, [OP_DIVI] = REG_DIVI, [OP_MODI] = REG_MODI,
+    [OP_EQI] = REG_EQI, [OP_NEI] = REG_NEI, [OP_LTI] = REG_LTI, [OP_LEI] = REG_LEI, [OP_GTI] = REG_GTI, [OP_GEI] = REG_GEI,
+    [OP_ADDF] = REG_ADDF, [OP_SUBF] = REG_SUBF, [OP_MULF] = REG_MULF, [OP_DIVF] = REG_DIVF,
+    [OP_LTF] = REG_LTF, [OP_LEF] = REG_LEF, [OP_GTF] = REG_GTF, [OP_GEF] = REG_GEF,
+};
+
+static const vm_op reg_generic_ops[] = {
+    [REG_ADD] = OP_ADD, [REG_SUB] = OP_SUB, [REG_MUL] = OP_MUL, [REG_DIV] = OP_DIV, [REG_MOD] = OP_MOD,
+    [REG_AND] = OP_AND, [REG_OR] = OP_OR, [REG_EQ] = OP_EQ, [REG_NE] = OP_NE,
+    [REG_LT] = OP_LT, [REG_LE] = OP_LE, [REG_GT] = OP_GT, [REG_GE] = OP_GE,
+};
+
+// operands an instruction of the stack VM pops and pushes, false if it cannot be translated
+static boolean reg_stack_effect(instruction i, uint32_t* pops, uint32_t* pushes)
+{
+    switch (i.stackop.op)
+    {
+        case OP_NOP: case OP_JMP: case OP_FORLOOP: case OP_GUARDI: case OP_GUARDF:
+            *pops = 0; *pushes = 0;
+            return true;
+
+        case OP_PUSHK: case OP_LOADG: case OP_LOADL: case OP_LOADC: case OP_TNEW:
+            *pops = 0; *pushes = 1;
+            return true;
+
+        // the copy is pushed over the value it reads
+        case OP_DUP:
+            *pops = 1; *pushes = 2;
+            return true;
+
+        case OP_STORG: case OP_STORL: case OP_STORC:
+        case OP_POP: case OP_RET: case OP_JIF:
+            *pops = 1; *pushes = 0;
+            return true;
+
+        case OP_NEG: case OP_NOT:
+            *pops = 1; *pushes = 1;
+            return true;
+
+        case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV: case OP_MOD:
+        case OP_AND: case OP_OR: case OP_EQ: case OP_NE:
+        case OP_LT: case OP_LE: case OP_GT: case OP_GE:
+        case OP_ADDI: case OP_SUBI: case OP_MULI: case OP_DIVI: case OP_MODI:
+        case OP_EQI: case OP_NEI: case OP_LTI: case OP_LEI: case OP_GTI: case OP_GEI:
+        case OP_ADDF: case OP_SUBF: case OP_MULF: case OP_DIVF:
+        case OP_LTF: case OP_LEF: case OP_GTF: case OP_GEF:
+        case OP_TGET:
+            *pops = 2; *pushes = 1;
+            return true;
+
+        case OP_FORPREP:
+            *pops = 2; *pushes = 0;
+            return true;
+
+        case OP_TPUT:
+            *pops = 3; *pushes = 1;
+            return true;
+
+        // the frame is only replaced by calls to bytecode, the result of other calls is returned after them
+        case OP_CALL: case OP_CLOSE: case OP_TAILCALL:
+            *pops = i.ux.ux + 1; *pushes = 1;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+// instructions control may continue at after instruction k, returns their count
+static size_t reg_successors(program* p, size_t k, size_t next[2])
+{
+    instruction i = p->code[k];
+
+    switch (i.stackop.op)
+    {
+        case OP_JMP:
+            next[0] = k + i.sx.sx + 1;
+            return 1;
+
+        case OP_JIF: case OP_GUARDI: case OP_GUARDF: case OP_FORPREP:
+            next[0] = k + 1;
+            next[1] = k + 2;
+            return 2;
+
+        // the jump following a loop step holds the offset of the body and is never run
+        case OP_FORLOOP:
+            next[0] = k + 2;
+            next[1] = k + 1 < p->length ? k + p->code[k + 1].sx.sx + 2 : (size_t) -1;
+            return 2;
+
+        case OP_RET:
+            return 0;
+
+        default:
+            next[0] = k + 1;
+            return 1;
+    }
+}
+
+// stack depth before each reachable instruction, -1 for unreachable ones, and the instructions jumped to
+static boolean reg_depths(program* p, int32_t* depths, boolean* labels, uint32_t* deepest)
+{
+    size_t* work = malloc(sizeof(size_t) * (p->length + 1));
+    size_t size = 0;
+
+    for (size_t k = 0; k <= p->length; k++) {
+        depths[k] = -1;
+    }
+
+    depths[0] = 0;
+    work[size++] = 0;
+    *deepest = 0;
+
+    while (size > 0)
+    {
+        size_t k = work[--size];
+        uint32_t pops, pushes;
+
+        if (k == p->length) {
+            continue;
+        } else if (!reg_stack_effect(p->code[k], &pops, &pushes) || pops > (uint32_t) depths[k]) {
+            free(work);
+            return false;
+        }
+
+        int32_t depth = depths[k] - pops + pushes;
+        size_t next[2];
+        size_t count = reg_successors(p, k, next);
+
+        if ((uint32_t) depths[k] + pushes > *deepest) {
+            *deepest = depths[k] + pushes;
+        }
+
+        for (size_t s = 0; s < count; s++)
+        {
+            if (next[s] > p->length) {
+                free(work);
+                return false;
+            }
+
+            if (next[s] != k + 1) {
+                labels[next[s]] = true;
+            }
+
+            if (depths[next[s]] == -1) {
+                depths[next[s]] = depth;
+                work[size++] = next[s];
+            } else if (depths[next[s]] != depth) {
+                free(work);
+                return false;
+            }
+        }
+    }
+
+    free(work);
+    return true;
+}
+
+boolean reg_stack_valid(program* p)
+{
+    int32_t* depths = malloc(sizeof(int32_t) * (p->length + 1));
+    boolean* labels = calloc(p->length + 1, sizeof(boolean));
+    uint32_t deepest;
+    boolean ok = reg_depths(p, depths, labels, &deepest);
+
+    free(depths);
+    free(labels);
+    return ok;
+}
+
+static size_t reg_emit(reg_writer* w, reg_op op, uint16_t a, uint16_t b, uint16_t c, size_t origin)
+{
+    reg_code* rc = w->rc;
+
+    if (rc->length >= w->capacity) {
+        w->capacity = w->capacity ? w->capacity * 2 : 64;
+        rc->code = realloc(rc->code, sizeof(reg_instruction) * w->capacity);
+        rc->origins = realloc(rc->origins, sizeof(uint32_t) * w->capacity);
+    }
+
+    rc->code[rc->length] = (reg_instruction) { op, a, b, c };
+    rc->origins[rc->length] = origin;
+    w->result = -1;
+    return rc->length++;
+}
+
+static void reg_push(reg_writer* w, uint16_t operand)
+{
+    w->stack[w->depth++] = operand;
+}
+
+static uint16_t reg_pop(reg_writer* w)
+{
+    return w->stack[--w->depth];
+}
+
+// instruction writing its result to the register of the slot pushed
+static void reg_result(reg_writer* w, reg_op op, uint16_t b, uint16_t c, size_t origin)
+{
+    uint16_t r = w->base + w->depth;
+    size_t at = reg_emit(w, op, r, b, c, origin);
+
+    reg_push(w, r);
+    w->result = at;
+}
+
+// moves pending operands into the registers of their slots, jumps and stack instructions expect them there
+static void reg_flush(reg_writer* w, size_t origin)
+{
+    for (uint32_t d = 0; d < w->depth; d++)
+    {
+        uint16_t r = w->base + d;
+
+        if (w->stack[d] != r) {
+            reg_emit(w, REG_MOVE, r, w->stack[d], 0, origin);
+            w->stack[d] = r;
+        }
+    }
+}
+
+// a local is stored to, operands still reading its old value are moved out first
+static void reg_store(reg_writer* w, uint16_t local, size_t origin)
+{
+    uint16_t value = reg_pop(w);
+    boolean pending = false;
+
+    for (uint32_t d = 0; d < w->depth; d++) {
+        pending |= w->stack[d] == local;
+    }
+
+    if (!pending && w->result != (size_t) -1 && w->rc->code[w->result].a == value && value == w->base + w->depth) {
+        w->rc->code[w->result].a = local;
+        w->result = -1;
+        return;
+    }
+
+    for (uint32_t d = 0; d < w->depth; d++)
+    {
+        if (w->stack[d] == local) {
+            reg_emit(w, REG_MOVE, w->base + d, local, 0, origin);
+            w->stack[d] = w->base + d;
+        }
+    }
+
+    if (value != local) {
+        reg_emit(w, REG_MOVE, local, value, 0, origin);
+    }
+}
+
+// a conditional jump at k is followed by the jump it skips, which is folded into it when nothing else jumps there
+static size_t reg_branch(reg_writer* w, reg_op op, uint16_t b, uint16_t c, size_t k, size_t* index, boolean* labels)
+{
+    program* p = w->p;
+
+    if (k + 1 < p->length && p->code[k + 1].stackop.op == OP_JMP && !labels[k + 1]) {
+        reg_emit(w, op, k + p->code[k + 1].sx.sx + 2, b, c, k);
+        index[k + 1] = w->rc->length;
+        return k + 1;
+    }
+
+    reg_emit(w, op, k + 1, b, c, k);
+    reg_emit(w, REG_JMP, k + 2, 0, 0, k);
+    return k;
+}
+
+reg_code* reg_compile(program* p)
+{
+    reg_code* rc = calloc(1, sizeof(reg_code));
+    size_t n = p->length;
+
+    int32_t* depths = malloc(sizeof(int32_t) * (n + 1));
+    boolean* labels = calloc(n + 1, sizeof(boolean));
+    size_t* index = malloc(sizeof(size_t) * (n + 1));
+    uint32_t deepest;
+
+    reg_writer w = {
+        .p = p,
+        .rc = rc,
+        .base = p->prev == NULL ? 0 : p->symbol_table.size,
+        .result = -1,
+    };
+
+    // operands, registers and jump targets are 16 bits wide
+    boolean ok = n < UINT16_MAX && reg_depths(p, depths, labels, &deepest) && w.base + deepest < REG_CONSTANT;
+    boolean live = true;
+
+    w.stack = malloc(sizeof(uint16_t) * (ok ? deepest + 1 : 1));
+
+    for (size_t k = 0; ok && k < n; k++)
+    {
+        instruction i = p->code[k];
+        uint32_t pops, pushes, top;
+
+        // control arrives with every operand in its register
+        if (labels[k] || !live) {
+            if (live) reg_flush(&w, k);
+
+            w.depth = depths[k] < 0 ? 0 : depths[k];
+            w.result = -1;
+
+            for (uint32_t d = 0; d < w.depth; d++) {
+                w.stack[d] = w.base + d;
+            }
+        }
+
+        index[k] = rc->length;
+        live = depths[k] >= 0;
+
+        if (!live) {
+            continue;
+        }
+
+        switch (i.stackop.op)
+        {
+            case OP_NOP: break;
+
+            case OP_PUSHK:
+                ok = i.ux.ux < REG_CONSTANT;
+                reg_push(&w, i.ux.ux | REG_CONSTANT);
+                break;
+
+            case OP_LOADL:
+                ok = i.sx.sx >= 0 && i.sx.sx < w.base;
+                reg_push(&w, i.sx.sx);
+                break;
+
+            case OP_STORL:
+                ok = i.sx.sx >= 0 && i.sx.sx < w.base;
+                if (ok) reg_store(&w, i.sx.sx, k);
+                break;
+
+            case OP_LOADG:
+                ok = i.sx.sx >= 0 && i.sx.sx < MAX_HEAP_SIZE;
+                reg_result(&w, REG_GETG, i.sx.sx, 0, k);
+                break;
+
+            case OP_STORG:
+                ok = i.sx.sx >= 0 && i.sx.sx < MAX_HEAP_SIZE;
+                reg_emit(&w, REG_SETG, i.sx.sx, reg_pop(&w), 0, k);
+                break;
+
+            case OP_LOADC: reg_result(&w, REG_GETC, i.ux.ux, 0, k); break;
+            case OP_STORC: reg_emit(&w, REG_SETC, i.ux.ux, reg_pop(&w), 0, k); break;
+
+            case OP_DUP: reg_push(&w, w.stack[w.depth - 1]); break;
+            case OP_POP: reg_pop(&w); break;
+
+            case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV: case OP_MOD:
+            case OP_AND: case OP_OR: case OP_EQ: case OP_NE:
+            case OP_LT: case OP_LE: case OP_GT: case OP_GE:
+            case OP_ADDI: case OP_SUBI: case OP_MULI: case OP_DIVI: case OP_MODI:
+            case OP_EQI: case OP_NEI: case OP_LTI: case OP_LEI: case OP_GTI: case OP_GEI:
+            case OP_ADDF: case OP_SUBF: case OP_MULF: case OP_DIVF:
+            case OP_LTF: case OP_LEF: case OP_GTF: case OP_GEF:
+            {
+                uint16_t v1 = reg_pop(&w);
+                uint16_t v0 = reg_pop(&w);
+                reg_result(&w, reg_binary_ops[i.stackop.op], v0, v1, k);
+                break;
+            }
+
+            case OP_NEG: reg_result(&w, REG_NEG, reg_pop(&w), 0, k); break;
+            case OP_NOT: reg_result(&w, REG_NOT, reg_pop(&w), 0, k); break;
+
+            case OP_JMP:
+                reg_flush(&w, k);
+                reg_emit(&w, REG_JMP, k + i.sx.sx + 1, 0, 0, k);
+                live = false;
+                break;
+
+            case OP_JIF:
+            {
+                uint16_t v0 = reg_pop(&w);
+                reg_flush(&w, k);
+                k = reg_branch(&w, REG_TEST, v0, 0, k, index, labels);
+                break;
+            }
+
+            case OP_GUARDI:
+            case OP_GUARDF:
+                ok = i.sx.sx >= 0 && i.sx.sx < w.base;
+                reg_flush(&w, k);
+                k = reg_branch(&w, i.stackop.op == OP_GUARDI ? REG_GUARDI : REG_GUARDF, i.sx.sx, 0, k, index, labels);
+                break;
+
+            case OP_FORPREP:
+                reg_flush(&w, k);
+                top = w.base + w.depth;
+                w.depth -= 2;
+                k = reg_branch(&w, REG_FORPREP, 0, top, k, index, labels);
+                break;
+
+            // the body is jumped back to by the step itself, its jump is left out
+            case OP_FORLOOP:
+                ok = k + 1 < n && p->code[k + 1].stackop.op == OP_JMP && !labels[k + 1];
+                reg_flush(&w, k);
+                if (ok) reg_emit(&w, REG_FORLOOP, k + p->code[k + 1].sx.sx + 2, 0, 0, k);
+                index[++k] = rc->length;
+                break;
+
+            case OP_RET:
+                reg_emit(&w, REG_RET, 0, reg_pop(&w), 0, k);
+                live = false;
+                break;
+
+            case OP_CALL: case OP_CLOSE: case OP_TNEW: case OP_TPUT: case OP_TGET: case OP_TAILCALL:
+                ok = i.ux.ux <= UINT16_MAX;
+                reg_flush(&w, k);
+                reg_stack_effect(i, &pops, &pushes);
+                top = w.base + w.depth;
+
+                if (i.stackop.op == OP_TAILCALL) {
+                    reg_emit(&w, REG_TAILCALL, top, i.ux.ux, 0, k);
+                } else {
+                    reg_emit(&w, REG_STEP, top, i.stackop.op, i.ux.ux, k);
+                }
+
+                w.depth -= pops;
+
+                while (pushes-- > 0) {
+                    reg_push(&w, w.base + w.depth);
+                }
+                break;
+
+            default:
+                ok = false;
+                break;
+        }
+    }
+
+    if (ok) {
+        index[n] = rc->length;
+        reg_emit(&w, REG_END, 0, 0, 0, n);
+        ok = rc->length < UINT16_MAX;
+    }
+
+    // jumps were emitted with the stack instructions they target
+    for (size_t j = 0; ok && j < rc->length; j++)
+    {
+        reg_instruction* ri = &rc->code[j];
+
+        if (ri->op == REG_JMP || ri->op == REG_TEST || ri->op == REG_GUARDI || ri->op == REG_GUARDF
+                || ri->op == REG_FORPREP || ri->op == REG_FORLOOP) {
+            ri->a = index[ri->a];
+        }
+    }
+
+    rc->registers = ok ? w.base + deepest : 0;
+
+    if (!ok) {
+        rc->length = 0;
+    }
+
+    free(w.stack);
+    free(depths);
+    free(labels);
+    free(index);
+
+#ifdef HE_DEBUG_MODE
+    Value v = vCode(p, NULL);
+    printf("%s Translated %s into %zu register instructions\n", MESSAGE, value_to_str(&v), rc->length);
+#endif
+
+    return rc;
+}
+
+// ------------------- EXECUTION -------------------
+
+#define RK(x) ((x) & REG_CONSTANT ? &constants[(x) & ~REG_CONSTANT] : &regs[x])
+
+// typed operands were proven by the optimizer, the tag of the left one is kept as in the stack VM
+#define REG_TYPED_OP(name, field, operator) \
+    case name: \
+    { \
+        Value v0 = *RK(i.b); \
+        v0.value.field = v0.value.field operator RK(i.c)->value.field; \
+        regs[i.a] = v0; \
+        break; \
+    }
+
+#define REG_TYPED_COMPARE(name, field, operator) \
+    case name: regs[i.a] = vBool(RK(i.b)->value.field operator RK(i.c)->value.field); break;
+
+// runs a frame until it returns or tail calls into another program
+static int reg_run(virtual_machine* vm, call_info* call, reg_code* rc)
+{
+    const reg_instruction* code = rc->code;
+    Value* regs = &vm->stack[call->bp];
+    Value* constants = call->program->p->constants;
+    size_t pc = 0;
+    size_t dispatched = 0;
+
+    while (true)
+    {
+        reg_instruction i = code[pc++];
+        dispatched++;
+
+        switch (i.op)
+        {
+            case REG_MOVE: regs[i.a] = *RK(i.b); break;
+            case REG_GETG: regs[i.a] = vm->heap[i.b]; break;
+            case REG_SETG: vm->heap[i.a] = *RK(i.b); break;
+            case REG_GETC: regs[i.a] = call->program->closure[i.b]; break;
+            case REG_SETC: call->program->closure[i.a] = *RK(i.b); break;
+
+            case REG_ADD: case REG_SUB: case REG_MUL: case REG_DIV: case REG_MOD:
+            case REG_AND: case REG_OR: case REG_EQ: case REG_NE:
+            case REG_LT: case REG_LE: case REG_GT: case REG_GE:
+                call->pc = rc->origins[pc - 1];
+                regs[i.a] = apply_vm_op(reg_generic_ops[i.op], *RK(i.b), *RK(i.c));
+                break;
+
+            REG_TYPED_OP(REG_ADDI, to_int, +)
+            REG_TYPED_OP(REG_SUBI, to_int, -)
+            REG_TYPED_OP(REG_MULI, to_int, *)
+            REG_TYPED_OP(REG_ADDF, to_float, +)
+            REG_TYPED_OP(REG_SUBF, to_float, -)
+            REG_TYPED_OP(REG_MULF, to_float, *)
+
+            REG_TYPED_COMPARE(REG_EQI, to_int, ==)
+            REG_TYPED_COMPARE(REG_NEI, to_int, !=)
+            REG_TYPED_COMPARE(REG_LTI, to_int, <)
+            REG_TYPED_COMPARE(REG_LEI, to_int, <=)
+            REG_TYPED_COMPARE(REG_GTI, to_int, >)
+            REG_TYPED_COMPARE(REG_GEI, to_int, >=)
+            REG_TYPED_COMPARE(REG_LTF, to_float, <)
+            REG_TYPED_COMPARE(REG_LEF, to_float, <=)
+            REG_TYPED_COMPARE(REG_GTF, to_float, >)
+            REG_TYPED_COMPARE(REG_GEF, to_float, >=)
+
+            case REG_DIVI:
+            case REG_MODI:
+            case REG_DIVF:
+            {
+                Value v0 = *RK(i.b);
+                Value v1 = *RK(i.c);
+                call->pc = rc->origins[pc - 1];
+
+                if (i.op == REG_DIVI) {
+                    if (v1.value.to_int == 0 || v1.value.to_float == 0.0) runtimeerr(vm, "Zero division error!");
+                    v0.value.to_int /= v1.value.to_int;
+                } else if (i.op == REG_MODI) {
+                    if (v1.value.to_int == 0) runtimeerr(vm, "Zero modulus error!");
+                    v0.value.to_int %= v1.value.to_int;
+                } else {
+                    if (v1.value.to_float == 0.0) runtimeerr(vm, "Zero division error!");
+                    v0.value.to_float /= v1.value.to_float;
+                }
+
+                regs[i.a] = v0;
+                break;
+            }
+
+            case REG_NEG:
+                call->pc = rc->origins[pc - 1];
+                regs[i.a] = vNegate(*RK(i.b));
+                break;
+
+            case REG_NOT: regs[i.a] = vBool(!native_bool_cast(RK(i.b)).value.to_bool); break;
+
+            case REG_JMP: pc = i.a; break;
+
+            case REG_TEST:
+                if (!native_bool_cast(RK(i.b)).value.to_bool) pc = i.a;
+                break;
+
+            case REG_GUARDI:
+                if (regs[i.b].type != VM_INT) pc = i.a;
+                break;
+
+            case REG_GUARDF:
+                if (regs[i.b].type != VM_FLOAT) pc = i.a;
+                break;
+
+            case REG_FORPREP:
+                call->tp = call->bp + i.c;
+                call->pc = rc->origins[pc - 1];
+                if (!op_forprep(vm, call, call->program->p->code[call->pc].ux.ux)) pc = i.a;
+                break;
+
+            case REG_FORLOOP:
+                call->pc = rc->origins[pc - 1];
+                if (op_forloop(vm, call, call->program->p->code[call->pc].ux.ux)) pc = i.a;
+                break;
+
+            case REG_STEP:
+                call->tp = call->bp + i.a;
+                call->pc = rc->origins[pc - 1];
+                decode_execute(vm, call, (instruction) { .ux = { i.b, i.c } });
+                break;
+
+            case REG_TAILCALL:
+                call->tp = call->bp + i.a;
+                call->pc = rc->origins[pc - 1];
+                if (op_tailcall(vm, call, i.b)) {
+                    vm_dispatched += dispatched;
+                    return JIT_TAILCALL;
+                }
+                break;
+
+            case REG_RET:
+                vm->stack[call->prev->tp++] = *RK(i.b);
+                vm_dispatched += dispatched;
+                return JIT_RETURN;
+
+            case REG_END:
+                vm_dispatched += dispatched;
+                return JIT_RETURN;
+        }
+    }
+}
+
+boolean reg_execute(virtual_machine* vm, call_info* call)
+{
+    while (reg_enabled)
+    {
+        program* p = call->program->p;
+
+        if (p->native != NULL) {
+            return false;
+        }
+
+        if (p->reg == NULL) {
+            p->reg = reg_compile(p);
+        }
+
+        // a frame whose registers run past the stack overflows in the stack VM, at the instruction which overflows
+        if (p->reg->length == 0 || call->bp + p->reg->registers >= MAX_STACK_SIZE) {
+            return false;
+        }
+
+        if (reg_run(vm, call, p->reg) == JIT_RETURN) {
+            return true;
+        }
+
+        // a tail call left the callee at the start of the frame
+        call->pc = 0;
+    }
+
+    return false;
+}
@@ -0,0 +1,131 @@
+#ifndef HE_REGVM_HEADER
+#define HE_REGVM_HEADER
+
+#include "common.h"
+#include "compiler.h"
+#include "vm.h"
+
+/*
+ * The register VM runs a three-address form of the bytecode. Operands
+ * name frame slots directly instead of going through the operand stack:
+ * locals keep their slots and the operand stack at depth d becomes the
+ * register just past the locals plus d, so the frame layout and calling
+ * convention are those of the stack VM and both call each other freely.
+ *
+ * Programs are translated from their optimized stack bytecode the first
+ * time they run. Loads of locals and constants are folded into the
+ * operands of the instructions using them and results are written
+ * straight into the local they are stored to. Calls, closures and tables
+ * still run through the stack handlers with the top of the operand stack
+ * set from the instruction. Programs which cannot be translated are run
+ * by the stack VM.
+ *
+ * Instructions are 64 bits wide: an opcode and three 16-bit operands.
+ * Operands read as RK are registers, or constants when REG_CONSTANT is
+ * set. Jump targets are absolute.
+ */
+
+#define REG_CONSTANT 0x8000
+
+typedef enum reg_op {
+    REG_MOVE,      // R[a] = RK[b]
+    REG_GETG,      // R[a] = heap[b]
+    REG_SETG,      // heap[a] = RK[b]
+    REG_GETC,      // R[a] = closure[b]
+    REG_SETC,      // closure[a] = RK[b]
+    REG_ADD,       // R[a] = RK[b] op RK[c] on generic values
+    REG_SUB,
+    REG_MUL,
+    REG_DIV,
+    REG_MOD,
+    REG_AND,
+    REG_OR,
+    REG_EQ,
+    REG_NE,
+    REG_LT,
+    REG_LE,
+    REG_GT,
+    REG_GE,
+    REG_ADDI,      // R[a] = RK[b] op RK[c] on operands known to be ints
+    REG_SUBI,
+    REG_MULI,
+    REG_DIVI,
+    REG_MODI,
+    REG_EQI,
+    REG_NEI,
+    REG_LTI,
+    REG_LEI,
+    REG_GTI,
+    REG_GEI,
+    REG_ADDF,      // R[a] = RK[b] op RK[c] on operands known to be floats
+    REG_SUBF,
+    REG_MULF,
+    REG_DIVF,
+    REG_LTF,
+    REG_LEF,
+    REG_GTF,
+    REG_GEF,
+    REG_NEG,       // R[a] = op RK[b]
+    REG_NOT,
+    REG_JMP,       // pc = a
+    REG_TEST,      // pc = a unless RK[b] is truthy
+    REG_GUARDI,    // pc = a unless R[b] is an int
+    REG_GUARDF,    // pc = a unless R[b] is a float
+    REG_FORPREP,   // counted loop of its origin with its range on top of the stack at c, pc = a if it is empty
+    REG_FORLOOP,   // steps counted loop of its origin, pc = a while it is in range
+    REG_STEP,      // stack instruction (b, c) with the top of the stack at register a
+    REG_TAILCALL,  // tail call of argc b with the top of the stack at register a
+    REG_RET,       // returns RK[b]
+    REG_END,       // end of the program
+} reg_op;
+
+typedef struct reg_instruction {
+    uint16_t op;
+    uint16_t a;
+    uint16_t b;
+    uint16_t c;
+} reg_instruction;
+
+typedef struct reg_code {
+    reg_instruction* code;
+    uint32_t* origins;  // stack instruction each instruction was translated from, for stack traces
+    size_t length;      // 0 if the program cannot be translated
+    size_t registers;   // highest register used plus one
+} reg_code;
+
+extern boolean reg_enabled;
+
+/**
+ * @brief Translates the stack bytecode of a program into register
+ *      instructions.
+ *
+ * @param p Reference to program
+ * @return Register code, with a length of 0 if the program uses
+ *      bytecode the register VM cannot express
+ */
+reg_code* reg_compile(program* p);
+
+/**
+ * @brief Checks that the stack bytecode of a program keeps its operand
+ *      stack consistent: no reachable instruction pops more values than
+ *      the stack holds, control never leaves the code, and paths joining
+ *      at an instruction agree on the depth of the stack.
+ *
+ * @param p Reference to program
+ * @return True if every path through the program is balanced
+ */
+boolean reg_stack_valid(program* p);
+
+/**
+ * @brief Runs a frame which has not started yet on the register VM,
+ *      translating its program on first use. Tail calls continue with
+ *      the callee in the same frame.
+ *
+ * @param vm Reference to virtual machine
+ * @param call Frame to run
+ * @return Whether the frame finished, false if the stack VM must run
+ *      it from its pc
+ */
+boolean reg_execute(virtual_machine* vm, call_info* call);
+
+#endif
@@ -0,0 +1,167 @@
+#include <sys/mman.h>
+#include "stencil.h"
+
+#if defined(__x86_64__)
+
+#include "stencils.h"
+
+// stencil running instruction k, instructions without their own are stepped
+static const stencil* stencil_of(program* p, size_t k)
+{
+    const stencil* s = &stencils[p->code[k].stackop.op];
+    return s->code != NULL ? s : &stencils[STENCIL_STEP];
+}
+
+// instruction run after instruction k unless it branches
+static size_t stencil_continuation(program* p, size_t k)
+{
+    instruction i = p->code[k];
+
+    if (i.stackop.op == OP_JMP) {
+        return k + i.sx.sx + 1;
+    } else if (i.stackop.op == OP_FORLOOP) {
+        return k + 2;
+    }
+
+    return k + 1;
+}
+
+// instruction a taken branch at k continues at
+static size_t stencil_target(program* p, size_t k)
+{
+    instruction i = p->code[k];
+
+    if (i.stackop.op == OP_FORLOOP) {
+        return k + p->code[k + 1].sx.sx + 2;
+    }
+
+    return k + 2;
+}
+
+// bytes of a stencil copied, the jump to a continuation placed right behind it is dropped
+static size_t stencil_size(const stencil* s, boolean falls_through)
+{
+    return s->size - (falls_through ? s->tail : 0);
+}
+
+static void stencil_patch(uint8_t* code, const stencil* s, size_t size, uint64_t values[])
+{
+    memcpy(code, s->code, size);
+
+    for (size_t h = 0; h < s->nholes; h++)
+    {
+        const stencil_hole* hole = &s->holes[h];
+        uint64_t value = hole->kind == HOLE_SYMBOL ? (uintptr_t) stencil_symbols[hole->symbol] : values[hole->kind];
+
+        value += hole->addend;
+
+        if (hole->offset + sizeof(value) <= size) {
+            memcpy(&code[hole->offset], &value, sizeof(value));
+        }
+    }
+}
+
+jit_function stencil_compile(program* p)
+{
+    double start = tier_clock();
+
+    if (stencils[STENCIL_STEP].code == NULL || stencils[STENCIL_ENTER].code == NULL || stencils[STENCIL_END].code == NULL) {
+        tier_record(p, TIER_FAILED, 0, 0, start);
+        return NULL;
+    }
+
+    // native offset of each instruction, followed by the end of the program
+    size_t* offsets = malloc(sizeof(size_t) * (p->length + 1));
+    size_t size = 0;
+
+    // frames entered mid-loop by on-stack replacement resume at the loop header
+    for (size_t k = 0; k < p->length; k++) {
+        if (jit_loop_header(p, k) <= k) {
+            size += stencil_size(&stencils[STENCIL_ENTER], true);
+        }
+    }
+
+    for (size_t k = 0; k < p->length; k++) {
+        offsets[k] = size;
+        size += stencil_size(stencil_of(p, k), stencil_continuation(p, k) == k + 1);
+    }
+
+    offsets[p->length] = size;
+    size += stencils[STENCIL_END].size;
+
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t mapped = (size + page - 1) / page * page;
+    uint8_t* code = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (code == MAP_FAILED) {
+        free(offsets);
+        tier_record(p, TIER_FAILED, 0, 0, start);
+        return NULL;
+    }
+
+    // values of the holes by kind, symbols are looked up by index
+    uint64_t values[HOLE_SYMBOL] = {
+        [HOLE_DATA] = (uintptr_t) stencil_data,
+    };
+
+    size_t at = 0;
+
+    for (size_t k = 0; k < p->length; k++)
+    {
+        size_t header = jit_loop_header(p, k);
+
+        if (header <= k) {
+            size_t length = stencil_size(&stencils[STENCIL_ENTER], true);
+
+            values[HOLE_PC] = header;
+            values[HOLE_TARGET] = (uintptr_t) code + offsets[header];
+            values[HOLE_CONTINUE] = (uintptr_t) code + at + length;
+
+            stencil_patch(code + at, &stencils[STENCIL_ENTER], length, values);
+            at += length;
+        }
+    }
+
+    for (size_t k = 0; k < p->length; k++)
+    {
+        instruction i = p->code[k];
+        const stencil* s = stencil_of(p, k);
+        size_t next = stencil_continuation(p, k);
+        size_t target = stencil_target(p, k);
+
+        values[HOLE_PC] = k;
+        values[HOLE_OPERAND] = s == &stencils[STENCIL_STEP] ? i.bits : i.ux.ux;
+        values[HOLE_CONSTANT] = i.stackop.op == OP_PUSHK ? (uintptr_t) &p->constants[i.ux.ux] : 0;
+        values[HOLE_CONTINUE] = (uintptr_t) code + offsets[next < p->length ? next : p->length];
+        values[HOLE_TARGET] = (uintptr_t) code + offsets[target < p->length ? target : p->length];
+
+        stencil_patch(code + offsets[k], s, stencil_size(s, next == k + 1), values);
+    }
+
+    stencil_patch(code + offsets[p->length], &stencils[STENCIL_END], stencils[STENCIL_END].size, values);
+    free(offsets);
+
+    // code is never writable and executable at the same time
+    if (mprotect(code, mapped, PROT_READ | PROT_EXEC) != 0) {
+        munmap(code, mapped);
+        tier_record(p, TIER_FAILED, 0, 0, start);
+        return NULL;
+    }
+
+#ifdef HE_DEBUG_MODE
+    Value v = vCode(p, NULL);
+    printf("%s Stitched %s into %zu bytes of native code\n", MESSAGE, value_to_str(&v), size);
+#endif
+
+    tier_record(p, TIER_NATIVE, 0, size, start);
+    return (jit_function) code;
+}
+
+#else
+
+jit_function stencil_compile(program* p)
+{
+    return NULL;
+}
+
+#endif
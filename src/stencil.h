@@ -0,0 +1,63 @@
+#ifndef HE_STENCIL_HEADER
+#define HE_STENCIL_HEADER
+
+#include "common.h"
+#include "compiler.h"
+#include "vm.h"
+#include "jit.h"
+
+/*
+ * The copy-and-patch JIT builds native code out of stencils, machine
+ * code compiled ahead of time by the C compiler from the opcode handlers
+ * in ops.h (see stencils/handlers.c). Stencils are copied back to back,
+ * one per instruction, and their holes are patched with operands and the
+ * addresses of the stencils to continue at. Stencils tail call each
+ * other, the jump to a continuation placed right behind is dropped.
+ *
+ * src/stencils.h is generated from the stencil objects by
+ * "make stencils" and holds, for each stencil, its code and holes.
+ */
+
+// stencils which do not run an instruction, numbered after the opcodes
+#define STENCIL_ENTER (OP_TAILCALL + 1) // dispatch on the pc of a frame entered mid-loop
+#define STENCIL_STEP (OP_TAILCALL + 2)  // instruction run by decode_execute
+#define STENCIL_END (OP_TAILCALL + 3)   // end of the program
+#define STENCIL_COUNT (OP_TAILCALL + 4)
+
+typedef enum stencil_hole_kind {
+    HOLE_CONTINUE, // stencil run next
+    HOLE_TARGET,   // stencil run when a branch is taken
+    HOLE_OPERAND,  // operand of the instruction, the whole instruction when stepped
+    HOLE_PC,       // address of the instruction
+    HOLE_CONSTANT, // constant pushed by the instruction
+    HOLE_DATA,     // read-only data of the stencils
+    HOLE_SYMBOL,   // function or variable of the runtime
+} stencil_hole_kind;
+
+// 64-bit absolute address in the code of a stencil
+typedef struct stencil_hole {
+    uint32_t offset;
+    stencil_hole_kind kind;
+    uint32_t symbol; // index into the runtime symbols
+    int64_t addend;
+} stencil_hole;
+
+typedef struct stencil {
+    const uint8_t* code;
+    uint32_t size;
+    uint32_t tail; // bytes of the trailing jump to HOLE_CONTINUE, 0 if there is none
+    const stencil_hole* holes;
+    uint32_t nholes;
+} stencil;
+
+/**
+ * @brief Stitches the stencils of the instructions of a program into
+ *      native code placed in executable memory. Frames with a pc at a
+ *      loop header enter the code at that header.
+ *
+ * @param p Reference to program
+ * @return Native function, NULL if the program cannot be compiled
+ */
+jit_function stencil_compile(program* p);
+
+#endif
@@ -0,0 +1,1438 @@
+// Generated by "make stencils" from stencils/handlers.c, do not edit
+
+#ifndef HE_STENCILS_HEADER
+#define HE_STENCILS_HEADER
+
+static const uint8_t stencil_code_OP_ADD[] = {
+    0x41, 0x54, 0x49, 0x89, 0xfc, 0x55, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x30, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x4f, 0x18, 0x48, 0x8d, 0x14, 0xc0, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x01,
+    0xca, 0x80, 0x7a, 0xee, 0x01, 0x75, 0x0a, 0x80, 0x7a, 0xf7, 0x01, 0x0f, 0x84, 0x9f, 0x00, 0x00,
+    0x00, 0x48, 0x8d, 0x14, 0xc0, 0x48, 0x83, 0xec, 0x20, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x48, 0x8d, 0x6c, 0x11, 0xf7, 0x48, 0x8b, 0x3c, 0x11, 0x48, 0x89, 0x73, 0x20,
+    0x0f, 0xb6, 0x74, 0x11, 0x08, 0x48, 0x8b, 0x55, 0x00, 0x0f, 0xb6, 0x4d, 0x08, 0x48, 0x89, 0x7c,
+    0x24, 0x3e, 0x40, 0x88, 0x74, 0x24, 0x46, 0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x43, 0x18,
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0x7c, 0x24, 0x10, 0x48,
+    0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x01, 0x00, 0x00, 0x00, 0x48, 0x89,
+    0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0x45,
+    0x00, 0x0f, 0xb6, 0x44, 0x24, 0x28, 0x48, 0x83, 0xc4, 0x20, 0x88, 0x45, 0x08, 0x48, 0x83, 0xc4,
+    0x30, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x8b, 0x4a, 0xf8, 0x48, 0x01, 0x4a, 0xef, 0x48, 0x89, 0x46, 0x18, 0xeb, 0xcf,
+};
+
+static const stencil_hole stencil_holes_OP_ADD[] = {
+    { 59, HOLE_PC, 0, 0 },
+    { 114, HOLE_SYMBOL, 0, 0 },
+    { 185, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_ADD_TAIL 0
+#define STENCIL_OP_ADD_HOLES 3
+
+static const uint8_t stencil_code_OP_SUB[] = {
+    0x41, 0x54, 0x49, 0x89, 0xfc, 0x55, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x30, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x4f, 0x18, 0x48, 0x8d, 0x14, 0xc0, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x01,
+    0xca, 0x80, 0x7a, 0xee, 0x01, 0x75, 0x0a, 0x80, 0x7a, 0xf7, 0x01, 0x0f, 0x84, 0x9f, 0x00, 0x00,
+    0x00, 0x48, 0x8d, 0x14, 0xc0, 0x48, 0x83, 0xec, 0x20, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x48, 0x8d, 0x6c, 0x11, 0xf7, 0x48, 0x8b, 0x3c, 0x11, 0x48, 0x89, 0x73, 0x20,
+    0x0f, 0xb6, 0x74, 0x11, 0x08, 0x48, 0x8b, 0x55, 0x00, 0x0f, 0xb6, 0x4d, 0x08, 0x48, 0x89, 0x7c,
+    0x24, 0x3e, 0x40, 0x88, 0x74, 0x24, 0x46, 0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x43, 0x18,
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0x7c, 0x24, 0x10, 0x48,
+    0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x02, 0x00, 0x00, 0x00, 0x48, 0x89,
+    0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0x45,
+    0x00, 0x0f, 0xb6, 0x44, 0x24, 0x28, 0x48, 0x83, 0xc4, 0x20, 0x88, 0x45, 0x08, 0x48, 0x83, 0xc4,
+    0x30, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x8b, 0x4a, 0xf8, 0x48, 0x29, 0x4a, 0xef, 0x48, 0x89, 0x46, 0x18, 0xeb, 0xcf,
+};
+
+static const stencil_hole stencil_holes_OP_SUB[] = {
+    { 59, HOLE_PC, 0, 0 },
+    { 114, HOLE_SYMBOL, 0, 0 },
+    { 185, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_SUB_TAIL 0
+#define STENCIL_OP_SUB_HOLES 3
+
+static const uint8_t stencil_code_OP_MUL[] = {
+    0x41, 0x54, 0x49, 0x89, 0xfc, 0x55, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x30, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x4f, 0x18, 0x48, 0x8d, 0x14, 0xc0, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x01,
+    0xca, 0x80, 0x7a, 0xee, 0x01, 0x75, 0x0a, 0x80, 0x7a, 0xf7, 0x01, 0x0f, 0x84, 0x9f, 0x00, 0x00,
+    0x00, 0x48, 0x8d, 0x14, 0xc0, 0x48, 0x83, 0xec, 0x20, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x48, 0x8d, 0x6c, 0x11, 0xf7, 0x48, 0x8b, 0x3c, 0x11, 0x48, 0x89, 0x73, 0x20,
+    0x0f, 0xb6, 0x74, 0x11, 0x08, 0x48, 0x8b, 0x55, 0x00, 0x0f, 0xb6, 0x4d, 0x08, 0x48, 0x89, 0x7c,
+    0x24, 0x3e, 0x40, 0x88, 0x74, 0x24, 0x46, 0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x43, 0x18,
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0x7c, 0x24, 0x10, 0x48,
+    0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x03, 0x00, 0x00, 0x00, 0x48, 0x89,
+    0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0x45,
+    0x00, 0x0f, 0xb6, 0x44, 0x24, 0x28, 0x48, 0x83, 0xc4, 0x20, 0x88, 0x45, 0x08, 0x48, 0x83, 0xc4,
+    0x30, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x8b, 0x4a, 0xef, 0x48, 0x0f, 0xaf, 0x4a, 0xf8, 0x48, 0x89, 0x4a, 0xef, 0x48, 0x89, 0x46,
+    0x18, 0xeb, 0xca,
+};
+
+static const stencil_hole stencil_holes_OP_MUL[] = {
+    { 59, HOLE_PC, 0, 0 },
+    { 114, HOLE_SYMBOL, 0, 0 },
+    { 185, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_MUL_TAIL 0
+#define STENCIL_OP_MUL_HOLES 3
+
+static const uint8_t stencil_code_OP_EQ[] = {
+    0x41, 0x54, 0x49, 0x89, 0xfc, 0x55, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x30, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x8d, 0x2c, 0xc0, 0x48, 0x01, 0xd5, 0x80, 0x7d, 0xee,
+    0x01, 0x75, 0x0a, 0x80, 0x7d, 0xf7, 0x01, 0x0f, 0x84, 0xa3, 0x00, 0x00, 0x00, 0x48, 0x83, 0xe8,
+    0x01, 0x48, 0x83, 0xec, 0x20, 0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0x89, 0x4b, 0x20, 0x48, 0x8d, 0x0c, 0xc0, 0x48, 0x8d, 0x6c, 0x0a, 0xf7, 0x48, 0x8b, 0x3c, 0x0a,
+    0x0f, 0xb6, 0x74, 0x0a, 0x08, 0x48, 0x8b, 0x55, 0x00, 0x0f, 0xb6, 0x4d, 0x08, 0x48, 0x89, 0x43,
+    0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x88, 0x74, 0x24, 0x46,
+    0x48, 0x89, 0x7c, 0x24, 0x3e, 0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x7c, 0x24, 0x10, 0x48,
+    0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x0a, 0x00, 0x00, 0x00, 0x48, 0x89,
+    0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0x45,
+    0x00, 0x0f, 0xb6, 0x44, 0x24, 0x28, 0x48, 0x83, 0xc4, 0x20, 0x88, 0x45, 0x08, 0x48, 0x83, 0xc4,
+    0x30, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x8b, 0x45, 0xf8, 0x31, 0xf6, 0x48, 0x39, 0x45, 0xef, 0x48, 0x89, 0xe7, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x0f, 0x94, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04,
+    0x24, 0x48, 0x89, 0x45, 0xee, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x88, 0x45, 0xf6, 0x48, 0x83, 0x6b,
+    0x18, 0x01, 0xeb, 0xa9,
+};
+
+static const stencil_hole stencil_holes_OP_EQ[] = {
+    { 55, HOLE_PC, 0, 0 },
+    { 99, HOLE_SYMBOL, 0, 0 },
+    { 185, HOLE_CONTINUE, 0, 0 },
+    { 223, HOLE_SYMBOL, 1, 0 },
+};
+
+#define STENCIL_OP_EQ_TAIL 0
+#define STENCIL_OP_EQ_HOLES 4
+
+static const uint8_t stencil_code_OP_NE[] = {
+    0x41, 0x54, 0x49, 0x89, 0xfc, 0x55, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x30, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x8d, 0x2c, 0xc0, 0x48, 0x01, 0xd5, 0x80, 0x7d, 0xee,
+    0x01, 0x75, 0x0a, 0x80, 0x7d, 0xf7, 0x01, 0x0f, 0x84, 0xa3, 0x00, 0x00, 0x00, 0x48, 0x83, 0xe8,
+    0x01, 0x48, 0x83, 0xec, 0x20, 0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0x89, 0x4b, 0x20, 0x48, 0x8d, 0x0c, 0xc0, 0x48, 0x8d, 0x6c, 0x0a, 0xf7, 0x48, 0x8b, 0x3c, 0x0a,
+    0x0f, 0xb6, 0x74, 0x0a, 0x08, 0x48, 0x8b, 0x55, 0x00, 0x0f, 0xb6, 0x4d, 0x08, 0x48, 0x89, 0x43,
+    0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x88, 0x74, 0x24, 0x46,
+    0x48, 0x89, 0x7c, 0x24, 0x3e, 0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x7c, 0x24, 0x10, 0x48,
+    0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x0b, 0x00, 0x00, 0x00, 0x48, 0x89,
+    0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0x45,
+    0x00, 0x0f, 0xb6, 0x44, 0x24, 0x28, 0x48, 0x83, 0xc4, 0x20, 0x88, 0x45, 0x08, 0x48, 0x83, 0xc4,
+    0x30, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x8b, 0x45, 0xf8, 0x31, 0xf6, 0x48, 0x39, 0x45, 0xef, 0x48, 0x89, 0xe7, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x0f, 0x95, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04,
+    0x24, 0x48, 0x89, 0x45, 0xee, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x88, 0x45, 0xf6, 0x48, 0x83, 0x6b,
+    0x18, 0x01, 0xeb, 0xa9,
+};
+
+static const stencil_hole stencil_holes_OP_NE[] = {
+    { 55, HOLE_PC, 0, 0 },
+    { 99, HOLE_SYMBOL, 0, 0 },
+    { 185, HOLE_CONTINUE, 0, 0 },
+    { 223, HOLE_SYMBOL, 1, 0 },
+};
+
+#define STENCIL_OP_NE_TAIL 0
+#define STENCIL_OP_NE_HOLES 4
+
+static const uint8_t stencil_code_OP_LT[] = {
+    0x41, 0x54, 0x49, 0x89, 0xfc, 0x55, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x30, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x8d, 0x2c, 0xc0, 0x48, 0x01, 0xd5, 0x80, 0x7d, 0xee,
+    0x01, 0x75, 0x0a, 0x80, 0x7d, 0xf7, 0x01, 0x0f, 0x84, 0xa3, 0x00, 0x00, 0x00, 0x48, 0x83, 0xe8,
+    0x01, 0x48, 0x83, 0xec, 0x20, 0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0x89, 0x4b, 0x20, 0x48, 0x8d, 0x0c, 0xc0, 0x48, 0x8d, 0x6c, 0x0a, 0xf7, 0x48, 0x8b, 0x3c, 0x0a,
+    0x0f, 0xb6, 0x74, 0x0a, 0x08, 0x48, 0x8b, 0x55, 0x00, 0x0f, 0xb6, 0x4d, 0x08, 0x48, 0x89, 0x43,
+    0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x88, 0x74, 0x24, 0x46,
+    0x48, 0x89, 0x7c, 0x24, 0x3e, 0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x7c, 0x24, 0x10, 0x48,
+    0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x0c, 0x00, 0x00, 0x00, 0x48, 0x89,
+    0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0x45,
+    0x00, 0x0f, 0xb6, 0x44, 0x24, 0x28, 0x48, 0x83, 0xc4, 0x20, 0x88, 0x45, 0x08, 0x48, 0x83, 0xc4,
+    0x30, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x8b, 0x45, 0xf8, 0x31, 0xf6, 0x48, 0x39, 0x45, 0xef, 0x48, 0x89, 0xe7, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x0f, 0x9c, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04,
+    0x24, 0x48, 0x89, 0x45, 0xee, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x88, 0x45, 0xf6, 0x48, 0x83, 0x6b,
+    0x18, 0x01, 0xeb, 0xa9,
+};
+
+static const stencil_hole stencil_holes_OP_LT[] = {
+    { 55, HOLE_PC, 0, 0 },
+    { 99, HOLE_SYMBOL, 0, 0 },
+    { 185, HOLE_CONTINUE, 0, 0 },
+    { 223, HOLE_SYMBOL, 1, 0 },
+};
+
+#define STENCIL_OP_LT_TAIL 0
+#define STENCIL_OP_LT_HOLES 4
+
+static const uint8_t stencil_code_OP_LE[] = {
+    0x41, 0x54, 0x49, 0x89, 0xfc, 0x55, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x30, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x8d, 0x2c, 0xc0, 0x48, 0x01, 0xd5, 0x80, 0x7d, 0xee,
+    0x01, 0x75, 0x0a, 0x80, 0x7d, 0xf7, 0x01, 0x0f, 0x84, 0xa3, 0x00, 0x00, 0x00, 0x48, 0x83, 0xe8,
+    0x01, 0x48, 0x83, 0xec, 0x20, 0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0x89, 0x4b, 0x20, 0x48, 0x8d, 0x0c, 0xc0, 0x48, 0x8d, 0x6c, 0x0a, 0xf7, 0x48, 0x8b, 0x3c, 0x0a,
+    0x0f, 0xb6, 0x74, 0x0a, 0x08, 0x48, 0x8b, 0x55, 0x00, 0x0f, 0xb6, 0x4d, 0x08, 0x48, 0x89, 0x43,
+    0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x88, 0x74, 0x24, 0x46,
+    0x48, 0x89, 0x7c, 0x24, 0x3e, 0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x7c, 0x24, 0x10, 0x48,
+    0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x0d, 0x00, 0x00, 0x00, 0x48, 0x89,
+    0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0x45,
+    0x00, 0x0f, 0xb6, 0x44, 0x24, 0x28, 0x48, 0x83, 0xc4, 0x20, 0x88, 0x45, 0x08, 0x48, 0x83, 0xc4,
+    0x30, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x8b, 0x45, 0xf8, 0x31, 0xf6, 0x48, 0x39, 0x45, 0xef, 0x48, 0x89, 0xe7, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x0f, 0x9e, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04,
+    0x24, 0x48, 0x89, 0x45, 0xee, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x88, 0x45, 0xf6, 0x48, 0x83, 0x6b,
+    0x18, 0x01, 0xeb, 0xa9,
+};
+
+static const stencil_hole stencil_holes_OP_LE[] = {
+    { 55, HOLE_PC, 0, 0 },
+    { 99, HOLE_SYMBOL, 0, 0 },
+    { 185, HOLE_CONTINUE, 0, 0 },
+    { 223, HOLE_SYMBOL, 1, 0 },
+};
+
+#define STENCIL_OP_LE_TAIL 0
+#define STENCIL_OP_LE_HOLES 4
+
+static const uint8_t stencil_code_OP_GT[] = {
+    0x41, 0x54, 0x49, 0x89, 0xfc, 0x55, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x30, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x8d, 0x2c, 0xc0, 0x48, 0x01, 0xd5, 0x80, 0x7d, 0xee,
+    0x01, 0x75, 0x0a, 0x80, 0x7d, 0xf7, 0x01, 0x0f, 0x84, 0xa3, 0x00, 0x00, 0x00, 0x48, 0x83, 0xe8,
+    0x01, 0x48, 0x83, 0xec, 0x20, 0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0x89, 0x4b, 0x20, 0x48, 0x8d, 0x0c, 0xc0, 0x48, 0x8d, 0x6c, 0x0a, 0xf7, 0x48, 0x8b, 0x3c, 0x0a,
+    0x0f, 0xb6, 0x74, 0x0a, 0x08, 0x48, 0x8b, 0x55, 0x00, 0x0f, 0xb6, 0x4d, 0x08, 0x48, 0x89, 0x43,
+    0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x88, 0x74, 0x24, 0x46,
+    0x48, 0x89, 0x7c, 0x24, 0x3e, 0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x7c, 0x24, 0x10, 0x48,
+    0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x0e, 0x00, 0x00, 0x00, 0x48, 0x89,
+    0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0x45,
+    0x00, 0x0f, 0xb6, 0x44, 0x24, 0x28, 0x48, 0x83, 0xc4, 0x20, 0x88, 0x45, 0x08, 0x48, 0x83, 0xc4,
+    0x30, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x8b, 0x45, 0xf8, 0x31, 0xf6, 0x48, 0x39, 0x45, 0xef, 0x48, 0x89, 0xe7, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x0f, 0x9f, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04,
+    0x24, 0x48, 0x89, 0x45, 0xee, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x88, 0x45, 0xf6, 0x48, 0x83, 0x6b,
+    0x18, 0x01, 0xeb, 0xa9,
+};
+
+static const stencil_hole stencil_holes_OP_GT[] = {
+    { 55, HOLE_PC, 0, 0 },
+    { 99, HOLE_SYMBOL, 0, 0 },
+    { 185, HOLE_CONTINUE, 0, 0 },
+    { 223, HOLE_SYMBOL, 1, 0 },
+};
+
+#define STENCIL_OP_GT_TAIL 0
+#define STENCIL_OP_GT_HOLES 4
+
+static const uint8_t stencil_code_OP_GE[] = {
+    0x41, 0x54, 0x49, 0x89, 0xfc, 0x55, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x30, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x8d, 0x2c, 0xc0, 0x48, 0x01, 0xd5, 0x80, 0x7d, 0xee,
+    0x01, 0x75, 0x0a, 0x80, 0x7d, 0xf7, 0x01, 0x0f, 0x84, 0xa3, 0x00, 0x00, 0x00, 0x48, 0x83, 0xe8,
+    0x01, 0x48, 0x83, 0xec, 0x20, 0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48,
+    0x89, 0x4b, 0x20, 0x48, 0x8d, 0x0c, 0xc0, 0x48, 0x8d, 0x6c, 0x0a, 0xf7, 0x48, 0x8b, 0x3c, 0x0a,
+    0x0f, 0xb6, 0x74, 0x0a, 0x08, 0x48, 0x8b, 0x55, 0x00, 0x0f, 0xb6, 0x4d, 0x08, 0x48, 0x89, 0x43,
+    0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x88, 0x74, 0x24, 0x46,
+    0x48, 0x89, 0x7c, 0x24, 0x3e, 0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x7c, 0x24, 0x10, 0x48,
+    0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x0f, 0x00, 0x00, 0x00, 0x48, 0x89,
+    0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0x45,
+    0x00, 0x0f, 0xb6, 0x44, 0x24, 0x28, 0x48, 0x83, 0xc4, 0x20, 0x88, 0x45, 0x08, 0x48, 0x83, 0xc4,
+    0x30, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x8b, 0x45, 0xf8, 0x31, 0xf6, 0x48, 0x39, 0x45, 0xef, 0x48, 0x89, 0xe7, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x0f, 0x9d, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04,
+    0x24, 0x48, 0x89, 0x45, 0xee, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x88, 0x45, 0xf6, 0x48, 0x83, 0x6b,
+    0x18, 0x01, 0xeb, 0xa9,
+};
+
+static const stencil_hole stencil_holes_OP_GE[] = {
+    { 55, HOLE_PC, 0, 0 },
+    { 99, HOLE_SYMBOL, 0, 0 },
+    { 185, HOLE_CONTINUE, 0, 0 },
+    { 223, HOLE_SYMBOL, 1, 0 },
+};
+
+#define STENCIL_OP_GE_TAIL 0
+#define STENCIL_OP_GE_HOLES 4
+
+static const uint8_t stencil_code_OP_DIV[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x54, 0x55, 0x48, 0x89, 0xfd,
+    0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x50, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18,
+    0x48, 0x8b, 0x4f, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x8d, 0x14, 0xc0, 0x4c, 0x8d, 0x64, 0x11,
+    0xf7, 0x48, 0x8b, 0x3c, 0x11, 0x0f, 0xb6, 0x74, 0x11, 0x08, 0x49, 0x8b, 0x14, 0x24, 0x41, 0x0f,
+    0xb6, 0x4c, 0x24, 0x08, 0x48, 0x89, 0x43, 0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x48, 0x89, 0x7c, 0x24, 0x3e, 0x40, 0x88, 0x74, 0x24, 0x46, 0x48, 0x89, 0x7c, 0x24,
+    0x10, 0x48, 0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x04, 0x00, 0x00, 0x00,
+    0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48,
+    0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6,
+    0x44, 0x24, 0x28, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48, 0x83, 0xc4, 0x50, 0x48, 0xb8, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_DIV[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 74, HOLE_SYMBOL, 0, 0 },
+    { 158, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_DIV_TAIL 2
+#define STENCIL_OP_DIV_HOLES 3
+
+static const uint8_t stencil_code_OP_MOD[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x54, 0x55, 0x48, 0x89, 0xfd,
+    0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x50, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18,
+    0x48, 0x8b, 0x4f, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x8d, 0x14, 0xc0, 0x4c, 0x8d, 0x64, 0x11,
+    0xf7, 0x48, 0x8b, 0x3c, 0x11, 0x0f, 0xb6, 0x74, 0x11, 0x08, 0x49, 0x8b, 0x14, 0x24, 0x41, 0x0f,
+    0xb6, 0x4c, 0x24, 0x08, 0x48, 0x89, 0x43, 0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x48, 0x89, 0x7c, 0x24, 0x3e, 0x40, 0x88, 0x74, 0x24, 0x46, 0x48, 0x89, 0x7c, 0x24,
+    0x10, 0x48, 0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x05, 0x00, 0x00, 0x00,
+    0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48,
+    0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6,
+    0x44, 0x24, 0x28, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48, 0x83, 0xc4, 0x50, 0x48, 0xb8, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_MOD[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 74, HOLE_SYMBOL, 0, 0 },
+    { 158, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_MOD_TAIL 2
+#define STENCIL_OP_MOD_HOLES 3
+
+static const uint8_t stencil_code_OP_AND[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x54, 0x55, 0x48, 0x89, 0xfd,
+    0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x50, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18,
+    0x48, 0x8b, 0x4f, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x8d, 0x14, 0xc0, 0x4c, 0x8d, 0x64, 0x11,
+    0xf7, 0x48, 0x8b, 0x3c, 0x11, 0x0f, 0xb6, 0x74, 0x11, 0x08, 0x49, 0x8b, 0x14, 0x24, 0x41, 0x0f,
+    0xb6, 0x4c, 0x24, 0x08, 0x48, 0x89, 0x43, 0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x48, 0x89, 0x7c, 0x24, 0x3e, 0x40, 0x88, 0x74, 0x24, 0x46, 0x48, 0x89, 0x7c, 0x24,
+    0x10, 0x48, 0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x08, 0x00, 0x00, 0x00,
+    0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48,
+    0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6,
+    0x44, 0x24, 0x28, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48, 0x83, 0xc4, 0x50, 0x48, 0xb8, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_AND[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 74, HOLE_SYMBOL, 0, 0 },
+    { 158, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_AND_TAIL 2
+#define STENCIL_OP_AND_HOLES 3
+
+static const uint8_t stencil_code_OP_OR[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x54, 0x55, 0x48, 0x89, 0xfd,
+    0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x50, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18,
+    0x48, 0x8b, 0x4f, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x8d, 0x14, 0xc0, 0x4c, 0x8d, 0x64, 0x11,
+    0xf7, 0x48, 0x8b, 0x3c, 0x11, 0x0f, 0xb6, 0x74, 0x11, 0x08, 0x49, 0x8b, 0x14, 0x24, 0x41, 0x0f,
+    0xb6, 0x4c, 0x24, 0x08, 0x48, 0x89, 0x43, 0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x48, 0x89, 0x7c, 0x24, 0x3e, 0x40, 0x88, 0x74, 0x24, 0x46, 0x48, 0x89, 0x7c, 0x24,
+    0x10, 0x48, 0x8d, 0x7c, 0x24, 0x20, 0x40, 0x88, 0x74, 0x24, 0x18, 0xbe, 0x09, 0x00, 0x00, 0x00,
+    0x48, 0x89, 0x54, 0x24, 0x47, 0x48, 0x89, 0x14, 0x24, 0x88, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48,
+    0x8b, 0x44, 0x24, 0x20, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6,
+    0x44, 0x24, 0x28, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48, 0x83, 0xc4, 0x50, 0x48, 0xb8, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_OR[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 74, HOLE_SYMBOL, 0, 0 },
+    { 158, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_OR_TAIL 2
+#define STENCIL_OP_OR_HOLES 3
+
+static const uint8_t stencil_code_OP_NEG[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x54, 0x49, 0x89, 0xfc, 0x55,
+    0x48, 0x89, 0xf5, 0x53, 0x48, 0x83, 0xec, 0x20, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18,
+    0x48, 0x8d, 0x5c, 0xc0, 0xf7, 0x48, 0x03, 0x5f, 0x18, 0x48, 0x8d, 0x7c, 0x24, 0x10, 0x48, 0x8b,
+    0x03, 0x48, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x43, 0x08, 0x88, 0x44, 0x24, 0x08, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x10, 0x48, 0x89,
+    0xee, 0x4c, 0x89, 0xe7, 0x48, 0x89, 0x03, 0x0f, 0xb6, 0x44, 0x24, 0x18, 0x88, 0x43, 0x08, 0x48,
+    0x83, 0xc4, 0x20, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41,
+    0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_NEG[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 63, HOLE_SYMBOL, 2, 0 },
+    { 101, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_NEG_TAIL 2
+#define STENCIL_OP_NEG_HOLES 3
+
+static const uint8_t stencil_code_OP_NOT[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x55, 0x41, 0x54, 0x55, 0x48,
+    0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x28, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8d, 0x74, 0xc0, 0xf7, 0x48, 0x03, 0x77, 0x18, 0x48, 0x8d, 0x7c, 0x24, 0x17,
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x8b, 0x43, 0x18,
+    0x31, 0xf6, 0x48, 0x89, 0xe7, 0x4c, 0x8d, 0x24, 0xc0, 0x4c, 0x03, 0x65, 0x18, 0x80, 0x7c, 0x24,
+    0x18, 0x00, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x0f, 0x94, 0xc6,
+    0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x49, 0x89, 0x44, 0x24,
+    0xf7, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24, 0xff, 0x48, 0x83, 0xc4, 0x28, 0x48,
+    0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0x41, 0x5d, 0xff,
+    0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_NOT[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 50, HOLE_SYMBOL, 3, 0 },
+    { 84, HOLE_SYMBOL, 1, 0 },
+    { 129, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_NOT_TAIL 2
+#define STENCIL_OP_NOT_HOLES 4
+
+static const uint8_t stencil_code_OP_ADDI[] = {
+    0x48, 0x8b, 0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46, 0x18,
+    0x48, 0x8d, 0x04, 0xc0, 0x48, 0x8b, 0x4c, 0x02, 0x01, 0x48, 0x01, 0x4c, 0x02, 0xf8, 0x48, 0xb8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_ADDI[] = {
+    { 32, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_ADDI_TAIL 2
+#define STENCIL_OP_ADDI_HOLES 1
+
+static const uint8_t stencil_code_OP_SUBI[] = {
+    0x48, 0x8b, 0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46, 0x18,
+    0x48, 0x8d, 0x04, 0xc0, 0x48, 0x8b, 0x4c, 0x02, 0x01, 0x48, 0x29, 0x4c, 0x02, 0xf8, 0x48, 0xb8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_SUBI[] = {
+    { 32, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_SUBI_TAIL 2
+#define STENCIL_OP_SUBI_HOLES 1
+
+static const uint8_t stencil_code_OP_MULI[] = {
+    0x48, 0x8b, 0x46, 0x18, 0x4c, 0x8b, 0x47, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x8d, 0x0c, 0xc0,
+    0x48, 0x89, 0x46, 0x18, 0x49, 0x8d, 0x54, 0x08, 0xf7, 0x48, 0x8b, 0x42, 0x01, 0x49, 0x0f, 0xaf,
+    0x44, 0x08, 0x01, 0x48, 0x89, 0x42, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_MULI[] = {
+    { 41, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_MULI_TAIL 2
+#define STENCIL_OP_MULI_HOLES 1
+
+static const uint8_t stencil_code_OP_ADDF[] = {
+    0x48, 0x8b, 0x46, 0x18, 0x48, 0x8b, 0x4f, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x8d, 0x14, 0xc0,
+    0x48, 0x89, 0x46, 0x18, 0x48, 0x8d, 0x44, 0x11, 0xf7, 0xf2, 0x0f, 0x10, 0x40, 0x01, 0xf2, 0x0f,
+    0x58, 0x44, 0x11, 0x01, 0xf2, 0x0f, 0x11, 0x40, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_ADDF[] = {
+    { 43, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_ADDF_TAIL 2
+#define STENCIL_OP_ADDF_HOLES 1
+
+static const uint8_t stencil_code_OP_SUBF[] = {
+    0x48, 0x8b, 0x46, 0x18, 0x48, 0x8b, 0x4f, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x8d, 0x14, 0xc0,
+    0x48, 0x89, 0x46, 0x18, 0x48, 0x8d, 0x44, 0x11, 0xf7, 0xf2, 0x0f, 0x10, 0x40, 0x01, 0xf2, 0x0f,
+    0x5c, 0x44, 0x11, 0x01, 0xf2, 0x0f, 0x11, 0x40, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_SUBF[] = {
+    { 43, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_SUBF_TAIL 2
+#define STENCIL_OP_SUBF_HOLES 1
+
+static const uint8_t stencil_code_OP_MULF[] = {
+    0x48, 0x8b, 0x46, 0x18, 0x48, 0x8b, 0x4f, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x8d, 0x14, 0xc0,
+    0x48, 0x89, 0x46, 0x18, 0x48, 0x8d, 0x44, 0x11, 0xf7, 0xf2, 0x0f, 0x10, 0x40, 0x01, 0xf2, 0x0f,
+    0x59, 0x44, 0x11, 0x01, 0xf2, 0x0f, 0x11, 0x40, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_MULF[] = {
+    { 43, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_MULF_TAIL 2
+#define STENCIL_OP_MULF_HOLES 1
+
+static const uint8_t stencil_code_OP_DIVI[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x54, 0x49, 0x89, 0xfc, 0x55,
+    0x53, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xf3, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18,
+    0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46, 0x18, 0x48, 0x8d, 0x04, 0xc0, 0x48, 0x8b, 0x6c, 0x02,
+    0x01, 0x48, 0x85, 0xed, 0x74, 0x11, 0x66, 0x48, 0x0f, 0x6e, 0xcd, 0x66, 0x0f, 0xef, 0xc0, 0x66,
+    0x0f, 0x2e, 0xc8, 0x7a, 0x28, 0x75, 0x26, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x4c, 0x89, 0xe7, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0,
+    0x48, 0x8b, 0x43, 0x18, 0x49, 0x8b, 0x54, 0x24, 0x18, 0x48, 0x8d, 0x04, 0xc0, 0x48, 0x8d, 0x4c,
+    0x02, 0xf7, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0x8b, 0x41, 0x01, 0x48, 0x99, 0x48, 0xf7,
+    0xfd, 0x48, 0x89, 0x41, 0x01, 0x5b, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x5d, 0x41, 0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_DIVI[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 73, HOLE_SYMBOL, 4, 0 },
+    { 86, HOLE_DATA, 0, 0 },
+    { 136, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_DIVI_TAIL 2
+#define STENCIL_OP_DIVI_HOLES 4
+
+static const uint8_t stencil_code_OP_MODI[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x53, 0x48, 0x89, 0xf3, 0x48,
+    0x83, 0xec, 0x18, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48,
+    0x83, 0xe8, 0x01, 0x48, 0x89, 0x46, 0x18, 0x48, 0x8d, 0x04, 0xc0, 0x48, 0x8b, 0x6c, 0x02, 0x01,
+    0x48, 0x85, 0xed, 0x74, 0x2b, 0x48, 0x8d, 0x4c, 0x02, 0xf7, 0x48, 0x89, 0xde, 0x48, 0x8b, 0x41,
+    0x01, 0x48, 0x99, 0x48, 0xf7, 0xfd, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x89, 0x51, 0x01, 0x48, 0x83, 0xc4, 0x18, 0x5b, 0x5d, 0xff, 0xe0, 0x0f, 0x1f, 0x40, 0x00,
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0x7c, 0x24, 0x08, 0x48,
+    0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x8b, 0x7c, 0x24, 0x08,
+    0x48, 0x8b, 0x43, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x8d, 0x04, 0xc0, 0xeb, 0xa7,
+};
+
+static const stencil_hole stencil_holes_OP_MODI[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 72, HOLE_CONTINUE, 0, 0 },
+    { 98, HOLE_SYMBOL, 4, 0 },
+    { 113, HOLE_DATA, 0, 21 },
+};
+
+#define STENCIL_OP_MODI_TAIL 0
+#define STENCIL_OP_MODI_HOLES 4
+
+static const uint8_t stencil_code_OP_DIVF[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x53, 0x66, 0x0f, 0xef, 0xc0, 0x48,
+    0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18, 0x48, 0x8b,
+    0x57, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46, 0x18, 0x48, 0x8d, 0x04, 0xc0, 0xf2, 0x0f,
+    0x10, 0x4c, 0x02, 0x01, 0x66, 0x0f, 0x2e, 0xc8, 0x7a, 0x02, 0x74, 0x2c, 0x48, 0x8d, 0x44, 0x02,
+    0xf7, 0x48, 0x89, 0xde, 0xf2, 0x0f, 0x10, 0x40, 0x01, 0xf2, 0x0f, 0x5e, 0xc1, 0xf2, 0x0f, 0x11,
+    0x40, 0x01, 0x48, 0x83, 0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x5b, 0xff, 0xe0, 0x0f, 0x1f, 0x44, 0x00, 0x00, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x48, 0x89, 0x3c, 0x24, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xf2, 0x0f, 0x11, 0x4c, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x8b, 0x3c, 0x24, 0x48, 0x8b, 0x43, 0x18,
+    0xf2, 0x0f, 0x10, 0x4c, 0x24, 0x08, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x8d, 0x04, 0xc0, 0xeb, 0x9c,
+};
+
+static const stencil_hole stencil_holes_OP_DIVF[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 88, HOLE_CONTINUE, 0, 0 },
+    { 106, HOLE_SYMBOL, 4, 0 },
+    { 120, HOLE_DATA, 0, 0 },
+};
+
+#define STENCIL_OP_DIVF_TAIL 0
+#define STENCIL_OP_DIVF_HOLES 4
+
+static const uint8_t stencil_code_OP_EQI[] = {
+    0x41, 0x54, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x8d, 0x04, 0xc0, 0x31, 0xf6, 0x4c, 0x8d, 0x64, 0x02, 0xf7, 0x49, 0x8b, 0x4c, 0x24,
+    0x01, 0x48, 0x39, 0x4c, 0x02, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x40, 0x0f, 0x94, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef,
+    0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48, 0x83,
+    0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c,
+    0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_EQI[] = {
+    { 56, HOLE_SYMBOL, 1, 0 },
+    { 100, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_EQI_TAIL 2
+#define STENCIL_OP_EQI_HOLES 2
+
+static const uint8_t stencil_code_OP_NEI[] = {
+    0x41, 0x54, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x8d, 0x04, 0xc0, 0x31, 0xf6, 0x4c, 0x8d, 0x64, 0x02, 0xf7, 0x49, 0x8b, 0x4c, 0x24,
+    0x01, 0x48, 0x39, 0x4c, 0x02, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x40, 0x0f, 0x95, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef,
+    0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48, 0x83,
+    0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c,
+    0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_NEI[] = {
+    { 56, HOLE_SYMBOL, 1, 0 },
+    { 100, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_NEI_TAIL 2
+#define STENCIL_OP_NEI_HOLES 2
+
+static const uint8_t stencil_code_OP_LTI[] = {
+    0x41, 0x54, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x8d, 0x04, 0xc0, 0x31, 0xf6, 0x4c, 0x8d, 0x64, 0x02, 0xf7, 0x48, 0x8b, 0x44, 0x02,
+    0x01, 0x49, 0x39, 0x44, 0x24, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x40, 0x0f, 0x9c, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef,
+    0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48, 0x83,
+    0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c,
+    0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_LTI[] = {
+    { 56, HOLE_SYMBOL, 1, 0 },
+    { 100, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_LTI_TAIL 2
+#define STENCIL_OP_LTI_HOLES 2
+
+static const uint8_t stencil_code_OP_LEI[] = {
+    0x41, 0x54, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x8d, 0x04, 0xc0, 0x31, 0xf6, 0x4c, 0x8d, 0x64, 0x02, 0xf7, 0x48, 0x8b, 0x44, 0x02,
+    0x01, 0x49, 0x39, 0x44, 0x24, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x40, 0x0f, 0x9e, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef,
+    0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48, 0x83,
+    0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c,
+    0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_LEI[] = {
+    { 56, HOLE_SYMBOL, 1, 0 },
+    { 100, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_LEI_TAIL 2
+#define STENCIL_OP_LEI_HOLES 2
+
+static const uint8_t stencil_code_OP_GTI[] = {
+    0x41, 0x54, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x8d, 0x04, 0xc0, 0x31, 0xf6, 0x4c, 0x8d, 0x64, 0x02, 0xf7, 0x48, 0x8b, 0x44, 0x02,
+    0x01, 0x49, 0x39, 0x44, 0x24, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x40, 0x0f, 0x9f, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef,
+    0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48, 0x83,
+    0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c,
+    0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_GTI[] = {
+    { 56, HOLE_SYMBOL, 1, 0 },
+    { 100, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_GTI_TAIL 2
+#define STENCIL_OP_GTI_HOLES 2
+
+static const uint8_t stencil_code_OP_GEI[] = {
+    0x41, 0x54, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x8d, 0x04, 0xc0, 0x31, 0xf6, 0x4c, 0x8d, 0x64, 0x02, 0xf7, 0x48, 0x8b, 0x44, 0x02,
+    0x01, 0x49, 0x39, 0x44, 0x24, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x40, 0x0f, 0x9d, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef,
+    0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48, 0x83,
+    0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c,
+    0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_GEI[] = {
+    { 56, HOLE_SYMBOL, 1, 0 },
+    { 100, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_GEI_TAIL 2
+#define STENCIL_OP_GEI_HOLES 2
+
+static const uint8_t stencil_code_OP_LTF[] = {
+    0x41, 0x54, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x8d, 0x04, 0xc0, 0x31, 0xf6, 0x4c, 0x8d, 0x64, 0x02, 0xf7, 0xf2, 0x0f, 0x10, 0x44,
+    0x02, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x66, 0x41, 0x0f, 0x2f,
+    0x44, 0x24, 0x01, 0x40, 0x0f, 0x97, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde,
+    0x48, 0x89, 0xef, 0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24,
+    0x08, 0x48, 0x83, 0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b,
+    0x5d, 0x41, 0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_LTF[] = {
+    { 52, HOLE_SYMBOL, 1, 0 },
+    { 103, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_LTF_TAIL 2
+#define STENCIL_OP_LTF_HOLES 2
+
+static const uint8_t stencil_code_OP_LEF[] = {
+    0x41, 0x54, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x8d, 0x04, 0xc0, 0x31, 0xf6, 0x4c, 0x8d, 0x64, 0x02, 0xf7, 0xf2, 0x0f, 0x10, 0x44,
+    0x02, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x66, 0x41, 0x0f, 0x2f,
+    0x44, 0x24, 0x01, 0x40, 0x0f, 0x93, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde,
+    0x48, 0x89, 0xef, 0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24,
+    0x08, 0x48, 0x83, 0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b,
+    0x5d, 0x41, 0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_LEF[] = {
+    { 52, HOLE_SYMBOL, 1, 0 },
+    { 103, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_LEF_TAIL 2
+#define STENCIL_OP_LEF_HOLES 2
+
+static const uint8_t stencil_code_OP_GTF[] = {
+    0x41, 0x54, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x8d, 0x04, 0xc0, 0x31, 0xf6, 0x4c, 0x8d, 0x64, 0x02, 0xf7, 0xf2, 0x41, 0x0f, 0x10,
+    0x44, 0x24, 0x01, 0x66, 0x0f, 0x2f, 0x44, 0x02, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x40, 0x0f, 0x97, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde,
+    0x48, 0x89, 0xef, 0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24,
+    0x08, 0x48, 0x83, 0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b,
+    0x5d, 0x41, 0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_GTF[] = {
+    { 59, HOLE_SYMBOL, 1, 0 },
+    { 103, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_GTF_TAIL 2
+#define STENCIL_OP_GTF_HOLES 2
+
+static const uint8_t stencil_code_OP_GEF[] = {
+    0x41, 0x54, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x8d, 0x04, 0xc0, 0x31, 0xf6, 0x4c, 0x8d, 0x64, 0x02, 0xf7, 0xf2, 0x41, 0x0f, 0x10,
+    0x44, 0x24, 0x01, 0x66, 0x0f, 0x2f, 0x44, 0x02, 0x01, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x40, 0x0f, 0x93, 0xc6, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde,
+    0x48, 0x89, 0xef, 0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24,
+    0x08, 0x48, 0x83, 0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b,
+    0x5d, 0x41, 0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_GEF[] = {
+    { 59, HOLE_SYMBOL, 1, 0 },
+    { 103, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_GEF_TAIL 2
+#define STENCIL_OP_GEF_HOLES 2
+
+static const uint8_t stencil_code_OP_POP[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0x6e, 0x18, 0x01, 0xff,
+    0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_POP[] = {
+    { 2, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_POP_TAIL 2
+#define STENCIL_OP_POP_HOLES 1
+
+static const uint8_t stencil_code_OP_TNEW[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x54, 0x55, 0x48, 0x89, 0xfd,
+    0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x10, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18,
+    0x4c, 0x8b, 0x67, 0x18, 0x48, 0x89, 0xe7, 0x48, 0x8d, 0x50, 0x01, 0x48, 0x8d, 0x04, 0xc0, 0x49,
+    0x01, 0xc4, 0x48, 0x89, 0x56, 0x18, 0xbe, 0x0a, 0x00, 0x00, 0x00, 0x48, 0xb8, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x48, 0x89, 0xde, 0x48, 0x89,
+    0xef, 0x49, 0x89, 0x04, 0x24, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x41, 0x88, 0x44, 0x24, 0x08, 0x48,
+    0x83, 0xc4, 0x10, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41,
+    0x5c, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_TNEW[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 61, HOLE_SYMBOL, 5, 0 },
+    { 101, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_TNEW_TAIL 2
+#define STENCIL_OP_TNEW_HOLES 3
+
+static const uint8_t stencil_code_OP_TPUT[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48,
+    0x89, 0xf3, 0x48, 0x83, 0xec, 0x28, 0x48, 0x8b, 0x4e, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x89,
+    0x46, 0x20, 0x48, 0x8d, 0x44, 0xc9, 0xf7, 0x4c, 0x8d, 0x51, 0xfd, 0x4c, 0x8b, 0x0c, 0x02, 0x44,
+    0x0f, 0xb6, 0x44, 0x02, 0x08, 0x48, 0x8b, 0x7c, 0x02, 0xf7, 0x0f, 0xb6, 0x74, 0x02, 0xff, 0x48,
+    0x8d, 0x44, 0x02, 0xee, 0x4c, 0x89, 0x53, 0x18, 0x80, 0x38, 0x06, 0x4c, 0x89, 0x4c, 0x24, 0x0e,
+    0x44, 0x88, 0x44, 0x24, 0x16, 0x48, 0x89, 0x7c, 0x24, 0x17, 0x40, 0x88, 0x74, 0x24, 0x1f, 0x74,
+    0x37, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0xef, 0x48, 0xb8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x83, 0xc4, 0x28, 0x48, 0x89,
+    0xde, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d,
+    0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x44, 0x00, 0x00, 0x48, 0x8b, 0x40, 0x01, 0x48, 0x83, 0xec, 0x20,
+    0x48, 0x83, 0xe9, 0x02, 0x48, 0x89, 0x4b, 0x18, 0x48, 0x89, 0x3c, 0x24, 0x48, 0x89, 0xc7, 0x48,
+    0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x89, 0x4c, 0x24, 0x10, 0x44, 0x88,
+    0x44, 0x24, 0x18, 0x40, 0x88, 0x74, 0x24, 0x08, 0xff, 0xd0, 0x48, 0x83, 0xc4, 0x20, 0xeb, 0xaa,
+};
+
+static const stencil_hole stencil_holes_OP_TPUT[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 99, HOLE_DATA, 0, 112 },
+    { 112, HOLE_SYMBOL, 4, 0 },
+    { 134, HOLE_CONTINUE, 0, 0 },
+    { 177, HOLE_SYMBOL, 6, 0 },
+};
+
+#define STENCIL_OP_TPUT_TAIL 0
+#define STENCIL_OP_TPUT_HOLES 5
+
+static const uint8_t stencil_code_OP_TGET[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x54, 0x49, 0x89, 0xfc, 0x55,
+    0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x20, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18,
+    0x48, 0x8b, 0x4f, 0x18, 0x48, 0x8d, 0x54, 0xc0, 0xf7, 0x48, 0x83, 0xe8, 0x02, 0x48, 0x8b, 0x3c,
+    0x11, 0x0f, 0xb6, 0x74, 0x11, 0x08, 0x48, 0x8d, 0x6c, 0x11, 0xf7, 0x48, 0x89, 0x43, 0x18, 0x80,
+    0x7d, 0x00, 0x06, 0x48, 0x89, 0x7c, 0x24, 0x17, 0x40, 0x88, 0x74, 0x24, 0x1f, 0x74, 0x41, 0x48,
+    0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x83, 0x43, 0x18, 0x01, 0x48, 0x89, 0xde,
+    0x4c, 0x89, 0xe7, 0x48, 0x83, 0xc4, 0x20, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x5b, 0x5d, 0x41, 0x5c, 0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x8b, 0x45, 0x01, 0x48, 0x83, 0xec, 0x10, 0x48, 0x89, 0x3c, 0x24, 0x48, 0x8d, 0x7c, 0x24,
+    0x10, 0x40, 0x88, 0x74, 0x24, 0x08, 0x48, 0x89, 0xc6, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x8b, 0x44, 0x24, 0x10, 0x48, 0x89, 0x45, 0x00, 0x0f, 0xb6,
+    0x44, 0x24, 0x18, 0x88, 0x45, 0x08, 0x58, 0x5a, 0xeb, 0x9e,
+};
+
+static const stencil_hole stencil_holes_OP_TGET[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 81, HOLE_DATA, 0, 152 },
+    { 94, HOLE_SYMBOL, 4, 0 },
+    { 121, HOLE_CONTINUE, 0, 0 },
+    { 171, HOLE_SYMBOL, 7, 0 },
+};
+
+#define STENCIL_OP_TGET_TAIL 0
+#define STENCIL_OP_TGET_HOLES 5
+
+static const uint8_t stencil_code_OP_NOP[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_NOP[] = {
+    { 2, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_NOP_TAIL 2
+#define STENCIL_OP_NOP_HOLES 1
+
+static const uint8_t stencil_code_OP_PUSHK[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48,
+    0x89, 0xf3, 0x48, 0x83, 0xec, 0x18, 0x48, 0x8b, 0x4e, 0x18, 0x48, 0x8b, 0x55, 0x18, 0x48, 0x89,
+    0x46, 0x20, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x8b, 0x38, 0xa0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x8d, 0x71, 0x01, 0x48, 0x8d, 0x0c, 0xc9,
+    0x48, 0x01, 0xca, 0x48, 0x89, 0x73, 0x18, 0x48, 0x89, 0x3a, 0x88, 0x42, 0x08, 0x48, 0x81, 0xfe,
+    0xfe, 0x00, 0x00, 0x00, 0x77, 0x1a, 0x48, 0x83, 0xc4, 0x18, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef,
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0xff, 0xe0, 0x66, 0x90,
+    0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0xeb, 0xcb,
+};
+
+static const stencil_hole stencil_holes_OP_PUSHK[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 36, HOLE_CONSTANT, 0, 0 },
+    { 48, HOLE_CONSTANT, 0, 8 },
+    { 98, HOLE_CONTINUE, 0, 0 },
+    { 114, HOLE_DATA, 0, 41 },
+    { 127, HOLE_SYMBOL, 4, 0 },
+};
+
+#define STENCIL_OP_PUSHK_TAIL 0
+#define STENCIL_OP_PUSHK_HOLES 6
+
+static const uint8_t stencil_code_OP_LOADG[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48,
+    0x89, 0xf3, 0x48, 0x83, 0xec, 0x18, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x53, 0x18, 0x48, 0xb8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc1, 0xe0, 0x08, 0xc1, 0xf8, 0x08, 0x48, 0x8d,
+    0x4a, 0x01, 0x48, 0x8d, 0x14, 0xd2, 0x48, 0x98, 0x48, 0x8d, 0x04, 0xc0, 0x48, 0x03, 0x47, 0x10,
+    0x48, 0x8b, 0x30, 0x0f, 0xb6, 0x78, 0x08, 0x48, 0x8b, 0x45, 0x18, 0x48, 0x89, 0x4b, 0x18, 0x48,
+    0x89, 0x74, 0x24, 0x07, 0x48, 0x01, 0xd0, 0x48, 0x89, 0x30, 0x40, 0x88, 0x78, 0x08, 0x48, 0x81,
+    0xf9, 0xfe, 0x00, 0x00, 0x00, 0x77, 0x19, 0x48, 0x83, 0xc4, 0x18, 0x48, 0x89, 0xde, 0x48, 0x89,
+    0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0xff, 0xe0, 0x90,
+    0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0xeb, 0xcc,
+};
+
+static const stencil_hole stencil_holes_OP_LOADG[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 32, HOLE_OPERAND, 0, 0 },
+    { 115, HOLE_CONTINUE, 0, 0 },
+    { 130, HOLE_DATA, 0, 41 },
+    { 143, HOLE_SYMBOL, 4, 0 },
+};
+
+#define STENCIL_OP_LOADG_TAIL 0
+#define STENCIL_OP_LOADG_HOLES 5
+
+static const uint8_t stencil_code_OP_LOADL[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48,
+    0x89, 0xf3, 0x48, 0x83, 0xec, 0x18, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x57, 0x18, 0x48, 0xb8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc1, 0xe0, 0x08, 0xc1, 0xf8, 0x08, 0x48, 0x98,
+    0x48, 0x03, 0x46, 0x08, 0x48, 0x8d, 0x04, 0xc0, 0x48, 0x01, 0xd0, 0x48, 0x8b, 0x30, 0x0f, 0xb6,
+    0x78, 0x08, 0x48, 0x8b, 0x43, 0x18, 0x48, 0x89, 0x74, 0x24, 0x07, 0x48, 0x8d, 0x48, 0x01, 0x48,
+    0x8d, 0x04, 0xc0, 0x48, 0x01, 0xd0, 0x48, 0x89, 0x4b, 0x18, 0x48, 0x89, 0x30, 0x40, 0x88, 0x78,
+    0x08, 0x48, 0x81, 0xf9, 0xfe, 0x00, 0x00, 0x00, 0x77, 0x1e, 0x48, 0x83, 0xc4, 0x18, 0x48, 0x89,
+    0xde, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d,
+    0xff, 0xe0, 0x66, 0x0f, 0x1f, 0x44, 0x00, 0x00, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
+    0xd0, 0xeb, 0xc7,
+};
+
+static const stencil_hole stencil_holes_OP_LOADL[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 32, HOLE_OPERAND, 0, 0 },
+    { 118, HOLE_CONTINUE, 0, 0 },
+    { 138, HOLE_DATA, 0, 41 },
+    { 151, HOLE_SYMBOL, 4, 0 },
+};
+
+#define STENCIL_OP_LOADL_TAIL 0
+#define STENCIL_OP_LOADL_HOLES 5
+
+static const uint8_t stencil_code_OP_LOADC[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48,
+    0x89, 0xf3, 0x48, 0x83, 0xec, 0x18, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x16, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x89, 0xc0, 0x48, 0x8d, 0x04, 0xc0, 0x48, 0x03, 0x42,
+    0x08, 0x48, 0x8b, 0x53, 0x18, 0x48, 0x8b, 0x30, 0x0f, 0xb6, 0x78, 0x08, 0x48, 0x8b, 0x45, 0x18,
+    0x48, 0x8d, 0x4a, 0x01, 0x48, 0x8d, 0x14, 0xd2, 0x48, 0x89, 0x4b, 0x18, 0x48, 0x01, 0xd0, 0x48,
+    0x89, 0x74, 0x24, 0x07, 0x48, 0x89, 0x30, 0x40, 0x88, 0x78, 0x08, 0x48, 0x81, 0xf9, 0xfe, 0x00,
+    0x00, 0x00, 0x77, 0x1c, 0x48, 0x83, 0xc4, 0x18, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x48, 0xb8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0xff, 0xe0, 0x0f, 0x1f, 0x40, 0x00,
+    0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0xeb, 0xc9,
+};
+
+static const stencil_hole stencil_holes_OP_LOADC[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 31, HOLE_OPERAND, 0, 0 },
+    { 112, HOLE_CONTINUE, 0, 0 },
+    { 130, HOLE_DATA, 0, 41 },
+    { 143, HOLE_SYMBOL, 4, 0 },
+};
+
+#define STENCIL_OP_LOADC_TAIL 0
+#define STENCIL_OP_LOADC_HOLES 5
+
+static const uint8_t stencil_code_OP_DUP[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48,
+    0x89, 0xf3, 0x48, 0x83, 0xec, 0x18, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18, 0x48, 0x8b,
+    0x4f, 0x18, 0x48, 0x8d, 0x14, 0xc0, 0x48, 0x83, 0xc0, 0x01, 0x48, 0x8b, 0x74, 0x11, 0xf7, 0x0f,
+    0xb6, 0x7c, 0x11, 0xff, 0x48, 0x89, 0x43, 0x18, 0x48, 0x89, 0x74, 0x24, 0x07, 0x48, 0x89, 0x34,
+    0x11, 0x40, 0x88, 0x7c, 0x11, 0x08, 0x48, 0x3d, 0xfe, 0x00, 0x00, 0x00, 0x77, 0x22, 0x48, 0x83,
+    0xc4, 0x18, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x5b, 0x5d, 0xff, 0xe0, 0x66, 0x2e, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0xeb, 0xc3,
+};
+
+static const stencil_hole stencil_holes_OP_DUP[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 90, HOLE_CONTINUE, 0, 0 },
+    { 114, HOLE_DATA, 0, 41 },
+    { 127, HOLE_SYMBOL, 4, 0 },
+};
+
+#define STENCIL_OP_DUP_TAIL 0
+#define STENCIL_OP_DUP_HOLES 4
+
+static const uint8_t stencil_code_OP_STORG[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83,
+    0xec, 0x10, 0x48, 0x8b, 0x4b, 0x18, 0x48, 0x89, 0x46, 0x20, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x48, 0x8b, 0x77, 0x18, 0xc1, 0xe0, 0x08, 0x48, 0x8d, 0x51, 0xff, 0xc1,
+    0xf8, 0x08, 0x48, 0x89, 0x53, 0x18, 0x48, 0x8d, 0x14, 0xd2, 0x48, 0x63, 0xc8, 0x48, 0x01, 0xf2,
+    0x48, 0x8d, 0x0c, 0xc9, 0x48, 0x03, 0x4f, 0x10, 0x48, 0x8b, 0x32, 0x48, 0x89, 0x31, 0x0f, 0xb6,
+    0x52, 0x08, 0x88, 0x51, 0x08, 0x3d, 0xfe, 0x0f, 0x00, 0x00, 0x7f, 0x14, 0x48, 0x83, 0xc4, 0x10,
+    0x48, 0x89, 0xde, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0xff, 0xe0,
+    0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0x7c, 0x24, 0x08, 0x48,
+    0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x8b, 0x7c, 0x24, 0x08,
+    0xeb, 0xca,
+};
+
+static const stencil_hole stencil_holes_OP_STORG[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 28, HOLE_OPERAND, 0, 0 },
+    { 101, HOLE_CONTINUE, 0, 0 },
+    { 114, HOLE_DATA, 0, 41 },
+    { 129, HOLE_SYMBOL, 4, 0 },
+};
+
+#define STENCIL_OP_STORG_TAIL 0
+#define STENCIL_OP_STORG_HOLES 5
+
+static const uint8_t stencil_code_OP_STORL[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83,
+    0xec, 0x10, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46, 0x18, 0x48, 0x8b, 0x57, 0x18, 0x48, 0x8d,
+    0x48, 0xff, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc1, 0xe0, 0x08, 0x48,
+    0x89, 0x4e, 0x18, 0x48, 0x8d, 0x0c, 0xc9, 0xc1, 0xf8, 0x08, 0x48, 0x98, 0x48, 0x03, 0x46, 0x08,
+    0x48, 0x8d, 0x34, 0xc0, 0x48, 0x01, 0xd6, 0x48, 0x01, 0xca, 0x48, 0x8b, 0x0a, 0x48, 0x89, 0x0e,
+    0x0f, 0xb6, 0x52, 0x08, 0x88, 0x56, 0x08, 0x48, 0x3d, 0xfe, 0x00, 0x00, 0x00, 0x77, 0x19, 0x48,
+    0x83, 0xc4, 0x10, 0x48, 0x89, 0xde, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x5b, 0xff, 0xe0, 0x0f, 0x1f, 0x44, 0x00, 0x00, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x48, 0x89, 0x7c, 0x24, 0x08, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xff, 0xd0, 0x48, 0x8b, 0x7c, 0x24, 0x08, 0xeb, 0xc5,
+};
+
+static const stencil_hole stencil_holes_OP_STORL[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 36, HOLE_OPERAND, 0, 0 },
+    { 104, HOLE_CONTINUE, 0, 0 },
+    { 122, HOLE_DATA, 0, 41 },
+    { 137, HOLE_SYMBOL, 4, 0 },
+};
+
+#define STENCIL_OP_STORL_TAIL 0
+#define STENCIL_OP_STORL_HOLES 5
+
+static const uint8_t stencil_code_OP_STORC[] = {
+    0x48, 0x8b, 0x46, 0x18, 0x48, 0x8b, 0x4f, 0x18, 0x48, 0xba, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x4c, 0x8b, 0x06, 0x89, 0xd2, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x8d, 0x14, 0xd2, 0x48,
+    0x89, 0x46, 0x18, 0x48, 0x8d, 0x04, 0xc0, 0x49, 0x03, 0x50, 0x08, 0x48, 0x01, 0xc8, 0x48, 0x8b,
+    0x08, 0x48, 0x89, 0x0a, 0x0f, 0xb6, 0x40, 0x08, 0x88, 0x42, 0x08, 0x48, 0xb8, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_STORC[] = {
+    { 10, HOLE_OPERAND, 0, 0 },
+    { 61, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_STORC_TAIL 2
+#define STENCIL_OP_STORC_HOLES 2
+
+static const uint8_t stencil_code_OP_CALL[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48,
+    0x89, 0xf3, 0x48, 0x81, 0xec, 0xf8, 0x03, 0x00, 0x00, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x46,
+    0x18, 0x48, 0x8b, 0x7f, 0x18, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x8d, 0x14, 0xc0, 0x48, 0x89, 0x46,
+    0x18, 0x48, 0x01, 0xd7, 0x80, 0x3f, 0x05, 0x74, 0x4c, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xc6, 0x04, 0x24, 0x00, 0xff, 0xd0, 0x48, 0x89, 0xe7, 0x48, 0xbe, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x89, 0xc2, 0x31, 0xc0, 0xff, 0xd1, 0x48, 0x89, 0xef, 0x48, 0x89, 0xe6, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x8b, 0x43, 0x18, 0x48, 0x8d, 0x3c,
+    0xc0, 0x48, 0x03, 0x7d, 0x18, 0x48, 0x8b, 0x4f, 0x01, 0x48, 0x8b, 0x11, 0x48, 0x8b, 0x52, 0x18,
+    0x48, 0x29, 0xd0, 0x48, 0x89, 0x43, 0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x89, 0xc0, 0x48, 0x39, 0xc2, 0x74, 0x38, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
+    0xd0, 0x48, 0x81, 0xc4, 0xf8, 0x03, 0x00, 0x00, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x48, 0xb8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0xff, 0xe0, 0x0f, 0x1f, 0x40, 0x00,
+    0x48, 0x89, 0xca, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xd0, 0xeb, 0xca,
+};
+
+static const stencil_hole stencil_holes_OP_CALL[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 59, HOLE_SYMBOL, 8, 0 },
+    { 78, HOLE_DATA, 0, 200 },
+    { 88, HOLE_SYMBOL, 9, 0 },
+    { 111, HOLE_SYMBOL, 4, 0 },
+    { 153, HOLE_OPERAND, 0, 0 },
+    { 170, HOLE_DATA, 0, 248 },
+    { 183, HOLE_SYMBOL, 4, 0 },
+    { 208, HOLE_CONTINUE, 0, 0 },
+    { 235, HOLE_SYMBOL, 10, 0 },
+};
+
+#define STENCIL_OP_CALL_TAIL 0
+#define STENCIL_OP_CALL_HOLES 10
+
+static const uint8_t stencil_code_OP_CLOSE[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x55, 0x49, 0xbd, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x54, 0x45, 0x89, 0xed, 0x49, 0x89, 0xf4, 0x55, 0x4b,
+    0x8d, 0x6c, 0xed, 0x00, 0x53, 0x48, 0x89, 0xfb, 0x48, 0x89, 0xef, 0x48, 0x83, 0xec, 0x18, 0x48,
+    0x89, 0x46, 0x20, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x4d,
+    0x8b, 0x44, 0x24, 0x18, 0x48, 0x8b, 0x7b, 0x18, 0x48, 0x89, 0xc2, 0x4d, 0x29, 0xe8, 0x4d, 0x89,
+    0x44, 0x24, 0x18, 0x4d, 0x85, 0xed, 0x0f, 0x84, 0x84, 0x00, 0x00, 0x00, 0x4e, 0x8d, 0x0c, 0xc5,
+    0x00, 0x00, 0x00, 0x00, 0x31, 0xc0, 0x4b, 0x8d, 0x0c, 0x01, 0x48, 0x01, 0xf9, 0x0f, 0x1f, 0x00,
+    0x48, 0x8b, 0x34, 0x01, 0x48, 0x89, 0x34, 0x02, 0x0f, 0xb6, 0x74, 0x01, 0x08, 0x40, 0x88, 0x74,
+    0x02, 0x08, 0x48, 0x83, 0xc0, 0x09, 0x48, 0x39, 0xc5, 0x75, 0xe5, 0x4b, 0x8d, 0x44, 0x08, 0xf7,
+    0x48, 0x8d, 0x2c, 0x07, 0x48, 0x89, 0xe7, 0x48, 0x8b, 0x45, 0x01, 0x48, 0x8b, 0x30, 0x48, 0xb8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x8b, 0x04, 0x24, 0x4c, 0x89,
+    0xe6, 0x48, 0x89, 0xdf, 0x48, 0x89, 0x45, 0x00, 0x0f, 0xb6, 0x44, 0x24, 0x08, 0x88, 0x45, 0x08,
+    0x48, 0x83, 0xc4, 0x18, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d,
+    0x41, 0x5c, 0x41, 0x5d, 0xff, 0xe0, 0x66, 0x2e, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x4e, 0x8d, 0x0c, 0xc5, 0x00, 0x00, 0x00, 0x00, 0xeb, 0xa1,
+};
+
+static const stencil_hole stencil_holes_OP_CLOSE[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 14, HOLE_OPERAND, 0, 0 },
+    { 53, HOLE_SYMBOL, 11, 0 },
+    { 160, HOLE_SYMBOL, 12, 0 },
+    { 198, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_CLOSE_TAIL 0
+#define STENCIL_OP_CLOSE_HOLES 5
+
+static const uint8_t stencil_code_OP_RET[] = {
+    0x48, 0x8b, 0x47, 0x18, 0x48, 0x8b, 0x7e, 0x18, 0x48, 0x8d, 0x57, 0xff, 0x48, 0x89, 0x56, 0x18,
+    0x48, 0x8b, 0x76, 0x28, 0x48, 0x8d, 0x14, 0xd2, 0x48, 0x8b, 0x4e, 0x18, 0x48, 0x8d, 0x79, 0x01,
+    0x48, 0x8d, 0x0c, 0xc9, 0x48, 0x01, 0xc1, 0x48, 0x01, 0xd0, 0x48, 0x89, 0x7e, 0x18, 0x48, 0x8b,
+    0x10, 0x48, 0x89, 0x11, 0x0f, 0xb6, 0x40, 0x08, 0x88, 0x41, 0x08, 0x31, 0xc0, 0xc3,
+};
+
+static const stencil_hole stencil_holes_OP_RET[] = {
+    { 0 },
+};
+
+#define STENCIL_OP_RET_TAIL 0
+#define STENCIL_OP_RET_HOLES 0
+
+static const uint8_t stencil_code_OP_TAILCALL[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x55, 0x48, 0xb9, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x54, 0x41, 0x89, 0xcc, 0x55, 0x48, 0x89, 0xfd, 0x53,
+    0x48, 0x89, 0xf3, 0x48, 0x81, 0xec, 0xf8, 0x03, 0x00, 0x00, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b,
+    0x46, 0x18, 0x48, 0x8b, 0x7f, 0x18, 0x48, 0x8d, 0x54, 0xc0, 0xf7, 0x48, 0x01, 0xfa, 0x80, 0x3a,
+    0x05, 0x4c, 0x8b, 0x6a, 0x01, 0x0f, 0x84, 0xb5, 0x00, 0x00, 0x00, 0x48, 0x83, 0xe8, 0x01, 0x48,
+    0x8d, 0x14, 0xc0, 0x48, 0x89, 0x43, 0x18, 0x48, 0x01, 0xd7, 0x80, 0x3f, 0x05, 0x74, 0x4c, 0x48,
+    0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x04, 0x24, 0x00, 0xff, 0xd0, 0x48,
+    0x89, 0xe7, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0xb9, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0xc2, 0x31, 0xc0, 0xff, 0xd1, 0x48, 0x89, 0xef,
+    0x48, 0x89, 0xe6, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48,
+    0x8b, 0x43, 0x18, 0x48, 0x8d, 0x3c, 0xc0, 0x48, 0x03, 0x7d, 0x18, 0x48, 0x8b, 0x4f, 0x01, 0x48,
+    0x8b, 0x11, 0x48, 0x8b, 0x52, 0x18, 0x48, 0x29, 0xd0, 0x48, 0x89, 0x43, 0x18, 0x4c, 0x39, 0xe2,
+    0x0f, 0x84, 0xba, 0x00, 0x00, 0x00, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48,
+    0x81, 0xc4, 0xf8, 0x03, 0x00, 0x00, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0x41, 0x5d, 0xff, 0xe0, 0x66, 0x90,
+    0x49, 0x8b, 0x55, 0x00, 0x48, 0x83, 0x7a, 0x30, 0x00, 0x0f, 0x85, 0x3c, 0xff, 0xff, 0xff, 0x4c,
+    0x39, 0x62, 0x18, 0x0f, 0x85, 0x32, 0xff, 0xff, 0xff, 0x8d, 0x51, 0x01, 0x48, 0x29, 0xd0, 0x4b,
+    0x8d, 0x14, 0xe4, 0x48, 0x89, 0x46, 0x18, 0x48, 0x8d, 0x34, 0xc0, 0x48, 0x8b, 0x43, 0x08, 0x48,
+    0x01, 0xfe, 0x48, 0x8d, 0x04, 0xc0, 0x48, 0x01, 0xc7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xd0, 0x49, 0x8b, 0x55, 0x00, 0x48, 0x8b, 0x43, 0x08, 0x4c, 0x89, 0x2b,
+    0x48, 0x03, 0x42, 0x68, 0x66, 0x48, 0x0f, 0x6e, 0xc0, 0x66, 0x0f, 0x6c, 0xc0, 0x0f, 0x11, 0x43,
+    0x10, 0x48, 0x3d, 0xfe, 0x00, 0x00, 0x00, 0x77, 0x31, 0x48, 0x81, 0xc4, 0xf8, 0x03, 0x00, 0x00,
+    0xb8, 0x01, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0x41, 0x5d, 0xc3, 0x0f, 0x1f, 0x40, 0x00,
+    0x48, 0x89, 0xca, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xd0, 0xe9, 0x45, 0xff, 0xff, 0xff, 0x48, 0xbe, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xff, 0xd0, 0xeb, 0xb4,
+};
+
+static const stencil_hole stencil_holes_OP_TAILCALL[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 14, HOLE_OPERAND, 0, 0 },
+    { 97, HOLE_SYMBOL, 8, 0 },
+    { 116, HOLE_DATA, 0, 200 },
+    { 126, HOLE_SYMBOL, 9, 0 },
+    { 149, HOLE_SYMBOL, 4, 0 },
+    { 200, HOLE_DATA, 0, 248 },
+    { 213, HOLE_SYMBOL, 4, 0 },
+    { 238, HOLE_CONTINUE, 0, 0 },
+    { 315, HOLE_SYMBOL, 13, 0 },
+    { 395, HOLE_SYMBOL, 10, 0 },
+    { 412, HOLE_DATA, 0, 41 },
+    { 425, HOLE_SYMBOL, 4, 0 },
+};
+
+#define STENCIL_OP_TAILCALL_TAIL 0
+#define STENCIL_OP_TAILCALL_HOLES 13
+
+static const uint8_t stencil_code_OP_JMP[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_JMP[] = {
+    { 2, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_JMP_TAIL 2
+#define STENCIL_OP_JMP_HOLES 1
+
+static const uint8_t stencil_code_OP_JIF[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x48, 0x89, 0xfd, 0x53, 0x48,
+    0x89, 0xf3, 0x48, 0x83, 0xec, 0x18, 0x48, 0x89, 0x46, 0x20, 0x48, 0x8b, 0x43, 0x18, 0x48, 0x8b,
+    0x77, 0x18, 0x48, 0x8d, 0x7c, 0x24, 0x07, 0x48, 0x83, 0xe8, 0x01, 0x48, 0x89, 0x43, 0x18, 0x48,
+    0x8d, 0x04, 0xc0, 0x48, 0x01, 0xc6, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xff, 0xd0, 0x80, 0x7c, 0x24, 0x08, 0x00, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x75, 0x19, 0x48,
+    0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83, 0xc4, 0x18, 0x5b, 0x5d, 0xff,
+    0xe0, 0x0f, 0x1f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x48, 0x83, 0xc4, 0x18, 0x5b, 0x5d, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_JIF[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 56, HOLE_SYMBOL, 3, 0 },
+    { 81, HOLE_CONTINUE, 0, 0 },
+    { 106, HOLE_TARGET, 0, 0 },
+};
+
+#define STENCIL_OP_JIF_TAIL 0
+#define STENCIL_OP_JIF_HOLES 4
+
+static const uint8_t stencil_code_OP_GUARDI[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc1, 0xe0, 0x08, 0xc1, 0xf8, 0x08,
+    0x48, 0x98, 0x48, 0x03, 0x46, 0x08, 0x48, 0x8d, 0x04, 0xc0, 0x48, 0x03, 0x47, 0x18, 0x80, 0x38,
+    0x01, 0x74, 0x0d, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0, 0x90,
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_GUARDI[] = {
+    { 2, HOLE_OPERAND, 0, 0 },
+    { 37, HOLE_CONTINUE, 0, 0 },
+    { 50, HOLE_TARGET, 0, 0 },
+};
+
+#define STENCIL_OP_GUARDI_TAIL 0
+#define STENCIL_OP_GUARDI_HOLES 3
+
+static const uint8_t stencil_code_OP_GUARDF[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc1, 0xe0, 0x08, 0xc1, 0xf8, 0x08,
+    0x48, 0x98, 0x48, 0x03, 0x46, 0x08, 0x48, 0x8d, 0x04, 0xc0, 0x48, 0x03, 0x47, 0x18, 0x80, 0x38,
+    0x03, 0x74, 0x0d, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0, 0x90,
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_OP_GUARDF[] = {
+    { 2, HOLE_OPERAND, 0, 0 },
+    { 37, HOLE_CONTINUE, 0, 0 },
+    { 50, HOLE_TARGET, 0, 0 },
+};
+
+#define STENCIL_OP_GUARDF_TAIL 0
+#define STENCIL_OP_GUARDF_HOLES 3
+
+static const uint8_t stencil_code_OP_FORPREP[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x57, 0x41, 0x56, 0x49, 0xbe,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x55, 0x41, 0x54, 0x49, 0x89, 0xfc, 0x55,
+    0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x08, 0x48, 0x83, 0x7e, 0x28, 0x00, 0x4c, 0x8b, 0x4f,
+    0x18, 0x48, 0x89, 0x46, 0x20, 0x0f, 0x84, 0x45, 0x01, 0x00, 0x00, 0x48, 0x8b, 0x46, 0x08, 0x48,
+    0x8d, 0x04, 0xc0, 0x4c, 0x01, 0xc8, 0x48, 0x8b, 0x73, 0x18, 0x44, 0x89, 0xf1, 0x0f, 0xb6, 0xcd,
+    0x4c, 0x8d, 0x54, 0xf6, 0xf7, 0x8d, 0x51, 0x01, 0x48, 0x83, 0xee, 0x02, 0x4f, 0x8b, 0x04, 0x11,
+    0x48, 0x8d, 0x14, 0xd2, 0x48, 0x01, 0xc2, 0x4c, 0x89, 0x02, 0x47, 0x0f, 0xb6, 0x44, 0x11, 0x08,
+    0x44, 0x88, 0x42, 0x08, 0x44, 0x0f, 0xb6, 0x02, 0x4c, 0x8b, 0x7a, 0x01, 0x89, 0xca, 0x4b, 0x8b,
+    0x4c, 0x11, 0xf7, 0x48, 0x89, 0x73, 0x18, 0x48, 0x8d, 0x14, 0xd2, 0x48, 0x01, 0xc2, 0x48, 0x89,
+    0x0a, 0x43, 0x0f, 0xb6, 0x4c, 0x11, 0xff, 0x88, 0x4a, 0x08, 0x41, 0x0f, 0xb6, 0xce, 0x41, 0x81,
+    0xe6, 0x00, 0x00, 0x01, 0x00, 0x80, 0x3a, 0x01, 0x48, 0x8d, 0x0c, 0xc9, 0x4c, 0x8b, 0x6a, 0x01,
+    0x48, 0x8d, 0x2c, 0x08, 0x75, 0x06, 0x41, 0x80, 0xf8, 0x01, 0x74, 0x5c, 0x48, 0xbe, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x8b, 0x45, 0x01, 0x45, 0x85, 0xf6, 0x0f, 0x85, 0x8e, 0x00,
+    0x00, 0x00, 0x4d, 0x85, 0xff, 0x7e, 0x61, 0x49, 0x39, 0xc5, 0x0f, 0x9d, 0xc0, 0x84, 0xc0, 0x75,
+    0x5f, 0x48, 0x83, 0xc4, 0x08, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0x41, 0x5d, 0x41, 0x5e, 0x41, 0x5f, 0xff,
+    0xe0, 0x0f, 0x1f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x80, 0x7d, 0x00, 0x01, 0x75, 0x9e, 0x4d, 0x85,
+    0xff, 0x75, 0xb2, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x89, 0xe7,
+    0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x48, 0x8b, 0x45, 0x01,
+    0x45, 0x85, 0xf6, 0x75, 0x4b, 0x0f, 0x1f, 0x00, 0x49, 0x39, 0xc5, 0x0f, 0x9e, 0xc0, 0xeb, 0x9d,
+    0x48, 0x83, 0xc4, 0x08, 0x48, 0x89, 0xde, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0x41, 0x5d, 0x41, 0x5e, 0x41, 0x5f, 0xff, 0xe0,
+    0x4d, 0x85, 0xff, 0x7e, 0x1b, 0x49, 0x39, 0xc5, 0x0f, 0x9f, 0xc0, 0xe9, 0x6d, 0xff, 0xff, 0xff,
+    0x48, 0x8b, 0x47, 0x10, 0xe9, 0xbd, 0xfe, 0xff, 0xff, 0x0f, 0x1f, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x49, 0x39, 0xc5, 0x0f, 0x9c, 0xc0, 0xe9, 0x52, 0xff, 0xff, 0xff,
+};
+
+static const stencil_hole stencil_holes_OP_FORPREP[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 16, HOLE_OPERAND, 0, 0 },
+    { 190, HOLE_DATA, 0, 57 },
+    { 203, HOLE_SYMBOL, 4, 0 },
+    { 253, HOLE_CONTINUE, 0, 0 },
+    { 293, HOLE_SYMBOL, 4, 0 },
+    { 306, HOLE_DATA, 0, 86 },
+    { 348, HOLE_TARGET, 0, 0 },
+};
+
+#define STENCIL_OP_FORPREP_TAIL 0
+#define STENCIL_OP_FORPREP_HOLES 8
+
+static const uint8_t stencil_code_OP_FORLOOP[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x57, 0x41, 0x56, 0x49, 0xbe,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x55, 0x41, 0x54, 0x49, 0x89, 0xfc, 0x55,
+    0x48, 0x89, 0xf5, 0x53, 0x48, 0x83, 0xec, 0x08, 0x48, 0x83, 0x7e, 0x28, 0x00, 0x48, 0x89, 0x46,
+    0x20, 0x0f, 0x84, 0xc9, 0x00, 0x00, 0x00, 0x48, 0x8b, 0x46, 0x08, 0x48, 0x8d, 0x1c, 0xc0, 0x48,
+    0x03, 0x5f, 0x18, 0x44, 0x89, 0xf0, 0x0f, 0xb6, 0xc4, 0x89, 0xc2, 0x83, 0xc0, 0x01, 0x48, 0x8d,
+    0x04, 0xc0, 0x48, 0x8d, 0x14, 0xd2, 0x4c, 0x8b, 0x6c, 0x03, 0x01, 0x41, 0x0f, 0xb6, 0xc6, 0x4c,
+    0x8b, 0x7c, 0x13, 0x01, 0x48, 0x8d, 0x04, 0xc0, 0x48, 0x01, 0xc3, 0x80, 0x3b, 0x01, 0x74, 0x19,
+    0x48, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0, 0x4c, 0x89, 0xe8, 0x48, 0x03, 0x43, 0x01,
+    0x48, 0x89, 0x43, 0x01, 0x70, 0x38, 0x41, 0xf7, 0xc6, 0x00, 0x00, 0x01, 0x00, 0x75, 0x51, 0x4d,
+    0x85, 0xed, 0x7e, 0x7c, 0x49, 0x39, 0xc7, 0x0f, 0x9d, 0xc0, 0x84, 0xc0, 0x74, 0x20, 0x48, 0x83,
+    0xc4, 0x08, 0x48, 0x89, 0xee, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0x41, 0x5d, 0x41, 0x5e, 0x41, 0x5f, 0xff, 0xe0, 0x48, 0x83,
+    0xc4, 0x08, 0x48, 0x89, 0xee, 0x4c, 0x89, 0xe7, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x5b, 0x5d, 0x41, 0x5c, 0x41, 0x5d, 0x41, 0x5e, 0x41, 0x5f, 0xff, 0xe0, 0x66, 0x90,
+    0x4d, 0x85, 0xed, 0x7e, 0x1b, 0x49, 0x39, 0xc7, 0x0f, 0x9f, 0xc0, 0xeb, 0xad, 0x0f, 0x1f, 0x00,
+    0x48, 0x8b, 0x5f, 0x10, 0xe9, 0x3a, 0xff, 0xff, 0xff, 0x0f, 0x1f, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x49, 0x39, 0xc7, 0x0f, 0x9c, 0xc0, 0xeb, 0x92, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x49, 0x39, 0xc7, 0x0f, 0x9e, 0xc0, 0xeb, 0x82,
+};
+
+static const stencil_hole stencil_holes_OP_FORLOOP[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 16, HOLE_OPERAND, 0, 0 },
+    { 114, HOLE_DATA, 0, 296 },
+    { 127, HOLE_SYMBOL, 4, 0 },
+    { 186, HOLE_TARGET, 0, 0 },
+    { 218, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_OP_FORLOOP_TAIL 0
+#define STENCIL_OP_FORLOOP_HOLES 6
+
+static const uint8_t stencil_code_STENCIL_ENTER[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x39, 0x46, 0x20, 0x74, 0x10,
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0, 0x0f, 0x1f, 0x40, 0x00,
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_STENCIL_ENTER[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 18, HOLE_CONTINUE, 0, 0 },
+    { 34, HOLE_TARGET, 0, 0 },
+};
+
+#define STENCIL_STENCIL_ENTER_TAIL 0
+#define STENCIL_STENCIL_ENTER_HOLES 3
+
+static const uint8_t stencil_code_STENCIL_STEP[] = {
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x48, 0x89, 0xfd, 0x48, 0xba,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x53, 0x48, 0x89, 0xf3, 0x48, 0x83, 0xec, 0x08,
+    0x48, 0x89, 0x46, 0x20, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xd0,
+    0x48, 0x83, 0xc4, 0x08, 0x48, 0x89, 0xde, 0x48, 0x89, 0xef, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x5b, 0x5d, 0xff, 0xe0,
+};
+
+static const stencil_hole stencil_holes_STENCIL_STEP[] = {
+    { 2, HOLE_PC, 0, 0 },
+    { 16, HOLE_OPERAND, 0, 0 },
+    { 38, HOLE_SYMBOL, 14, 0 },
+    { 60, HOLE_CONTINUE, 0, 0 },
+};
+
+#define STENCIL_STENCIL_STEP_TAIL 2
+#define STENCIL_STENCIL_STEP_HOLES 4
+
+static const uint8_t stencil_code_STENCIL_END[] = {
+    0x31, 0xc0, 0xc3,
+};
+
+static const stencil_hole stencil_holes_STENCIL_END[] = {
+    { 0 },
+};
+
+#define STENCIL_STENCIL_END_TAIL 0
+#define STENCIL_STENCIL_END_HOLES 0
+
+static const stencil stencils[STENCIL_COUNT] = {
+    [OP_ADD] = { stencil_code_OP_ADD, sizeof(stencil_code_OP_ADD), STENCIL_OP_ADD_TAIL, stencil_holes_OP_ADD, STENCIL_OP_ADD_HOLES },
+    [OP_SUB] = { stencil_code_OP_SUB, sizeof(stencil_code_OP_SUB), STENCIL_OP_SUB_TAIL, stencil_holes_OP_SUB, STENCIL_OP_SUB_HOLES },
+    [OP_MUL] = { stencil_code_OP_MUL, sizeof(stencil_code_OP_MUL), STENCIL_OP_MUL_TAIL, stencil_holes_OP_MUL, STENCIL_OP_MUL_HOLES },
+    [OP_EQ] = { stencil_code_OP_EQ, sizeof(stencil_code_OP_EQ), STENCIL_OP_EQ_TAIL, stencil_holes_OP_EQ, STENCIL_OP_EQ_HOLES },
+    [OP_NE] = { stencil_code_OP_NE, sizeof(stencil_code_OP_NE), STENCIL_OP_NE_TAIL, stencil_holes_OP_NE, STENCIL_OP_NE_HOLES },
+    [OP_LT] = { stencil_code_OP_LT, sizeof(stencil_code_OP_LT), STENCIL_OP_LT_TAIL, stencil_holes_OP_LT, STENCIL_OP_LT_HOLES },
+    [OP_LE] = { stencil_code_OP_LE, sizeof(stencil_code_OP_LE), STENCIL_OP_LE_TAIL, stencil_holes_OP_LE, STENCIL_OP_LE_HOLES },
+    [OP_GT] = { stencil_code_OP_GT, sizeof(stencil_code_OP_GT), STENCIL_OP_GT_TAIL, stencil_holes_OP_GT, STENCIL_OP_GT_HOLES },
+    [OP_GE] = { stencil_code_OP_GE, sizeof(stencil_code_OP_GE), STENCIL_OP_GE_TAIL, stencil_holes_OP_GE, STENCIL_OP_GE_HOLES },
+    [OP_DIV] = { stencil_code_OP_DIV, sizeof(stencil_code_OP_DIV), STENCIL_OP_DIV_TAIL, stencil_holes_OP_DIV, STENCIL_OP_DIV_HOLES },
+    [OP_MOD] = { stencil_code_OP_MOD, sizeof(stencil_code_OP_MOD), STENCIL_OP_MOD_TAIL, stencil_holes_OP_MOD, STENCIL_OP_MOD_HOLES },
+    [OP_AND] = { stencil_code_OP_AND, sizeof(stencil_code_OP_AND), STENCIL_OP_AND_TAIL, stencil_holes_OP_AND, STENCIL_OP_AND_HOLES },
+    [OP_OR] = { stencil_code_OP_OR, sizeof(stencil_code_OP_OR), STENCIL_OP_OR_TAIL, stencil_holes_OP_OR, STENCIL_OP_OR_HOLES },
+    [OP_NEG] = { stencil_code_OP_NEG, sizeof(stencil_code_OP_NEG), STENCIL_OP_NEG_TAIL, stencil_holes_OP_NEG, STENCIL_OP_NEG_HOLES },
+    [OP_NOT] = { stencil_code_OP_NOT, sizeof(stencil_code_OP_NOT), STENCIL_OP_NOT_TAIL, stencil_holes_OP_NOT, STENCIL_OP_NOT_HOLES },
+    [OP_ADDI] = { stencil_code_OP_ADDI, sizeof(stencil_code_OP_ADDI), STENCIL_OP_ADDI_TAIL, stencil_holes_OP_ADDI, STENCIL_OP_ADDI_HOLES },
+    [OP_SUBI] = { stencil_code_OP_SUBI, sizeof(stencil_code_OP_SUBI), STENCIL_OP_SUBI_TAIL, stencil_holes_OP_SUBI, STENCIL_OP_SUBI_HOLES },
+    [OP_MULI] = { stencil_code_OP_MULI, sizeof(stencil_code_OP_MULI), STENCIL_OP_MULI_TAIL, stencil_holes_OP_MULI, STENCIL_OP_MULI_HOLES },
+    [OP_ADDF] = { stencil_code_OP_ADDF, sizeof(stencil_code_OP_ADDF), STENCIL_OP_ADDF_TAIL, stencil_holes_OP_ADDF, STENCIL_OP_ADDF_HOLES },
+    [OP_SUBF] = { stencil_code_OP_SUBF, sizeof(stencil_code_OP_SUBF), STENCIL_OP_SUBF_TAIL, stencil_holes_OP_SUBF, STENCIL_OP_SUBF_HOLES },
+    [OP_MULF] = { stencil_code_OP_MULF, sizeof(stencil_code_OP_MULF), STENCIL_OP_MULF_TAIL, stencil_holes_OP_MULF, STENCIL_OP_MULF_HOLES },
+    [OP_DIVI] = { stencil_code_OP_DIVI, sizeof(stencil_code_OP_DIVI), STENCIL_OP_DIVI_TAIL, stencil_holes_OP_DIVI, STENCIL_OP_DIVI_HOLES },
+    [OP_MODI] = { stencil_code_OP_MODI, sizeof(stencil_code_OP_MODI), STENCIL_OP_MODI_TAIL, stencil_holes_OP_MODI, STENCIL_OP_MODI_HOLES },
+    [OP_DIVF] = { stencil_code_OP_DIVF, sizeof(stencil_code_OP_DIVF), STENCIL_OP_DIVF_TAIL, stencil_holes_OP_DIVF, STENCIL_OP_DIVF_HOLES },
+    [OP_EQI] = { stencil_code_OP_EQI, sizeof(stencil_code_OP_EQI), STENCIL_OP_EQI_TAIL, stencil_holes_OP_EQI, STENCIL_OP_EQI_HOLES },
+    [OP_NEI] = { stencil_code_OP_NEI, sizeof(stencil_code_OP_NEI), STENCIL_OP_NEI_TAIL, stencil_holes_OP_NEI, STENCIL_OP_NEI_HOLES },
+    [OP_LTI] = { stencil_code_OP_LTI, sizeof(stencil_code_OP_LTI), STENCIL_OP_LTI_TAIL, stencil_holes_OP_LTI, STENCIL_OP_LTI_HOLES },
+    [OP_LEI] = { stencil_code_OP_LEI, sizeof(stencil_code_OP_LEI), STENCIL_OP_LEI_TAIL, stencil_holes_OP_LEI, STENCIL_OP_LEI_HOLES },
+    [OP_GTI] = { stencil_code_OP_GTI, sizeof(stencil_code_OP_GTI), STENCIL_OP_GTI_TAIL, stencil_holes_OP_GTI, STENCIL_OP_GTI_HOLES },
+    [OP_GEI] = { stencil_code_OP_GEI, sizeof(stencil_code_OP_GEI), STENCIL_OP_GEI_TAIL, stencil_holes_OP_GEI, STENCIL_OP_GEI_HOLES },
+    [OP_LTF] = { stencil_code_OP_LTF, sizeof(stencil_code_OP_LTF), STENCIL_OP_LTF_TAIL, stencil_holes_OP_LTF, STENCIL_OP_LTF_HOLES },
+    [OP_LEF] = { stencil_code_OP_LEF, sizeof(stencil_code_OP_LEF), STENCIL_OP_LEF_TAIL, stencil_holes_OP_LEF, STENCIL_OP_LEF_HOLES },
+    [OP_GTF] = { stencil_code_OP_GTF, sizeof(stencil_code_OP_GTF), STENCIL_OP_GTF_TAIL, stencil_holes_OP_GTF, STENCIL_OP_GTF_HOLES },
+    [OP_GEF] = { stencil_code_OP_GEF, sizeof(stencil_code_OP_GEF), STENCIL_OP_GEF_TAIL, stencil_holes_OP_GEF, STENCIL_OP_GEF_HOLES },
+    [OP_POP] = { stencil_code_OP_POP, sizeof(stencil_code_OP_POP), STENCIL_OP_POP_TAIL, stencil_holes_OP_POP, STENCIL_OP_POP_HOLES },
+    [OP_TNEW] = { stencil_code_OP_TNEW, sizeof(stencil_code_OP_TNEW), STENCIL_OP_TNEW_TAIL, stencil_holes_OP_TNEW, STENCIL_OP_TNEW_HOLES },
+    [OP_TPUT] = { stencil_code_OP_TPUT, sizeof(stencil_code_OP_TPUT), STENCIL_OP_TPUT_TAIL, stencil_holes_OP_TPUT, STENCIL_OP_TPUT_HOLES },
+    [OP_TGET] = { stencil_code_OP_TGET, sizeof(stencil_code_OP_TGET), STENCIL_OP_TGET_TAIL, stencil_holes_OP_TGET, STENCIL_OP_TGET_HOLES },
+    [OP_NOP] = { stencil_code_OP_NOP, sizeof(stencil_code_OP_NOP), STENCIL_OP_NOP_TAIL, stencil_holes_OP_NOP, STENCIL_OP_NOP_HOLES },
+    [OP_PUSHK] = { stencil_code_OP_PUSHK, sizeof(stencil_code_OP_PUSHK), STENCIL_OP_PUSHK_TAIL, stencil_holes_OP_PUSHK, STENCIL_OP_PUSHK_HOLES },
+    [OP_LOADG] = { stencil_code_OP_LOADG, sizeof(stencil_code_OP_LOADG), STENCIL_OP_LOADG_TAIL, stencil_holes_OP_LOADG, STENCIL_OP_LOADG_HOLES },
+    [OP_LOADL] = { stencil_code_OP_LOADL, sizeof(stencil_code_OP_LOADL), STENCIL_OP_LOADL_TAIL, stencil_holes_OP_LOADL, STENCIL_OP_LOADL_HOLES },
+    [OP_LOADC] = { stencil_code_OP_LOADC, sizeof(stencil_code_OP_LOADC), STENCIL_OP_LOADC_TAIL, stencil_holes_OP_LOADC, STENCIL_OP_LOADC_HOLES },
+    [OP_DUP] = { stencil_code_OP_DUP, sizeof(stencil_code_OP_DUP), STENCIL_OP_DUP_TAIL, stencil_holes_OP_DUP, STENCIL_OP_DUP_HOLES },
+    [OP_STORG] = { stencil_code_OP_STORG, sizeof(stencil_code_OP_STORG), STENCIL_OP_STORG_TAIL, stencil_holes_OP_STORG, STENCIL_OP_STORG_HOLES },
+    [OP_STORL] = { stencil_code_OP_STORL, sizeof(stencil_code_OP_STORL), STENCIL_OP_STORL_TAIL, stencil_holes_OP_STORL, STENCIL_OP_STORL_HOLES },
+    [OP_STORC] = { stencil_code_OP_STORC, sizeof(stencil_code_OP_STORC), STENCIL_OP_STORC_TAIL, stencil_holes_OP_STORC, STENCIL_OP_STORC_HOLES },
+    [OP_CALL] = { stencil_code_OP_CALL, sizeof(stencil_code_OP_CALL), STENCIL_OP_CALL_TAIL, stencil_holes_OP_CALL, STENCIL_OP_CALL_HOLES },
+    [OP_CLOSE] = { stencil_code_OP_CLOSE, sizeof(stencil_code_OP_CLOSE), STENCIL_OP_CLOSE_TAIL, stencil_holes_OP_CLOSE, STENCIL_OP_CLOSE_HOLES },
+    [OP_RET] = { stencil_code_OP_RET, sizeof(stencil_code_OP_RET), STENCIL_OP_RET_TAIL, stencil_holes_OP_RET, STENCIL_OP_RET_HOLES },
+    [OP_TAILCALL] = { stencil_code_OP_TAILCALL, sizeof(stencil_code_OP_TAILCALL), STENCIL_OP_TAILCALL_TAIL, stencil_holes_OP_TAILCALL, STENCIL_OP_TAILCALL_HOLES },
+    [OP_JMP] = { stencil_code_OP_JMP, sizeof(stencil_code_OP_JMP), STENCIL_OP_JMP_TAIL, stencil_holes_OP_JMP, STENCIL_OP_JMP_HOLES },
+    [OP_JIF] = { stencil_code_OP_JIF, sizeof(stencil_code_OP_JIF), STENCIL_OP_JIF_TAIL, stencil_holes_OP_JIF, STENCIL_OP_JIF_HOLES },
+    [OP_GUARDI] = { stencil_code_OP_GUARDI, sizeof(stencil_code_OP_GUARDI), STENCIL_OP_GUARDI_TAIL, stencil_holes_OP_GUARDI, STENCIL_OP_GUARDI_HOLES },
+    [OP_GUARDF] = { stencil_code_OP_GUARDF, sizeof(stencil_code_OP_GUARDF), STENCIL_OP_GUARDF_TAIL, stencil_holes_OP_GUARDF, STENCIL_OP_GUARDF_HOLES },
+    [OP_FORPREP] = { stencil_code_OP_FORPREP, sizeof(stencil_code_OP_FORPREP), STENCIL_OP_FORPREP_TAIL, stencil_holes_OP_FORPREP, STENCIL_OP_FORPREP_HOLES },
+    [OP_FORLOOP] = { stencil_code_OP_FORLOOP, sizeof(stencil_code_OP_FORLOOP), STENCIL_OP_FORLOOP_TAIL, stencil_holes_OP_FORLOOP, STENCIL_OP_FORLOOP_HOLES },
+    [STENCIL_ENTER] = { stencil_code_STENCIL_ENTER, sizeof(stencil_code_STENCIL_ENTER), STENCIL_STENCIL_ENTER_TAIL, stencil_holes_STENCIL_ENTER, STENCIL_STENCIL_ENTER_HOLES },
+    [STENCIL_STEP] = { stencil_code_STENCIL_STEP, sizeof(stencil_code_STENCIL_STEP), STENCIL_STENCIL_STEP_TAIL, stencil_holes_STENCIL_STEP, STENCIL_STENCIL_STEP_HOLES },
+    [STENCIL_END] = { stencil_code_STENCIL_END, sizeof(stencil_code_STENCIL_END), STENCIL_STENCIL_END_TAIL, stencil_holes_STENCIL_END, STENCIL_STENCIL_END_HOLES },
+};
+
+static void* const stencil_symbols[15] = {
+    (void*) &apply_vm_op,
+    (void*) &vBool,
+    (void*) &vNegate,
+    (void*) &native_bool_cast,
+    (void*) &runtimeerr,
+    (void*) &vTable,
+    (void*) &vTablePut,
+    (void*) &vTableGet,
+    (void*) &value_to_str,
+    (void*) &sprintf,
+    (void*) &run_program,
+    (void*) &malloc,
+    (void*) &vCode,
+    (void*) &memmove,
+    (void*) &decode_execute,
+};
+
+static const uint8_t stencil_data[329] __attribute__((aligned(64))) = {
+    0x5a, 0x65, 0x72, 0x6f, 0x20, 0x64, 0x69, 0x76, 0x69, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x65, 0x72,
+    0x72, 0x6f, 0x72, 0x21, 0x00, 0x5a, 0x65, 0x72, 0x6f, 0x20, 0x6d, 0x6f, 0x64, 0x75, 0x6c, 0x75,
+    0x73, 0x20, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x21, 0x00, 0x53, 0x74, 0x61, 0x63, 0x6b, 0x20, 0x6f,
+    0x76, 0x65, 0x72, 0x66, 0x6c, 0x6f, 0x77, 0x21, 0x00, 0x4c, 0x6f, 0x6f, 0x70, 0x20, 0x72, 0x61,
+    0x6e, 0x67, 0x65, 0x20, 0x6d, 0x75, 0x73, 0x74, 0x20, 0x62, 0x65, 0x20, 0x69, 0x6e, 0x74, 0x65,
+    0x67, 0x65, 0x72, 0x73, 0x21, 0x00, 0x4c, 0x6f, 0x6f, 0x70, 0x20, 0x73, 0x74, 0x65, 0x70, 0x20,
+    0x63, 0x61, 0x6e, 0x6e, 0x6f, 0x74, 0x20, 0x62, 0x65, 0x20, 0x7a, 0x65, 0x72, 0x6f, 0x21, 0x00,
+    0x43, 0x61, 0x6e, 0x6e, 0x6f, 0x74, 0x20, 0x61, 0x64, 0x64, 0x20, 0x65, 0x6c, 0x65, 0x6d, 0x65,
+    0x6e, 0x74, 0x20, 0x74, 0x6f, 0x20, 0x6e, 0x6f, 0x6e, 0x2d, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x20,
+    0x6f, 0x62, 0x6a, 0x65, 0x63, 0x74, 0x00, 0x00, 0x43, 0x61, 0x6e, 0x6e, 0x6f, 0x74, 0x20, 0x72,
+    0x65, 0x74, 0x72, 0x69, 0x65, 0x76, 0x65, 0x20, 0x65, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x20,
+    0x66, 0x72, 0x6f, 0x6d, 0x20, 0x6e, 0x6f, 0x6e, 0x2d, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x20, 0x6f,
+    0x62, 0x6a, 0x65, 0x63, 0x74, 0x00, 0x00, 0x00, 0x43, 0x61, 0x6e, 0x6e, 0x6f, 0x74, 0x20, 0x63,
+    0x61, 0x6c, 0x6c, 0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x20, 0x25, 0x73, 0x2c, 0x20, 0x65, 0x78,
+    0x70, 0x65, 0x63, 0x74, 0x65, 0x64, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20,
+    0x74, 0x79, 0x70, 0x65, 0x21, 0x00, 0x00, 0x00, 0x49, 0x6e, 0x76, 0x61, 0x6c, 0x69, 0x64, 0x20,
+    0x6e, 0x75, 0x6d, 0x62, 0x65, 0x72, 0x20, 0x6f, 0x66, 0x20, 0x61, 0x72, 0x67, 0x75, 0x6d, 0x65,
+    0x6e, 0x74, 0x73, 0x20, 0x70, 0x61, 0x73, 0x73, 0x65, 0x64, 0x20, 0x74, 0x6f, 0x20, 0x66, 0x75,
+    0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x21, 0x00, 0x4c, 0x6f, 0x6f, 0x70, 0x20, 0x63, 0x6f, 0x75,
+    0x6e, 0x74, 0x65, 0x72, 0x20, 0x6d, 0x75, 0x73, 0x74, 0x20, 0x62, 0x65, 0x20, 0x61, 0x6e, 0x20,
+    0x69, 0x6e, 0x74, 0x65, 0x67, 0x65, 0x72, 0x21, 0x00,
+};
+
+#endif
@@ -0,0 +1,164 @@
+#include <time.h>
+#include "tier.h"
+#include "vm.h"
+
+tier_config tiers = {
+    .call_threshold = TIER_CALL_THRESHOLD,
+    .trace_threshold = TIER_TRACE_THRESHOLD,
+    .osr_threshold = TIER_OSR_THRESHOLD,
+    .budget = TIER_COMPILE_BUDGET,
+    .stats = false,
+};
+
+typedef struct tier_entry {
+    program* p;
+    tier_event event;
+    size_t pc;
+    size_t bytes;
+    double time;  // milliseconds since the first transition
+    double spent; // milliseconds of compilation
+} tier_entry;
+
+static const char* tier_event_names[] = {
+    "native",
+    "trace",
+    "osr",
+    "discard",
+    "abort",
+    "failed",
+};
+
+static struct {
+    tier_entry* entries;
+    size_t size;
+    size_t capacity;
+    size_t counts[TIER_FAILED + 1];
+    size_t bytes;
+    double spent;
+    double start;
+    boolean exhausted;
+} history;
+
+// parses the value of "--name=N"
+static boolean tier_value(const char* arg, const char* name, uint32_t* value)
+{
+    size_t length = strlen(name);
+
+    if (strncmp(arg, name, length) != 0 || arg[length] != '=') {
+        return false;
+    }
+
+    char* end;
+    long n = strtol(arg + length + 1, &end, 10);
+
+    if (*end != '\0' || end == arg + length + 1 || n < 0 || n > UINT32_MAX) {
+        failure("Tiering options take a non-negative integer!");
+    }
+
+    *value = n;
+    return true;
+}
+
+boolean tier_option(const char* arg)
+{
+    if (streq(arg, "--jit-stats")) {
+        tiers.stats = true;
+        return true;
+    }
+
+    return tier_value(arg, "--jit-call-threshold", &tiers.call_threshold) ||
+        tier_value(arg, "--jit-trace-threshold", &tiers.trace_threshold) ||
+        tier_value(arg, "--jit-osr-threshold", &tiers.osr_threshold) ||
+        tier_value(arg, "--jit-budget", &tiers.budget);
+}
+
+double tier_clock()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+boolean tier_budget_left()
+{
+    if (history.spent < tiers.budget) {
+        return true;
+    }
+
+    history.exhausted = true;
+    return false;
+}
+
+void tier_record(program* p, tier_event event, size_t pc, size_t bytes, double start)
+{
+    double now = tier_clock();
+    double spent = event == TIER_NATIVE || event == TIER_TRACE || event == TIER_FAILED ? now - start : 0;
+
+    history.counts[event]++;
+    history.bytes += bytes;
+    history.spent += spent;
+
+    // aborted recordings are only counted, a loop may be recorded several times
+    if (!tiers.stats || event == TIER_ABORT) {
+        return;
+    }
+
+    if (history.size == 0) {
+        history.start = now;
+    }
+
+    if (history.size == history.capacity) {
+        history.capacity = history.capacity == 0 ? 16 : 2 * history.capacity;
+        history.entries = realloc(history.entries, sizeof(tier_entry) * history.capacity);
+    }
+
+    history.entries[history.size++] = (tier_entry) {
+        .p = p,
+        .event = event,
+        .pc = pc,
+        .bytes = bytes,
+        .time = now - history.start,
+        .spent = spent,
+    };
+}
+
+void tier_report()
+{
+    if (!tiers.stats) {
+        return;
+    }
+
+    fprintf(stderr, "Tier transitions:\n");
+
+    for (size_t i = 0; i < history.size; i++)
+    {
+        tier_entry* e = &history.entries[i];
+        const lxpos* pos = getaddresspos(e->p, e->pc);
+
+        // the first line of a function may start past its first instruction
+        if (pos == NULL && e->p->line_address_table.size > 0) {
+            pos = e->p->line_address_table.values[0];
+        }
+
+        fprintf(stderr, "  %10.3f ms  %-8s %s:%i", e->time, tier_event_names[e->event],
+            pos != NULL ? pos->origin : "?", pos != NULL ? pos->line_pos + 1 : 0);
+
+        if (e->event == TIER_NATIVE && e->p->prev == NULL) {
+            fprintf(stderr, "  global code, %zu bytes in %.3f ms", e->bytes, e->spent);
+        } else if (e->event == TIER_NATIVE) {
+            fprintf(stderr, "  function after %zu calls, %zu bytes in %.3f ms", e->p->calls, e->bytes, e->spent);
+        } else if (e->event == TIER_TRACE) {
+            fprintf(stderr, "  loop at %zu, %zu bytes in %.3f ms", e->pc, e->bytes, e->spent);
+        } else if (e->event != TIER_FAILED) {
+            fprintf(stderr, "  loop at %zu", e->pc);
+        }
+
+        fprintf(stderr, "\n");
+    }
+
+    fprintf(stderr, "Compiled %zu functions and %zu traces into %zu bytes in %.3f ms of %u ms budget%s\n",
+        history.counts[TIER_NATIVE], history.counts[TIER_TRACE], history.bytes, history.spent, tiers.budget,
+        history.exhausted ? " (exhausted)" : "");
+    fprintf(stderr, "%zu frames replaced on stack, %zu traces discarded, %zu recordings aborted, %zu programs not compiled\n",
+        history.counts[TIER_OSR], history.counts[TIER_DISCARD], history.counts[TIER_ABORT], history.counts[TIER_FAILED]);
+}
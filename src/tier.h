@@ -0,0 +1,95 @@
+#ifndef HE_TIER_HEADER
+#define HE_TIER_HEADER
+
+#include "common.h"
+#include "compiler.h"
+
+// calls after which a function is compiled to native code
+#define TIER_CALL_THRESHOLD 64
+
+// backward jumps to a loop header after which its trace is recorded
+#define TIER_TRACE_THRESHOLD 32
+
+// backward jumps to the header of a loop the tracing JIT gave up on, after which the frame is compiled
+#define TIER_OSR_THRESHOLD 64
+
+// milliseconds spent compiling native code after which nothing more is compiled
+#define TIER_COMPILE_BUDGET 1000
+
+/*
+ * Code is promoted through tiers as it gets hot:
+ *  interpreted  bytecode optimized and type-specialized ahead of time
+ *  traced       hot loops recorded into type-specialized native traces
+ *  native       whole functions compiled by the baseline JIT, entered
+ *               when called or mid-loop through on-stack replacement
+ * Promotions are driven by the call counter of each program and the
+ * backward jump counter of each loop header. Short scripts are best
+ * served by high thresholds and a small budget, long-running ones by
+ * compiling early.
+ */
+
+typedef enum tier_event {
+    TIER_NATIVE,  // function compiled by the baseline JIT
+    TIER_TRACE,   // loop trace compiled
+    TIER_OSR,     // interpreted frame continued in native code
+    TIER_DISCARD, // trace discarded after its type guards kept failing
+    TIER_ABORT,   // trace recording abandoned
+    TIER_FAILED,  // code the JIT cannot compile
+} tier_event;
+
+typedef struct tier_config {
+    uint32_t call_threshold;  // 0 never compiles functions on call
+    uint32_t trace_threshold; // 0 never traces loops
+    uint32_t osr_threshold;   // 0 never replaces running frames
+    uint32_t budget;          // milliseconds, 0 compiles nothing
+    boolean stats;            // dump tier transitions on exit
+} tier_config;
+
+/*
+ * Thresholds and budget selected on the command line.
+ */
+extern tier_config tiers;
+
+/**
+ * @brief Applies a tiering option from the command line:
+ *      --jit-stats, --jit-call-threshold=N, --jit-trace-threshold=N,
+ *      --jit-osr-threshold=N or --jit-budget=MS.
+ *
+ * @param arg Command line argument
+ * @return True if the argument is a tiering option
+ */
+boolean tier_option(const char* arg);
+
+/**
+ * @brief Monotonic clock used to time compilation.
+ *
+ * @return Milliseconds since an arbitrary point
+ */
+double tier_clock();
+
+/**
+ * @brief Checks the compile budget before compiling native code.
+ *
+ * @return True if compiling is still allowed
+ */
+boolean tier_budget_left();
+
+/**
+ * @brief Records a tier transition of a program. Compilations are
+ *      charged to the compile budget.
+ *
+ * @param p Reference to program
+ * @param event Transition
+ * @param pc Loop header of traces and replaced frames, 0 otherwise
+ * @param bytes Native code size of compilations
+ * @param start Clock reading when compilation began, ignored by other events
+ */
+void tier_record(program* p, tier_event event, size_t pc, size_t bytes, double start);
+
+/**
+ * @brief Prints the recorded tier transitions and compile totals to
+ *      standard error, if enabled with --jit-stats.
+ */
+void tier_report();
+
+#endif
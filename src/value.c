@@ -12,44 +12,6 @@ const char* vm_type_strings[] = {
     "Table",
 };
 
-Value value_from_node(astnode* node)
-{
-    Value v;
-    
-    switch (node->type)
-    {
-        case AST_INTEGER:
-            v.type = VM_INT;
-            v.value.to_int = atoi(node->value);
-            break;
-        
-        case AST_FLOAT:
-            v.type = VM_FLOAT;
-            v.value.to_float = atof(node->value);
-            break;
-        
-        case AST_BOOL:
-            v.type = VM_BOOL;
-            v.value.to_bool = streq(node->value, "true");
-            break;
-        
-        case AST_STRING:
-            v.type = VM_STRING;
-            v.value.to_str = node->value;
-            break;
-        
-        case AST_NULL:
-            v.type = VM_NULL;
-            v.value.to_code = NULL;
-            break;
-
-        // TODO: coerce floats, strings, booleans, nulls
-        default: failure("Failed to coerce node to value!");
-    }
-
-    return v;
-}
-
 const char* value_to_str(Value* v)
 {
     char* buf = (char*) malloc(sizeof(char) * 64);
@@ -46,14 +46,6 @@ typedef struct Value {
     } value;
 } __attribute__((packed)) Value;
 
-/**
- * @brief Coerces abstract syntax node into Value object.
- * 
- * @param node Abstract syntax node
- * @return Value
- */
-Value value_from_node(astnode* node);
-
 /**
  * @brief Represents VM Value object as a string.
  * 
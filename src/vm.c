@@ -1,4 +1,9 @@
 #include "vm.h"
+#include "ops.h"
+#include "jit.h"
+#include "regvm.h"
+
+size_t vm_dispatched = 0;
 
 void run_program(virtual_machine* vm, call_info* prev, code_object* code)
 {
@@ -25,24 +30,47 @@ void run_program(virtual_machine* vm, call_info* prev, code_object* code)
         vm->stack[call->prev->tp++] = vm->stack[--call->tp];
     }
 
-    while (call->pc < code->p->length)
+    // hot functions run as native code, the others on the register VM when it is enabled
+    boolean returned = jit_execute(vm, call) || reg_execute(vm, call);
+
+    // counted locally so the global is only written once per frame
+    size_t dispatched = 0;
+
+    // tail calls replace the program of the frame
+    while (!returned && call->pc < call->program->p->length)
     {
-        decode_execute(vm, call, code->p->code[call->pc]);
-        
-        if (code->p->code[call->pc].stackop.op == OP_RET) {
+        instruction i = call->program->p->code[call->pc];
+        size_t pc = call->pc;
+        decode_execute(vm, call, i);
+        dispatched++;
+
+        // jumps move pc, so the executed instruction is checked
+        if (i.stackop.op == OP_RET) {
             break;
         }
         
         call->pc++;
+
+        // the callee of a tail call starts at its first instruction
+        if (i.stackop.op == OP_TAILCALL && call->pc == 0) {
+            returned = jit_execute(vm, call) || reg_execute(vm, call);
+        }
+
+        // hot loops are traced from the target of their backward jump, or compiled whole if they cannot be
+        if (trace_frame != NULL) {
+            trace_record(vm, call, i, pc);
+        } else if (jit_enabled && call->pc <= pc && (i.stackop.op == OP_JMP || i.stackop.op == OP_FORLOOP)) {
+            trace_enter(vm, call);
+            returned = jit_osr(vm, call);
+        }
     }
 
+    vm_dispatched += dispatched;
     vm->ci--;
 }
 
 void decode_execute(virtual_machine* vm, call_info* call, instruction i)
 {
-    Value v0, v1;
-
     switch (i.stackop.op)
     {
         case OP_NOP: break;
@@ -59,88 +87,33 @@ void decode_execute(virtual_machine* vm, call_info* call, instruction i)
         case OP_GE:
         case OP_EQ:
         case OP_NE:
-            v1 = vm->stack[--call->tp];
-            v0 = vm->stack[--call->tp];
-            vm->stack[call->tp++] = apply_vm_op(i.stackop.op, v0, v1);
-            break;
-
-        case OP_NEG:
-            vm->stack[call->tp - 1] = vNegate(vm->stack[call->tp - 1]);
-            break;
-
-        case OP_NOT:
-            vm->stack[call->tp - 1] = vBool(!native_bool_cast(&vm->stack[call->tp - 1]).value.to_bool);
-            break;
-
-        case OP_PUSHK:
-            vm->stack[call->tp++] = call->program->p->constants[i.ux.ux];
-            
-            if (call->tp >= MAX_STACK_SIZE) runtimeerr(vm, "Stack overflow!");
-            break;
-
-        case OP_STORG:
-            vm->heap[i.sx.sx] = vm->stack[--call->tp];
-
-            if (i.sx.sx >= MAX_HEAP_SIZE) runtimeerr(vm, "Stack overflow!");
-            break;
-
-        case OP_LOADG:
-            vm->stack[call->tp++] = vm->heap[i.sx.sx];
-
-            if (call->tp >= MAX_STACK_SIZE) runtimeerr(vm, "Stack overflow!");
-            break;
-        
-        case OP_STORL:
-            vm->stack[call->bp + i.sx.sx] = vm->stack[--call->tp];
-
-            if (call->bp + i.sx.sx >= MAX_STACK_SIZE) runtimeerr(vm, "Stack overflow!");
-            break;
-        
-        case OP_LOADL:
-            vm->stack[call->tp++] = vm->stack[call->bp + i.sx.sx];
-
-            if (call->tp >= MAX_STACK_SIZE) runtimeerr(vm, "Stack overflow!");
-            break;
-        
-        case OP_STORC:
-            call->program->closure[i.ux.ux] = vm->stack[--call->tp];
+            op_binary(vm, call, i.stackop.op);
             break;
 
-        case OP_LOADC:
-            vm->stack[call->tp++] = call->program->closure[i.ux.ux];
+        case OP_NEG: op_neg(vm, call); break;
+        case OP_NOT: op_not(vm, call); break;
 
-            if (call->tp >= MAX_STACK_SIZE) runtimeerr(vm, "Stack overflow!");
-            break;
+        case OP_PUSHK: op_push(vm, call, call->program->p->constants[i.ux.ux]); break;
+        case OP_STORG: op_storg(vm, call, i.sx.sx); break;
+        case OP_LOADG: op_push(vm, call, vm->heap[i.sx.sx]); break;
+        case OP_STORL: op_storl(vm, call, i.sx.sx); break;
+        case OP_LOADL: op_push(vm, call, vm->stack[call->bp + i.sx.sx]); break;
+        case OP_STORC: op_storc(vm, call, i.ux.ux); break;
+        case OP_LOADC: op_push(vm, call, call->program->closure[i.ux.ux]); break;
 
-        case OP_CALL:
-            if (vm->stack[--call->tp].type != VM_PROGRAM) {
-                char msg[1000];
-                msg[0] = '\0';
-                sprintf(msg, "Cannot call value %s, expected function type!", value_to_str(&vm->stack[call->tp]));
-                runtimeerr(vm, msg);
+        case OP_TAILCALL:
+            if (op_tailcall(vm, call, i.ux.ux)) {
+                call->pc = -1;
             }
+            break;
 
-            code_object* code = vm->stack[call->tp].value.to_code;
-
-            call->tp -= code->p->argc;
+        case OP_CALL: op_call(vm, call, i.ux.ux); break;
+        case OP_RET: op_ret(vm, call); break;
+        case OP_POP: op_pop(vm, call); break;
+        case OP_DUP: op_push(vm, call, vm->stack[call->tp - 1]); break;
 
-            if (i.ux.ux == code->p->argc)
-                run_program(vm, call, code);
-            else {
-                runtimeerr(vm, "Invalid number of arguments passed to function!");
-            }
-            break;
-        
-        case OP_RET:
-            vm->stack[call->prev->tp++] = vm->stack[--call->tp];
-            break;
-        
-        case OP_POP:
-            call->tp--;
-            break;
-        
         case OP_JIF:
-            if (native_bool_cast(&vm->stack[--call->tp]).value.to_bool) {
+            if (op_jif(vm, call)) {
                 call->pc++;
             }
             break;
@@ -149,40 +122,50 @@ void decode_execute(virtual_machine* vm, call_info* call, instruction i)
             call->pc += i.sx.sx;
             break;
         
-        case OP_CLOSE:
-            Value* closure = malloc(sizeof(Value) * i.ux.ux);
-            call->tp -= i.ux.ux;
-            
-            for (size_t i0 = 0; i0 < i.ux.ux; i0++) {
-                closure[i0] = vm->stack[call->tp + i0];
+        case OP_CLOSE: op_close(vm, call, i.ux.ux); break;
+        case OP_TNEW: op_tnew(vm, call); break;
+        case OP_TPUT: op_tput(vm, call); break;
+        case OP_TGET: op_tget(vm, call); break;
+
+        case OP_ADDI: op_addi(vm, call); break;
+        case OP_SUBI: op_subi(vm, call); break;
+        case OP_MULI: op_muli(vm, call); break;
+        case OP_ADDF: op_addf(vm, call); break;
+        case OP_SUBF: op_subf(vm, call); break;
+        case OP_MULF: op_mulf(vm, call); break;
+        case OP_DIVI: op_divi(vm, call); break;
+        case OP_MODI: op_modi(vm, call); break;
+        case OP_DIVF: op_divf(vm, call); break;
+
+        case OP_EQI: op_eqi(vm, call); break;
+        case OP_NEI: op_nei(vm, call); break;
+        case OP_LTI: op_lti(vm, call); break;
+        case OP_LEI: op_lei(vm, call); break;
+        case OP_GTI: op_gti(vm, call); break;
+        case OP_GEI: op_gei(vm, call); break;
+        case OP_LTF: op_ltf(vm, call); break;
+        case OP_LEF: op_lef(vm, call); break;
+        case OP_GTF: op_gtf(vm, call); break;
+        case OP_GEF: op_gef(vm, call); break;
+
+        case OP_GUARDI:
+            if (op_guard(vm, call, i.sx.sx, VM_INT)) call->pc++;
+            break;
+
+        case OP_GUARDF:
+            if (op_guard(vm, call, i.sx.sx, VM_FLOAT)) call->pc++;
+            break;
+
+        case OP_FORPREP:
+            if (op_forprep(vm, call, i.ux.ux)) call->pc++;
+            break;
+
+        case OP_FORLOOP:
+            if (op_forloop(vm, call, i.ux.ux)) {
+                call->pc += call->program->p->code[call->pc + 1].sx.sx + 1;
+            } else {
+                call->pc++;
             }
-
-            vm->stack[call->tp - 1] = vCode(vm->stack[call->tp - 1].value.to_code->p, closure);
-            break;
-
-        case OP_TNEW:
-            vm->stack[call->tp++] = vTable(10);
-            break;
-        
-        case OP_TPUT:
-            v1 = vm->stack[--call->tp];
-            v0 = vm->stack[--call->tp];
-            call->tp--;
-            
-            if (vm->stack[call->tp].type == VM_TABLE)
-                vTablePut(vm->stack[call->tp++].value.to_table, v0, v1);
-            else
-                runtimeerr(vm, "Cannot add element to non-table object");
-            break;
-
-        case OP_TGET:
-            v0 = vm->stack[--call->tp];
-            call->tp--;
-            if (vm->stack[call->tp].type == VM_TABLE)
-                vm->stack[call->tp] = vTableGet(vm->stack[call->tp].value.to_table, v0);
-            else
-                runtimeerr(vm, "Cannot retrieve element from non-table object");
-            call->tp++;
             break;
         
         default:
@@ -216,6 +199,29 @@ Value apply_vm_op(vm_op op, Value v0, Value v1)
     }
 }
 
+lxpos* getaddresspos(program* p, int pos)
+{
+    for (size_t i = p->line_address_table.size; i-- > 0;)
+    {
+        size_t pos0 = atoi(p->line_address_table.keys[i]);
+
+        if (pos0 <= pos) {
+            return p->line_address_table.values[i];
+        }
+    }
+    return NULL;
+}
+
+void print_trace_position(Value* code, const lxpos* pos)
+{
+    if (pos->caller != NULL) {
+        print_trace_position(code, pos->caller);
+    }
+
+    fprintf(stderr, "\t%s In file %s at line %i:\n", value_to_str(code), pos->origin, pos->line_pos + 1);
+    fprintf(stderr, "\t\t| %04i %s\n", pos->line_pos + 1, get_line(pos->src, pos->line_offset));
+}
+
 void runtimeerr(virtual_machine* vm, const char* msg)
 {
     fprintf(stderr, "%sError Stack Trace: \n", ERR_COL);
@@ -230,12 +236,11 @@ void runtimeerr(virtual_machine* vm, const char* msg)
             continue;
         }
 
-        lxpos* pos = getaddresspos(call.program->p, call.pc);
         Value v = vCode(call.program->p, NULL);
-        fprintf(stderr, "\t%s In file %s at line %i:\n", value_to_str(&v), pos->origin, pos->line_pos + 1);
-        fprintf(stderr, "\t\t| %04i %s\n", pos->line_pos + 1, get_line(pos->src, pos->line_offset));
+        print_trace_position(&v, getaddresspos(call.program->p, call.pc));
     }
 
     fprintf(stderr, "Runtime error: %s%s\n", msg, DEF_COL);
+    tier_report();
     exit(0);
 }
\ No newline at end of file
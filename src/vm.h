@@ -23,6 +23,9 @@ typedef struct virtual_machine {
     Value* stack;
 } virtual_machine;
 
+// instructions dispatched by the stack and register VMs, native code is not counted
+extern size_t vm_dispatched;
+
 /**
  * @brief Runs program or code object by pushing new call info
  *      to call stack and simulating stack frame on vm stack.
@@ -53,6 +56,26 @@ void decode_execute(virtual_machine* vm, call_info* call, instruction i);
  */
 Value apply_vm_op(vm_op op, Value v0, Value v1);
 
+/**
+ * @brief Retrieves the position in source file using the index
+ *      of bytecode instruction in provided program.
+ * 
+ * @param p Reference to program
+ * @param pos Instruction position
+ * @return Source position
+ */
+lxpos* getaddresspos(program* p, int pos);
+
+/**
+ * @brief Prints a source position of a stack trace. Code which was
+ *      inlined is printed below the call sites it was inlined into,
+ *      as if each call still had its own frame.
+ *
+ * @param code Code object the position belongs to
+ * @param pos Source position
+ */
+void print_trace_position(Value* code, const lxpos* pos);
+
 /**
  * @brief Throws a runtime error when an issue occurs during
  *      bytecode execution. Stack trace is used to determine the
@@ -0,0 +1,307 @@
+/*
+ * Reads the object file of the stencils and writes src/stencils.h: the
+ * code of every stencil_* function, its holes and the read-only data
+ * the stencils refer to. Only x86-64 objects built with the large code
+ * model are understood, anything else produces an empty stencil table.
+ */
+
+#include <elf.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct object {
+    const uint8_t* data;
+    const Elf64_Ehdr* header;
+    const Elf64_Shdr* sections;
+    const Elf64_Sym* symbols;
+    size_t nsymbols;
+    const char* names;
+    const char* section_names;
+} object;
+
+static const char* object_path;
+
+// offsets of the data sections in the data of the stencils, (size_t) -1 if unused
+static size_t* data_offsets;
+static uint8_t* data;
+static size_t data_size;
+
+static const char** runtime_symbols;
+static size_t nruntime_symbols;
+
+static void fail(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%s: ", object_path);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    exit(1);
+}
+
+static uint8_t* read_object(const char* path, size_t* size)
+{
+    FILE* f = fopen(path, "rb");
+
+    if (f == NULL) {
+        fail("cannot open object");
+    }
+
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    uint8_t* buf = malloc(*size);
+
+    if (fread(buf, 1, *size, f) != *size) {
+        fail("cannot read object");
+    }
+
+    fclose(f);
+    return buf;
+}
+
+// places a read-only section in the data of the stencils the first time it is referenced
+static size_t data_section(object* o, size_t index)
+{
+    const Elf64_Shdr* s = &o->sections[index];
+
+    if (data_offsets[index] != (size_t) -1) {
+        return data_offsets[index];
+    }
+
+    if (!(s->sh_flags & SHF_ALLOC) || (s->sh_flags & (SHF_WRITE | SHF_EXECINSTR))) {
+        fail("stencils may only refer to read-only data, not %s", o->section_names + s->sh_name);
+    }
+
+    size_t align = s->sh_addralign > 1 ? s->sh_addralign : 1;
+    size_t offset = (data_size + align - 1) / align * align;
+
+    data = realloc(data, offset + s->sh_size);
+    memset(data + data_size, 0, offset - data_size);
+
+    if (s->sh_type == SHT_NOBITS) {
+        memset(data + offset, 0, s->sh_size);
+    } else {
+        memcpy(data + offset, o->data + s->sh_offset, s->sh_size);
+    }
+
+    data_size = offset + s->sh_size;
+    data_offsets[index] = offset;
+    return offset;
+}
+
+static size_t runtime_symbol(const char* name)
+{
+    for (size_t i = 0; i < nruntime_symbols; i++) {
+        if (strcmp(runtime_symbols[i], name) == 0) return i;
+    }
+
+    runtime_symbols = realloc(runtime_symbols, sizeof(char*) * (nruntime_symbols + 1));
+    runtime_symbols[nruntime_symbols] = name;
+    return nruntime_symbols++;
+}
+
+/*
+ * The continuation of a stencil must be reached by a jump, a call would
+ * grow the native stack. Its address is loaded by a movabs into a
+ * register, which is jumped through once the registers saved by the
+ * stencil are restored. Returns the offset of that jmp, 0 if the first
+ * use of the register is a call or cannot be found.
+ */
+static size_t continuation_jump(const uint8_t* code, size_t size, size_t hole)
+{
+    int reg = (code[hole - 1] - 0xb8) | (code[hole - 2] & 1) << 3;
+
+    for (size_t at = hole + 8; at + 1 < size; at++)
+    {
+        size_t prefix = code[at] == 0x41;
+
+        if (at + prefix + 1 >= size || code[at + prefix] != 0xff) {
+            continue;
+        }
+
+        uint8_t modrm = code[at + prefix + 1];
+        int op = (modrm >> 3) & 7;
+
+        // jmp or call through the register loaded with the hole
+        if (modrm >> 6 == 3 && (op == 2 || op == 4) && ((modrm & 7) | prefix << 3) == reg) {
+            return op == 4 ? at : 0;
+        }
+    }
+
+    return 0;
+}
+
+static void write_stencil(object* o, const Elf64_Sym* sym, const char* name)
+{
+    const Elf64_Shdr* text = &o->sections[sym->st_shndx];
+    const uint8_t* code = o->data + text->sh_offset + sym->st_value;
+    size_t size = sym->st_size;
+    size_t tail = 0;
+
+    printf("static const uint8_t stencil_code_%s[] = {", name);
+
+    for (size_t i = 0; i < size; i++) {
+        printf("%s0x%02x,", i % 16 == 0 ? "\n    " : " ", code[i]);
+    }
+
+    printf("\n};\n\nstatic const stencil_hole stencil_holes_%s[] = {\n", name);
+
+    size_t nholes = 0;
+
+    for (size_t k = 0; k < o->header->e_shnum; k++)
+    {
+        const Elf64_Shdr* rela = &o->sections[k];
+
+        if (rela->sh_type != SHT_RELA || &o->sections[rela->sh_info] != text) {
+            continue;
+        }
+
+        for (size_t r = 0; r < rela->sh_size / sizeof(Elf64_Rela); r++)
+        {
+            const Elf64_Rela* rel = (const Elf64_Rela*) (o->data + rela->sh_offset) + r;
+            const Elf64_Sym* target = &o->symbols[ELF64_R_SYM(rel->r_info)];
+            const char* target_name = o->names + target->st_name;
+            size_t offset = rel->r_offset - sym->st_value;
+            const char* kind = NULL;
+            size_t symbol = 0;
+            int64_t addend = rel->r_addend;
+
+            if (rel->r_offset < sym->st_value || offset >= size) {
+                continue;
+            }
+
+            if (ELF64_R_TYPE(rel->r_info) != R_X86_64_64) {
+                fail("%s has a relocation of type %u, stencils are built with -mcmodel=large",
+                    name, (unsigned) ELF64_R_TYPE(rel->r_info));
+            }
+
+            if (strcmp(target_name, "HE_CONTINUE") == 0) {
+                kind = "HOLE_CONTINUE";
+            } else if (strcmp(target_name, "HE_TARGET") == 0) {
+                kind = "HOLE_TARGET";
+            } else if (strcmp(target_name, "HE_OPERAND") == 0) {
+                kind = "HOLE_OPERAND";
+            } else if (strcmp(target_name, "HE_PC") == 0) {
+                kind = "HOLE_PC";
+            } else if (strcmp(target_name, "HE_CONSTANT") == 0) {
+                kind = "HOLE_CONSTANT";
+            } else if (target->st_shndx == SHN_UNDEF) {
+                kind = "HOLE_SYMBOL";
+                symbol = runtime_symbol(target_name);
+            } else if (target->st_shndx < o->header->e_shnum) {
+                kind = "HOLE_DATA";
+                addend += data_section(o, target->st_shndx) + target->st_value;
+            } else {
+                fail("%s refers to %s, which cannot be relocated", name, target_name);
+            }
+
+            if (strcmp(kind, "HOLE_CONTINUE") == 0 || strcmp(kind, "HOLE_TARGET") == 0)
+            {
+                size_t jump = continuation_jump(code, size, offset);
+
+                if (jump == 0) {
+                    fail("%s does not tail call %s, check that sibling calls are optimized", name, target_name);
+                }
+
+                // a jump to the continuation at the very end can fall through into the next stencil
+                if (strcmp(kind, "HOLE_CONTINUE") == 0 && jump + 2 == size && code[jump] == 0xff) {
+                    tail = 2;
+                }
+            }
+
+            printf("    { %zu, %s, %zu, %lld },\n", offset, kind, symbol, (long long) addend);
+            nholes++;
+        }
+    }
+
+    if (nholes == 0) {
+        printf("    { 0 },\n");
+    }
+
+    printf("};\n\n");
+    printf("#define STENCIL_%s_TAIL %zu\n#define STENCIL_%s_HOLES %zu\n\n", name, tail, name, nholes);
+}
+
+int main(int argc, const char* argv[])
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s handlers.o > stencils.h\n", argv[0]);
+        return 1;
+    }
+
+    object_path = argv[1];
+
+    size_t size;
+    object o = { .data = read_object(argv[1], &size) };
+    o.header = (const Elf64_Ehdr*) o.data;
+
+    printf("// Generated by \"make stencils\" from stencils/handlers.c, do not edit\n\n");
+    printf("#ifndef HE_STENCILS_HEADER\n#define HE_STENCILS_HEADER\n\n");
+
+    if (size < sizeof(Elf64_Ehdr) || memcmp(o.data, ELFMAG, SELFMAG) != 0 || o.header->e_machine != EM_X86_64) {
+        fprintf(stderr, "%s: not an x86-64 object, no stencils are generated\n", argv[1]);
+        printf("static const stencil stencils[STENCIL_COUNT];\n");
+        printf("static void* const stencil_symbols[1];\n");
+        printf("static const uint8_t stencil_data[1];\n\n#endif\n");
+        return 0;
+    }
+
+    o.sections = (const Elf64_Shdr*) (o.data + o.header->e_shoff);
+    o.section_names = (const char*) o.data + o.sections[o.header->e_shstrndx].sh_offset;
+    data_offsets = malloc(sizeof(size_t) * o.header->e_shnum);
+    memset(data_offsets, 0xff, sizeof(size_t) * o.header->e_shnum);
+
+    for (size_t k = 0; k < o.header->e_shnum; k++) {
+        if (o.sections[k].sh_type == SHT_SYMTAB) {
+            o.symbols = (const Elf64_Sym*) (o.data + o.sections[k].sh_offset);
+            o.nsymbols = o.sections[k].sh_size / sizeof(Elf64_Sym);
+            o.names = (const char*) o.data + o.sections[o.sections[k].sh_link].sh_offset;
+        }
+    }
+
+    if (o.symbols == NULL) {
+        fail("no symbol table");
+    }
+
+    const char** names = malloc(sizeof(char*) * o.nsymbols);
+    size_t nnames = 0;
+
+    for (size_t k = 0; k < o.nsymbols; k++)
+    {
+        const Elf64_Sym* sym = &o.symbols[k];
+        const char* name = o.names + sym->st_name;
+
+        if (ELF64_ST_TYPE(sym->st_info) == STT_FUNC && strncmp(name, "stencil_", 8) == 0) {
+            write_stencil(&o, sym, name + 8);
+            names[nnames++] = name + 8;
+        }
+    }
+
+    printf("static const stencil stencils[STENCIL_COUNT] = {\n");
+
+    for (size_t k = 0; k < nnames; k++) {
+        printf("    [%s] = { stencil_code_%s, sizeof(stencil_code_%s), STENCIL_%s_TAIL, stencil_holes_%s, STENCIL_%s_HOLES },\n",
+            names[k], names[k], names[k], names[k], names[k], names[k]);
+    }
+
+    printf("};\n\nstatic void* const stencil_symbols[%zu] = {\n", nruntime_symbols > 0 ? nruntime_symbols : 1);
+
+    for (size_t k = 0; k < nruntime_symbols; k++) {
+        printf("    (void*) &%s,\n", runtime_symbols[k]);
+    }
+
+    printf("};\n\nstatic const uint8_t stencil_data[%zu] __attribute__((aligned(64))) = {", data_size > 0 ? data_size : 1);
+
+    for (size_t i = 0; i < data_size; i++) {
+        printf("%s0x%02x,", i % 16 == 0 ? "\n    " : " ", data[i]);
+    }
+
+    printf("\n};\n\n#endif\n");
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Stencils of the copy-and-patch JIT, built by "make stencils" into
+ * src/stencils.h. Each stencil runs one instruction through its handler
+ * from ops.h and tail calls the stencil of the next instruction. The
+ * extern symbols below are holes: the stencils are compiled with the
+ * large code model, so every reference to a hole is a 64-bit absolute
+ * relocation, which is patched with the operand, the pc or the address
+ * of the code to continue at when stencils are stitched together.
+ */
+
+#include "ops.h"
+#include "jit.h"
+
+extern char HE_OPERAND[];
+extern char HE_PC[];
+extern char HE_CONSTANT[];
+extern int HE_CONTINUE(virtual_machine* vm, call_info* call);
+extern int HE_TARGET(virtual_machine* vm, call_info* call);
+
+#define OPERAND ((uint32_t) (uintptr_t) HE_OPERAND)
+#define SIGNED_OPERAND ((int32_t) (OPERAND << 8) >> 8)
+
+// stack traces and handlers read the pc of the running instruction
+#define SET_PC() (call->pc = (size_t) HE_PC)
+
+#define CONTINUE() return HE_CONTINUE(vm, call)
+#define BRANCH(taken) if (taken) return HE_TARGET(vm, call); CONTINUE()
+
+#define STENCIL(name) int stencil_##name(virtual_machine* vm, call_info* call)
+
+// ints are added and compared inline, anything else goes through the VM's operators
+#define STENCIL_ARITH(name, operator) \
+    STENCIL(name) \
+    { \
+        Value* top = &vm->stack[call->tp]; \
+        if (top[-2].type == VM_INT && top[-1].type == VM_INT) { \
+            top[-2].value.to_int = top[-2].value.to_int operator top[-1].value.to_int; \
+            call->tp--; \
+        } else { \
+            SET_PC(); \
+            op_binary(vm, call, name); \
+        } \
+        CONTINUE(); \
+    }
+
+#define STENCIL_COMPARE(name, operator) \
+    STENCIL(name) \
+    { \
+        Value* top = &vm->stack[call->tp]; \
+        if (top[-2].type == VM_INT && top[-1].type == VM_INT) { \
+            top[-2] = vBool(top[-2].value.to_int operator top[-1].value.to_int); \
+            call->tp--; \
+        } else { \
+            SET_PC(); \
+            op_binary(vm, call, name); \
+        } \
+        CONTINUE(); \
+    }
+
+#define STENCIL_BINARY(name) STENCIL(name) { SET_PC(); op_binary(vm, call, name); CONTINUE(); }
+#define STENCIL_PURE(name, handler) STENCIL(name) { handler(vm, call); CONTINUE(); }
+#define STENCIL_CHECKED(name, handler) STENCIL(name) { SET_PC(); handler(vm, call); CONTINUE(); }
+
+STENCIL_ARITH(OP_ADD, +)
+STENCIL_ARITH(OP_SUB, -)
+STENCIL_ARITH(OP_MUL, *)
+STENCIL_COMPARE(OP_EQ, ==)
+STENCIL_COMPARE(OP_NE, !=)
+STENCIL_COMPARE(OP_LT, <)
+STENCIL_COMPARE(OP_LE, <=)
+STENCIL_COMPARE(OP_GT, >)
+STENCIL_COMPARE(OP_GE, >=)
+STENCIL_BINARY(OP_DIV)
+STENCIL_BINARY(OP_MOD)
+STENCIL_BINARY(OP_AND)
+STENCIL_BINARY(OP_OR)
+
+STENCIL_CHECKED(OP_NEG, op_neg)
+STENCIL_CHECKED(OP_NOT, op_not)
+
+STENCIL_PURE(OP_ADDI, op_addi)
+STENCIL_PURE(OP_SUBI, op_subi)
+STENCIL_PURE(OP_MULI, op_muli)
+STENCIL_PURE(OP_ADDF, op_addf)
+STENCIL_PURE(OP_SUBF, op_subf)
+STENCIL_PURE(OP_MULF, op_mulf)
+STENCIL_CHECKED(OP_DIVI, op_divi)
+STENCIL_CHECKED(OP_MODI, op_modi)
+STENCIL_CHECKED(OP_DIVF, op_divf)
+STENCIL_PURE(OP_EQI, op_eqi)
+STENCIL_PURE(OP_NEI, op_nei)
+STENCIL_PURE(OP_LTI, op_lti)
+STENCIL_PURE(OP_LEI, op_lei)
+STENCIL_PURE(OP_GTI, op_gti)
+STENCIL_PURE(OP_GEI, op_gei)
+STENCIL_PURE(OP_LTF, op_ltf)
+STENCIL_PURE(OP_LEF, op_lef)
+STENCIL_PURE(OP_GTF, op_gtf)
+STENCIL_PURE(OP_GEF, op_gef)
+
+STENCIL_PURE(OP_POP, op_pop)
+STENCIL_CHECKED(OP_TNEW, op_tnew)
+STENCIL_CHECKED(OP_TPUT, op_tput)
+STENCIL_CHECKED(OP_TGET, op_tget)
+
+STENCIL(OP_NOP) { CONTINUE(); }
+
+// the constant hole holds the address of the constant in the pool of the program
+STENCIL(OP_PUSHK) { SET_PC(); op_push(vm, call, *(Value*) HE_CONSTANT); CONTINUE(); }
+STENCIL(OP_LOADG) { SET_PC(); op_push(vm, call, vm->heap[SIGNED_OPERAND]); CONTINUE(); }
+STENCIL(OP_LOADL) { SET_PC(); op_push(vm, call, vm->stack[call->bp + SIGNED_OPERAND]); CONTINUE(); }
+STENCIL(OP_LOADC) { SET_PC(); op_push(vm, call, call->program->closure[OPERAND]); CONTINUE(); }
+STENCIL(OP_DUP) { SET_PC(); op_push(vm, call, vm->stack[call->tp - 1]); CONTINUE(); }
+STENCIL(OP_STORG) { SET_PC(); op_storg(vm, call, SIGNED_OPERAND); CONTINUE(); }
+STENCIL(OP_STORL) { SET_PC(); op_storl(vm, call, SIGNED_OPERAND); CONTINUE(); }
+STENCIL(OP_STORC) { op_storc(vm, call, OPERAND); CONTINUE(); }
+
+STENCIL(OP_CALL) { SET_PC(); op_call(vm, call, OPERAND); CONTINUE(); }
+STENCIL(OP_CLOSE) { SET_PC(); op_close(vm, call, OPERAND); CONTINUE(); }
+STENCIL(OP_RET) { op_ret(vm, call); return JIT_RETURN; }
+
+// the frame restarts with the callee, which jit_execute enters
+STENCIL(OP_TAILCALL)
+{
+    SET_PC();
+
+    if (op_tailcall(vm, call, OPERAND)) {
+        return JIT_TAILCALL;
+    }
+    CONTINUE();
+}
+
+// jumps continue at their target, branches take the target hole
+STENCIL(OP_JMP) { CONTINUE(); }
+STENCIL(OP_JIF) { SET_PC(); BRANCH(op_jif(vm, call)); }
+STENCIL(OP_GUARDI) { BRANCH(op_guard(vm, call, SIGNED_OPERAND, VM_INT)); }
+STENCIL(OP_GUARDF) { BRANCH(op_guard(vm, call, SIGNED_OPERAND, VM_FLOAT)); }
+STENCIL(OP_FORPREP) { SET_PC(); BRANCH(op_forprep(vm, call, OPERAND)); }
+STENCIL(OP_FORLOOP) { SET_PC(); BRANCH(op_forloop(vm, call, OPERAND)); }
+
+// frames entered mid-loop by on-stack replacement resume at the loop header
+STENCIL(STENCIL_ENTER) { BRANCH(call->pc == (size_t) HE_PC); }
+
+// instructions without a stencil of their own, the operand hole holds the whole instruction
+STENCIL(STENCIL_STEP)
+{
+    SET_PC();
+    decode_execute(vm, call, (instruction) { .bits = (uint32_t) (uintptr_t) HE_OPERAND });
+    CONTINUE();
+}
+
+// running past the last instruction ends the frame like a return
+STENCIL(STENCIL_END) { return JIT_RETURN; }
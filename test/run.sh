@@ -0,0 +1,111 @@
+#!/bin/sh
+# Runs every test/*.he script under each optimization level and execution
+# tier and compares its output with test/<name>.out, which is the output of
+# the script at -O0 on the stack VM. Scripts are also run from their cached
+# bytecode, from corrupted copies of it and, when a C compiler is available, as
+# ahead of time compiled executables. With UPDATE=1 the expected output of
+# each script is written from its -O0 run instead.
+#
+# usage: test/run.sh [interpreter] [script...]
+
+HELIUM=${1:-out/helium}
+[ $# -gt 0 ] && shift
+SCRIPTS=${*:-test/*.he}
+CC=${CC:-gcc}
+TMP=$(mktemp -d)
+RUNTIME="common datatypes value lib vm jit stencil regvm tier"
+
+trap 'rm -rf "$TMP"' EXIT
+
+passed=0
+failed=0
+
+# output of a command with addresses removed and its exit status appended
+run() {
+    { "$@" < /dev/null 2>&1; echo "exit $?"; } | sed -e 's/0x[0-9a-f]*//g' -e "s|$PWD/||g"
+}
+
+check() {
+    name=$1
+    label=$2
+    shift 2
+
+    run "$@" > "$TMP/actual"
+
+    if cmp -s "test/$name.out" "$TMP/actual"; then
+        passed=$((passed + 1))
+    else
+        failed=$((failed + 1))
+        echo "FAIL $name ($label)"
+        diff "test/$name.out" "$TMP/actual" | head -10
+    fi
+}
+
+# runtime objects are shared by every ahead of time compiled script
+aot=false
+
+if command -v "$CC" > /dev/null; then
+    aot=true
+
+    for f in $RUNTIME; do
+        "$CC" -O2 -w -Isrc -c "src/$f.c" -o "$TMP/$f.o" || aot=false
+    done
+fi
+
+for script in $SCRIPTS; do
+    name=$(basename "$script" .he)
+    cache="${script}c"
+
+    if [ "$UPDATE" = 1 ]; then
+        run "$HELIUM" --no-cache --no-jit -O0 "$script" > "test/$name.out"
+    fi
+
+    if [ ! -f "test/$name.out" ]; then
+        echo "MISSING test/$name.out"
+        failed=$((failed + 1))
+        continue
+    fi
+
+    check "$name" "-O0" "$HELIUM" --no-cache --no-jit -O0 "$script"
+    check "$name" "-O1" "$HELIUM" --no-cache --no-jit -O1 "$script"
+    check "$name" "-O2" "$HELIUM" --no-cache --no-jit "$script"
+    check "$name" "register VM" "$HELIUM" --no-cache --no-jit --register-vm "$script"
+    check "$name" "JIT" "$HELIUM" --no-cache "$script"
+    check "$name" "JIT tiers" "$HELIUM" --no-cache --jit-call-threshold=1 --jit-trace-threshold=1 --jit-osr-threshold=1 "$script"
+    check "$name" "-O0 JIT tiers" "$HELIUM" --no-cache -O0 --jit-call-threshold=1 --jit-trace-threshold=1 --jit-osr-threshold=1 "$script"
+    check "$name" "stencil JIT" "$HELIUM" --no-cache --jit-stencils --jit-call-threshold=1 "$script"
+
+    # the first run writes the cache, the second links it
+    rm -f "$cache"
+    check "$name" "cache store" "$HELIUM" "$script"
+    check "$name" "cache load" "$HELIUM" "$script"
+
+    # corrupt and truncated caches are compiled from source again
+    cp "$cache" "$TMP/cache"
+    size=$(wc -c < "$TMP/cache")
+    code=$(od -An -tu4 -j72 -N4 "$TMP/cache") # offset of the code section in the header
+
+    for offset in 9 $((code + 4)) $((size / 3)) $((size / 2)) $((size - 2)); do
+        cp "$TMP/cache" "$cache"
+        printf '\377' | dd of="$cache" bs=1 seek="$offset" conv=notrunc 2> /dev/null
+        check "$name" "corrupt cache at $offset" "$HELIUM" "$script"
+    done
+
+    head -c $((size / 2)) "$TMP/cache" > "$cache"
+    check "$name" "truncated cache" "$HELIUM" "$script"
+
+    rm -f "$cache"
+
+    if $aot; then
+        if "$HELIUM" --no-cache --emit-c "$script" > "$TMP/$name.c" &&
+            "$CC" -O2 -w -Isrc "$TMP/$name.c" $(for f in $RUNTIME; do echo "$TMP/$f.o"; done) -lm -o "$TMP/$name"; then
+            check "$name" "AOT" "$TMP/$name"
+        else
+            failed=$((failed + 1))
+            echo "FAIL $name (AOT build)"
+        fi
+    fi
+done
+
+echo "$passed passed, $failed failed"
+[ "$failed" -eq 0 ]